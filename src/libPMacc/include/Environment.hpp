@@ -34,6 +34,7 @@
 #include "pluginSystem/PluginConnector.hpp"
 #include "nvidia/memory/MemoryInfo.hpp"
 #include "simulationControl/SimulationDescription.hpp"
+#include "simulationControl/Profiler.hpp"
 #include "mappings/simulation/Filesystem.hpp"
 
 #include "Environment.def"
@@ -111,6 +112,11 @@ public:
         return simulationControl::SimulationDescription::getInstance();
     }
 
+    simulationControl::Profiler& Profiler()
+    {
+        return simulationControl::Profiler::getInstance();
+    }
+
     PMacc::Filesystem<DIM>& Filesystem()
     {
         return PMacc::Filesystem<DIM>::getInstance();
@@ -79,7 +79,7 @@ public:
 
     /*! ctor
      */
-    CommunicatorMPI() : hostRank(0)
+    CommunicatorMPI() : hostRank(0), slideOffset(0), slideDirection(DIM >= DIM2 ? 1 : 0), topologyVersion(0)
     {
         //MPI_Init(NULL, NULL);
     }
@@ -138,7 +138,7 @@ public:
         //1. create Communicator (computing_comm) of computing nodes (ranks 0...n)
         MPI_Comm computing_comm = MPI_COMM_WORLD;
 
-        yoffset = 0;
+        slideOffset = 0;
 
         // 2. create topology
 
@@ -226,32 +226,76 @@ public:
 
     // description in ICommunicator
 
-    bool slide()
+    void initSend(uint32_t ex, const char *send_data, int count, MPI_Datatype datatype, uint32_t tag, MPI_Request *request)
+    {
+        MPI_CHECK(MPI_Send_init(
+                                (void*) send_data,
+                                count,
+                                datatype,
+                                ExchangeTypeToRank(ex),
+                                gridExchangeTag + tag,
+                                topology,
+                                request));
+    }
+
+    // description in ICommunicator
+
+    void initReceive(uint32_t ex, char *recv_data, int count, MPI_Datatype datatype, uint32_t tag, MPI_Request *request)
     {
-        // we can only slide in y direction right now
-        if(DIM < DIM2)
-            return false;
+        MPI_CHECK(MPI_Recv_init(
+                                recv_data,
+                                count,
+                                datatype,
+                                ExchangeTypeToRank(ex),
+                                gridExchangeTag + tag,
+                                topology,
+                                request));
+    }
 
+    // description in ICommunicator
+
+    uint32_t getTopologyVersion() const
+    {
+        return topologyVersion;
+    }
+
+    // description in ICommunicator
+
+    void setSlideDirection(uint32_t direction)
+    {
+        assert(direction < DIM);
+        /* the rotation of the coordinates must be applied in one direction only */
+        assert(slideOffset == 0);
+        slideDirection = direction;
+    }
+
+    /*! returns the direction in which slide() moves the GPUs
+     */
+    uint32_t getSlideDirection() const
+    {
+        return slideDirection;
+    }
+
+    // description in ICommunicator
+
+    bool slide()
+    {
         // MPI_Barrier(topology);
-        yoffset--;
-        if (yoffset == -dims[1])
-            yoffset = 0;
+        slideOffset--;
+        if (slideOffset == -dims[slideDirection])
+            slideOffset = 0;
 
         updateCoordinates();
 
-        return coordinates[1] == dims[1] - 1;
+        return coordinates[slideDirection] == dims[slideDirection] - 1;
     }
 
     bool setStateAfterSlides(size_t numSlides)
     {
-        // we can only slide in y direction right now
-        if(DIM < DIM2)
-            return false;
-
         bool result = false;
 
-        // only need to apply (numSlides % num-gpus-y) slides
-        for (size_t i = 0; i < (numSlides % dims[1]); ++i)
+        // only need to apply (numSlides % num-gpus-in-slide-direction) slides
+        for (size_t i = 0; i < (numSlides % dims[slideDirection]); ++i)
             result = slide();
 
         return result;
@@ -340,20 +384,20 @@ protected:
         MPI_CHECK(MPI_Comm_rank(topology, &rank));
         MPI_CHECK(MPI_Cart_coords(topology, rank, DIM, coords));
 
-        if (DIM >= DIM2)
-        {
-            if (dims[1] > 1)
-                coords[1] = (coords[1] + yoffset) % dims[1];
+        if (dims[slideDirection] > 1)
+            coords[slideDirection] = (coords[slideDirection] + slideOffset) % dims[slideDirection];
 
-            while (coords[1] < 0)
-                coords[1] += dims[1];
-        }
+        while (coords[slideDirection] < 0)
+            coords[slideDirection] += dims[slideDirection];
 
         detail::LogRankCoords<DIM>()(rank, coords);
 
         for (uint32_t i = 0; i < DIM; ++i)
             this->coordinates[i] = coords[i];
 
+        /* neighbor ranks are recalculated, persistent requests are invalid */
+        ++topologyVersion;
+
         // init ranks of other hosts
         int mcoords[3];
 
@@ -393,8 +437,8 @@ protected:
 
             if (ok)
             {
-                if (dims[1] > 1)
-                    mcoords[1] = (mcoords[1] - yoffset) % dims[1];
+                if (dims[slideDirection] > 1)
+                    mcoords[slideDirection] = (mcoords[slideDirection] - slideOffset) % dims[slideDirection];
 
                 MPI_CHECK(MPI_Cart_rank(topology, mcoords, &ranks[i]));
                 communicationMask = communicationMask + Mask(i);
@@ -432,7 +476,11 @@ private:
     //! rank of this process local to its host (node)
     int hostRank;
     //! offset for sliding window
-    int yoffset;
+    int slideOffset;
+    //! direction of the sliding window \see setSlideDirection
+    uint32_t slideDirection;
+    //! \see getTopologyVersion
+    uint32_t topologyVersion;
 
     int mpiRank;
     int mpiSize;
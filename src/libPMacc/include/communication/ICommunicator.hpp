@@ -42,7 +42,14 @@ public:
      */
     virtual const Mask& getCommunicationMask() const=0;
 
-    /*! moves all GPUs from top to bottom (y-coordinate)
+    /*! sets the direction in which slide() moves the GPUs
+     *
+     * @param direction 0 == x, 1 == y, 2 == z
+     */
+    virtual void setSlideDirection(uint32_t direction) = 0;
+
+    /*! moves all GPUs one position backwards in slide direction, the
+     *  first GPU in slide direction becomes the last one
      *
      * @return true if the position of gpu is switched to the end, else false
      */
@@ -79,6 +86,37 @@ public:
      */
     virtual MPI_Request* startReceive(uint32_t ex, char *recv_data, size_t recv_data_max, uint32_t tag) = 0;
 
+    /*! creates a persistent send request (MPI_Send_init)
+     *
+     * The request is bound to the current neighbor ranks, it must be freed and
+     * created again if getTopologyVersion() changes.
+     *
+     * \param[in] ex                direction to send (enum ExchangeType)
+     * \param[in] send_data         pointer to data described by datatype
+     * \param[in] count             number of elements of datatype to send
+     * \param[in] datatype          committed MPI datatype (may be non-contiguous)
+     * \param[in] tag               user-defined tag; only message with the same tag can be exchanged (i.e. initSend and initReceive must use the same tag)
+     * \param[out] request          inactive persistent request, start it with MPI_Start
+     */
+    virtual void initSend(uint32_t ex, const char *send_data, int count, MPI_Datatype datatype, uint32_t tag, MPI_Request *request) = 0;
+
+    /*! creates a persistent receive request (MPI_Recv_init)
+     *
+     * \see initSend
+     *
+     * \param[in] ex                direction to receive from (enum ExchangeType)
+     * \param[in] recv_data         pointer to data described by datatype
+     * \param[in] count             maximum number of elements of datatype to receive
+     * \param[in] datatype          committed MPI datatype (may be non-contiguous)
+     * \param[in] tag               user-defined tag; only message with the same tag can be exchanged (i.e. initSend and initReceive must use the same tag)
+     * \param[out] request          inactive persistent request, start it with MPI_Start
+     */
+    virtual void initReceive(uint32_t ex, char *recv_data, int count, MPI_Datatype datatype, uint32_t tag, MPI_Request *request) = 0;
+
+    /*! returns a counter which is increased each time the neighbor ranks change (e.g. by slide())
+     */
+    virtual uint32_t getTopologyVersion() const = 0;
+
     virtual int getRank()=0;
 
     /*! Return which of the three directions are periodic
@@ -24,10 +24,12 @@
 #pragma once
 
 #include "eventSystem/tasks/ITask.hpp"
+#include "eventSystem/tasks/TaskTable.hpp"
 #include "Environment.def"
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace PMacc
 {
@@ -37,6 +39,9 @@ namespace PMacc
 
     /**
      * Manages the event system by executing and waiting for tasks.
+     *
+     * Active tasks are stored densely in a list which is polled round robin,
+     * the list position and passive tasks are found via TaskTable in O(1).
      */
     class Manager : public IEvent
     {
@@ -87,6 +92,18 @@ namespace PMacc
 
         inline ITask* getActiveITaskIfNotFinished(id_t taskId) const;
 
+        /** removes an active task from the poll list and the table */
+        inline void removeActiveTask(id_t taskId);
+
+        /** swaps two positions in the poll list and updates the table */
+        inline void swapActiveTasks(uint32_t pos1, uint32_t pos2);
+
+        /** executes tasks until the task with taskId is finished */
+        inline void executeUntilFinished(id_t taskId);
+
+        /** executes tasks until all tasks are finished */
+        inline void executeAllTasks();
+
         Manager();
 
         Manager(const Manager& cc);
@@ -99,8 +116,13 @@ namespace PMacc
             return instance;
         }
 
-        TaskMap tasks;
-        TaskMap passiveTasks;
+        /** active tasks, payload is the position in activeTaskList */
+        TaskTable tasks;
+        TaskTable passiveTasks;
+        /** dense list of all active tasks in polling order */
+        std::vector<ITask*> activeTaskList;
+        /** next position in activeTaskList to poll, shared by nested calls of execute() */
+        uint32_t pollPosition;
         EventPool *eventPool;
     };
 
@@ -31,6 +31,7 @@
 #include <cstdio>
 #include <set>
 #include <iostream>
+#include <algorithm>
 
 //#define DEBUG_EVENTS
 
@@ -40,7 +41,8 @@ namespace PMacc
 inline Manager::~Manager( )
 {
     CUDA_CHECK( cudaGetLastError( ) );
-    waitForAllTasks( );
+    /* the profiler can already be destroyed */
+    executeAllTasks( );
     CUDA_CHECK( cudaGetLastError( ) );
     delete eventPool;
     CUDA_CHECK( cudaGetLastError( ) );
@@ -61,18 +63,18 @@ inline bool Manager::execute( id_t taskToWait )
     }
 #endif
 
-    static TaskMap::iterator iter = tasks.begin( );
+    if ( pollPosition >= activeTaskList.size( ) )
+        pollPosition = 0;
 
-    if ( iter == tasks.end( ) )
-        iter = tasks.begin( );
-
-    // this is the slow but very save variant to delete tasks in a map
-    while ( iter != tasks.end( ) )
+    /* tasks before pollPosition are polled in this round, nested calls
+     * of execute() continue the same round
+     */
+    while ( pollPosition < activeTaskList.size( ) )
     {
-        id_t id = iter->first;
-        ITask* taskPtr = iter->second;
+        ITask* taskPtr = activeTaskList[pollPosition];
         assert( taskPtr != NULL );
-        ++iter;
+        id_t id = taskPtr->getId( );
+        ++pollPosition;
 #ifdef DEBUG_EVENTS
         if ( counter == 5000000 )
         {
@@ -85,7 +87,7 @@ inline bool Manager::execute( id_t taskToWait )
             /*test if task is deleted by other stackdeep*/
             if ( getActiveITaskIfNotFinished( id ) == taskPtr )
             {
-                tasks.erase( id );
+                removeActiveTask( id );
                 __delete(taskPtr);
             }
 #ifdef DEBUG_EVENTS
@@ -94,7 +96,7 @@ inline bool Manager::execute( id_t taskToWait )
 
             if ( taskToWait == id )
             {
-                iter = tasks.end( );
+                pollPosition = activeTaskList.size( );
 #ifdef DEBUG_EVENTS
                 --deep;
 #endif
@@ -128,24 +130,62 @@ inline ITask* Manager::getITaskIfNotFinished( id_t taskId ) const
 
 inline ITask* Manager::getPassiveITaskIfNotFinished( id_t taskId ) const
 {
-    TaskMap::const_iterator itPassive = passiveTasks.find( taskId );
-    if ( itPassive != passiveTasks.end( ) )
-        return itPassive->second;
+    const TaskTable::Entry* entry = passiveTasks.find( taskId );
+    if ( entry != NULL )
+        return entry->task;
     return NULL;
 }
 
 inline ITask* Manager::getActiveITaskIfNotFinished( id_t taskId ) const
 {
-    TaskMap::const_iterator it = tasks.find( taskId );
-    if ( it != tasks.end( ) )
-        return it->second;
+    const TaskTable::Entry* entry = tasks.find( taskId );
+    if ( entry != NULL )
+        return entry->task;
     return NULL;
 }
 
+inline void Manager::swapActiveTasks( uint32_t pos1, uint32_t pos2 )
+{
+    if ( pos1 == pos2 )
+        return;
+    std::swap( activeTaskList[pos1], activeTaskList[pos2] );
+    tasks.find( activeTaskList[pos1]->getId( ) )->index = pos1;
+    tasks.find( activeTaskList[pos2]->getId( ) )->index = pos2;
+}
+
+inline void Manager::removeActiveTask( id_t taskId )
+{
+    TaskTable::Entry* entry = tasks.find( taskId );
+    assert( entry != NULL );
+    uint32_t pos = entry->index;
+
+    /* keep the order [already polled | not polled] intact:
+     * move the task to the end of the polled part first
+     */
+    if ( pos < pollPosition )
+    {
+        --pollPosition;
+        swapActiveTasks( pos, pollPosition );
+        pos = pollPosition;
+    }
+    swapActiveTasks( pos, static_cast<uint32_t>( activeTaskList.size( ) - 1 ) );
+    activeTaskList.pop_back( );
+    tasks.erase( taskId );
+}
+
 inline void Manager::waitForFinished( id_t taskId )
 {
     if( taskId == 0 )
         return;
+
+    simulationControl::Profiler& profiler = Environment<>::get().Profiler();
+    profiler.startWait( );
+    executeUntilFinished( taskId );
+    profiler.endWait( );
+}
+
+inline void Manager::executeUntilFinished( id_t taskId )
+{
     //check if task is passive and wait on it
     ITask* task = getPassiveITaskIfNotFinished( taskId );
     if ( task != NULL )
@@ -173,6 +213,14 @@ inline void Manager::waitForFinished( id_t taskId )
 }
 
 inline void Manager::waitForAllTasks( )
+{
+    simulationControl::Profiler& profiler = Environment<>::get().Profiler();
+    profiler.startWait( );
+    executeAllTasks( );
+    profiler.endWait( );
+}
+
+inline void Manager::executeAllTasks( )
 {
     while ( tasks.size( ) != 0 || passiveTasks.size( ) != 0 )
     {
@@ -184,7 +232,15 @@ inline void Manager::waitForAllTasks( )
 inline void Manager::addTask( ITask *task )
 {
     assert( task != NULL );
-    tasks[task->getId( )] = task;
+    TaskTable::Entry* entry = tasks.find( task->getId( ) );
+    if ( entry != NULL )
+    {
+        activeTaskList[entry->index] = task;
+        entry->task = task;
+        return;
+    }
+    tasks.insert( task->getId( ), task, static_cast<uint32_t>( activeTaskList.size( ) ) );
+    activeTaskList.push_back( task );
 }
 
 inline void Manager::addPassiveTask( ITask *task )
@@ -192,10 +248,10 @@ inline void Manager::addPassiveTask( ITask *task )
     assert( task != NULL );
 
     task->addObserver( this );
-    passiveTasks[task->getId( )] = task;
+    passiveTasks.insert( task->getId( ), task );
 }
 
-inline Manager::Manager( )
+inline Manager::Manager( ) : pollPosition( 0 )
 {
     /**
      * The \see Environment ensures that the \see StreamController is
@@ -216,12 +272,9 @@ inline EventPool& Manager::getEventPool( )
 
 inline std::size_t Manager::getCount( )
 {
-    for ( TaskMap::iterator iter = tasks.begin( ); iter != tasks.end( ); ++iter )
+    for ( size_t i = 0; i < activeTaskList.size( ); ++i )
     {
-        if ( iter->second != NULL )
-        {
-            std::cout << iter->first << " = " << iter->second->toString( ) << std::endl;
-        }
+        std::cout << activeTaskList[i]->getId( ) << " = " << activeTaskList[i]->toString( ) << std::endl;
     }
     return tasks.size( );
 }
@@ -25,6 +25,7 @@
 
 #include "eventSystem/events/EventNotify.hpp"
 #include "eventSystem/events/IEvent.hpp"
+#include "eventSystem/tasks/TaskPool.hpp"
 #include "pmacc_types.hpp"
 
 #include <string>
@@ -62,6 +63,17 @@ namespace PMacc
         {
         }
 
+        /** memory of all tasks is recycled by the TaskPool */
+        static void* operator new(size_t size)
+        {
+            return TaskPool::allocate(size);
+        }
+
+        static void operator delete(void* ptr, size_t size)
+        {
+            TaskPool::deallocate(ptr, size);
+        }
+
         /**
          * Executes this task.
          *
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace PMacc
+{
+
+    /**
+     * Recycles the memory of finished tasks.
+     *
+     * Tasks are created and deleted at a high rate (several per kernel call
+     * and per communication). Memory of deleted tasks is kept in free lists
+     * (one list per size class) and handed out for the next task of the same
+     * size class instead of calling the system allocator.
+     *
+     * The event system is single threaded, therefore the pool is not
+     * synchronized. The pool is a plain static object without destructor
+     * because tasks can be deleted during static destruction.
+     */
+    class TaskPool
+    {
+    public:
+
+        /** size classes have a width of this many bytes */
+        static const size_t granularity = 32;
+        /** tasks larger than this are not pooled */
+        static const size_t maxPooledSize = 1024;
+
+        static void* allocate(size_t size)
+        {
+            if (size > maxPooledSize)
+                return ::operator new(size);
+
+            FreeBlock*& freeList = getFreeList(size);
+            if (freeList == NULL)
+                return ::operator new(getClassSize(size));
+
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            return block;
+        }
+
+        static void deallocate(void* ptr, size_t size)
+        {
+            if (ptr == NULL)
+                return;
+            if (size > maxPooledSize)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            FreeBlock*& freeList = getFreeList(size);
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->next = freeList;
+            freeList = block;
+        }
+
+    private:
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        static size_t getClassSize(size_t size)
+        {
+            return (size + granularity - 1) / granularity * granularity;
+        }
+
+        static FreeBlock*& getFreeList(size_t size)
+        {
+            /* zero initialized, no destructor */
+            static FreeBlock* freeLists[maxPooledSize / granularity + 1];
+            return freeLists[(size + granularity - 1) / granularity];
+        }
+    };
+
+} //namespace PMacc
@@ -48,6 +48,14 @@ namespace PMacc
 
         virtual void init()
         {
+            if (exchange->isDirectExchange())
+            {
+                /* MPI writes the device buffer in place,
+                 * wait until all previous work on the buffer is finished */
+                initDependency = __getTransactionEvent();
+                state = WaitForDependency;
+                return;
+            }
             state = WaitForReceived;
             Environment<>::get().Factory().createTaskReceiveMPI(exchange, this);
         }
@@ -56,6 +64,14 @@ namespace PMacc
         {
             switch (state)
             {
+                case WaitForDependency:
+                    if (NULL != Environment<>::get().Manager().getITaskIfNotFinished(initDependency.getTaskId()))
+                        break;
+                    state = WaitForReceived;
+                    __startTransaction();
+                    Environment<>::get().Factory().createTaskReceiveMPI(exchange, this);
+                    __endTransaction();
+                    break;
                 case WaitForReceived:
                     break;
                 case RunCopy:
@@ -106,6 +122,12 @@ namespace PMacc
                         EventDataReceive *rdata = static_cast<EventDataReceive*> (data);
                         // std::cout<<" data rec "<<rdata->getReceivedCount()/sizeof(TYPE)<<std::endl;
                         newBufferSize = rdata->getReceivedCount() / sizeof (TYPE);
+                        if (exchange->isDirectExchange())
+                        {
+                            /* data was received in place, nothing to copy */
+                            state = Finish;
+                            break;
+                        }
                         state = RunCopy;
                         executeIntern();
                     }
@@ -131,6 +153,7 @@ namespace PMacc
         enum state_t
         {
             Constructor,
+            WaitForDependency,
             WaitForReceived,
             RunCopy,
             WaitForFinish,
@@ -142,6 +165,7 @@ namespace PMacc
         Exchange<TYPE, DIM> *exchange;
         state_t state;
         size_t newBufferSize;
+        EventTask initDependency;
     };
 
 } //namespace PMacc
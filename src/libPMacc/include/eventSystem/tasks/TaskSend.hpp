@@ -49,6 +49,14 @@ namespace PMacc
 
         virtual void init()
         {
+            if (exchange->isDirectExchange())
+            {
+                /* MPI reads the device buffer in place,
+                 * wait until all previous work on the buffer is finished */
+                initDependency = __getTransactionEvent();
+                state = WaitForDependency;
+                return;
+            }
             state = InitDone;
             if (exchange->hasDeviceDoubleBuffer())
             {
@@ -72,14 +80,17 @@ namespace PMacc
         {
             switch (state)
             {
-                case InitDone:
-                    break;
+                case WaitForDependency:
+                    if (NULL != Environment<>::get().Manager().getITaskIfNotFinished(initDependency.getTaskId()))
+                        break;
+                    /* no break, data is ready to send */
                 case DeviceToHostFinished:
                     state = SendDone;
                     __startTransaction();
                     Environment<>::get().Factory().createTaskSendMPI(exchange, this);
                     __endTransaction();
                     break;
+                case InitDone:
                 case SendDone:
                     break;
                 case Finish:
@@ -124,6 +135,7 @@ namespace PMacc
         enum state_t
         {
             Constructor,
+            WaitForDependency,
             InitDone,
             DeviceToHostFinished,
             SendDone,
@@ -132,6 +144,7 @@ namespace PMacc
 
         Exchange<TYPE, DIM> *exchange;
         state_t state;
+        EventTask initDependency;
     };
 
 } //namespace PMacc
@@ -40,13 +40,24 @@ public:
 
     TaskSendMPI(Exchange<TYPE, DIM> *exchange) :
     MPITask(),
-    exchange(exchange)
+    exchange(exchange),
+    request(NULL),
+    isPersistent(false)
     {
 
     }
 
     virtual void init()
     {
+        /* fixed size messages reuse a persistent request of the exchange */
+        MPI_Request* persistentRequest = exchange->getPersistentSendRequest();
+        if (persistentRequest != NULL)
+        {
+            MPI_CHECK(MPI_Start(persistentRequest));
+            this->request = persistentRequest;
+            this->isPersistent = true;
+            return;
+        }
         this->request = Environment<DIM>::get().EnvironmentController()
                 .getCommunicator().startSend(
                                              exchange->getExchangeType(),
@@ -68,7 +79,9 @@ public:
 
         if (flag) //finished
         {
-            delete this->request;
+            /* persistent requests are owned by the exchange */
+            if (!isPersistent)
+                delete this->request;
             this->request = NULL;
             this->setFinished();
             return true;
@@ -95,6 +108,7 @@ private:
     Exchange<TYPE, DIM> *exchange;
     MPI_Request *request;
     MPI_Status status;
+    bool isPersistent;
 };
 
 } //namespace PMacc
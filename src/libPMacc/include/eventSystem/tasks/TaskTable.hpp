@@ -0,0 +1,170 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+
+#include <vector>
+#include <cassert>
+
+namespace PMacc
+{
+    class ITask;
+
+    /**
+     * Hash table from task id to task with O(1) lookup, insert and erase.
+     *
+     * Task ids are increasing numbers, therefore the id masked with the
+     * capacity is used as slot (tasks which are alive at the same time occupy
+     * neighboring slots). Collisions are resolved with linear probing,
+     * erase uses backward shifting (no tombstones).
+     */
+    class TaskTable
+    {
+    public:
+
+        struct Entry
+        {
+            /** 0 marks an empty slot (task id 0 is reserved for invalid) */
+            id_t id;
+            ITask* task;
+            /** user defined payload */
+            uint32_t index;
+        };
+
+        TaskTable() : numEntries(0)
+        {
+            Entry empty = {0, NULL, 0};
+            entries.resize(minCapacity, empty);
+        }
+
+        /**
+         * @return pointer to the entry of the task, NULL if id is not in the table
+         */
+        Entry* find(id_t id)
+        {
+            if (id == 0)
+                return NULL;
+            const size_t mask = entries.size() - 1;
+            for (size_t slot = id & mask;; slot = (slot + 1) & mask)
+            {
+                if (entries[slot].id == id)
+                    return &entries[slot];
+                if (entries[slot].id == 0)
+                    return NULL;
+            }
+        }
+
+        const Entry* find(id_t id) const
+        {
+            return const_cast<TaskTable*>(this)->find(id);
+        }
+
+        /**
+         * Inserts or overwrites the entry for id.
+         *
+         * Pointers to entries are invalid after this call.
+         */
+        void insert(id_t id, ITask* task, uint32_t index = 0)
+        {
+            assert(id != 0);
+            /* keep the load factor below 0.5 */
+            if (2 * (numEntries + 1) > entries.size())
+                rehash(entries.size() * 2);
+
+            Entry& entry = findSlot(id);
+            if (entry.id == 0)
+                ++numEntries;
+            entry.id = id;
+            entry.task = task;
+            entry.index = index;
+        }
+
+        /**
+         * Removes id from the table.
+         *
+         * Pointers to entries are invalid after this call.
+         *
+         * @return true if id was in the table
+         */
+        bool erase(id_t id)
+        {
+            Entry* entry = find(id);
+            if (entry == NULL)
+                return false;
+
+            const size_t mask = entries.size() - 1;
+            size_t hole = entry - &entries[0];
+            /* move entries which are displaced behind the hole into the hole */
+            for (size_t slot = (hole + 1) & mask; entries[slot].id != 0; slot = (slot + 1) & mask)
+            {
+                const size_t home = entries[slot].id & mask;
+                const bool homeInRange = hole <= slot ?
+                    (hole < home && home <= slot) :
+                    (hole < home || home <= slot);
+                if (!homeInRange)
+                {
+                    entries[hole] = entries[slot];
+                    hole = slot;
+                }
+            }
+            entries[hole].id = 0;
+            entries[hole].task = NULL;
+            --numEntries;
+            return true;
+        }
+
+        size_t size() const
+        {
+            return numEntries;
+        }
+
+    private:
+
+        static const size_t minCapacity = 1024;
+
+        Entry& findSlot(id_t id)
+        {
+            const size_t mask = entries.size() - 1;
+            size_t slot = id & mask;
+            while (entries[slot].id != 0 && entries[slot].id != id)
+                slot = (slot + 1) & mask;
+            return entries[slot];
+        }
+
+        void rehash(size_t newCapacity)
+        {
+            std::vector<Entry> old;
+            old.swap(entries);
+            Entry empty = {0, NULL, 0};
+            entries.resize(newCapacity, empty);
+            for (size_t i = 0; i < old.size(); ++i)
+                if (old[i].id != 0)
+                    findSlot(old[i].id) = old[i];
+        }
+
+        std::vector<Entry> entries;
+        size_t numEntries;
+    };
+
+} //namespace PMacc
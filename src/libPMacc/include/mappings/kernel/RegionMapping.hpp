@@ -0,0 +1,99 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+
+namespace PMacc
+{
+
+/** Mapping to a box of supercells
+ *
+ * The box is given by the index of its first supercell (including the guard)
+ * and its size in supercells. It can be used to run a kernel only on a part
+ * of an area, e.g. on the supercells exposed by a slide of the simulation.
+ */
+template<class baseClass>
+class RegionMapping;
+
+template<
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_
+>
+class RegionMapping<baseClass<DIM, SuperCellSize_> > : public baseClass<DIM, SuperCellSize_>
+{
+public:
+    typedef baseClass<DIM, SuperCellSize_> BaseClass;
+
+    enum
+    {
+        Dim = BaseClass::Dim
+    };
+
+
+    typedef typename BaseClass::SuperCellSize SuperCellSize;
+
+    /**
+     * Constructor
+     *
+     * @param base mapping description
+     * @param offset index of the first supercell of the region (including guard)
+     * @param size number of supercells of the region in each direction
+     */
+    HINLINE RegionMapping(BaseClass base, const DataSpace<DIM>& offset, const DataSpace<DIM>& size) :
+    BaseClass(base), offset(offset), size(size)
+    {
+    }
+
+    /**
+     * Generate grid dimension information for kernel calls
+     *
+     * @return size of the region
+     */
+    HINLINE DataSpace<DIM> getGridDim() const
+    {
+        return size;
+    }
+
+    /**
+     * Returns index of current logical block
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return mapped SuperCell index
+     */
+    HDINLINE DataSpace<DIM> getSuperCellIndex(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        return realSuperCellIdx + offset;
+    }
+
+private:
+
+    PMACC_ALIGN(offset, DataSpace<DIM>);
+    PMACC_ALIGN(size, DataSpace<DIM>);
+
+};
+
+} // namespace PMacc
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "mappings/kernel/AreaMappingMethods.hpp"
+
+#include <algorithm>
+
+namespace PMacc
+{
+
+/** Mapping which walks over an area in slices of supercells
+ *
+ * Each slice covers the full area but only a fixed number of supercells in
+ * the last dimension, the last slice can be thinner. This allows to process
+ * an area in batches with a bounded amount of work (e.g. memory) per call.
+ *
+ * Only areas which form a box are supported (CORE, CORE+BORDER, CORE+BORDER+GUARD).
+ */
+template<uint32_t areaType, class baseClass>
+class SliceMapping;
+
+template<
+uint32_t areaType,
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_
+>
+class SliceMapping<areaType, baseClass<DIM, SuperCellSize_> > : public baseClass<DIM, SuperCellSize_>
+{
+public:
+    typedef baseClass<DIM, SuperCellSize_> BaseClass;
+
+    enum
+    {
+        AreaType = areaType, Dim = BaseClass::Dim
+    };
+
+
+    typedef typename BaseClass::SuperCellSize SuperCellSize;
+
+    /**
+     * Constructor
+     *
+     * @param base mapping description
+     * @param superCellsPerSlice number of supercells of one slice in the last dimension
+     */
+    HINLINE SliceMapping(BaseClass base, int superCellsPerSlice) :
+    BaseClass(base), sliceOffset(0), sliceSize(std::max(superCellsPerSlice, 1))
+    {
+        areaSuperCells = AreaMappingMethods<areaType, DIM>::getGridDim(*this, this->getGridSuperCells());
+    }
+
+    /**
+     * Generate grid dimension information for kernel calls
+     *
+     * @return size of the current slice
+     */
+    HINLINE DataSpace<DIM> getGridDim() const
+    {
+        DataSpace<DIM> gridDim(areaSuperCells);
+        gridDim[DIM - 1] = std::min(sliceSize, areaSuperCells[DIM - 1] - sliceOffset);
+        return gridDim;
+    }
+
+    /**
+     * Returns index of current logical block
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return mapped SuperCell index
+     */
+    HDINLINE DataSpace<DIM> getSuperCellIndex(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        DataSpace<DIM> areaIdx(realSuperCellIdx);
+        areaIdx[DIM - 1] += sliceOffset;
+        return AreaMappingMethods<areaType, DIM>::getBlockIndex(*this, this->getGridSuperCells(), areaIdx);
+    }
+
+    /** set mapper to next slice
+     *
+     * @return true if slice is valid, else false
+     */
+    HINLINE bool next()
+    {
+        sliceOffset += sliceSize;
+        return sliceOffset < areaSuperCells[DIM - 1];
+    }
+
+private:
+
+    PMACC_ALIGN(areaSuperCells, DataSpace<DIM>);
+    PMACC_ALIGN(sliceOffset, int);
+    PMACC_ALIGN(sliceSize, int);
+
+};
+
+} // namespace PMacc
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "memory/boxes/DataBox.hpp"
+#include "memory/boxes/PitchedBox.hpp"
+
+namespace PMacc
+{
+
+/** Mapping to a list of supercells
+ *
+ * One block is started for each entry of the list. The list holds the
+ * indices of the supercells (including guard) on the device, e.g. the
+ * supercells with particles collected by ActiveSuperCells.
+ * The mapping must not be used to start a kernel if the list is empty.
+ */
+template<class baseClass>
+class SuperCellListMapping;
+
+template<
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_
+>
+class SuperCellListMapping<baseClass<DIM, SuperCellSize_> > : public baseClass<DIM, SuperCellSize_>
+{
+public:
+    typedef baseClass<DIM, SuperCellSize_> BaseClass;
+
+    enum
+    {
+        Dim = BaseClass::Dim
+    };
+
+
+    typedef typename BaseClass::SuperCellSize SuperCellSize;
+    typedef DataBox<PitchedBox<DataSpace<DIM>, DIM1> > ListBox;
+
+    /**
+     * Constructor
+     *
+     * @param base mapping description
+     * @param list device box with the supercell indices (including guard)
+     * @param size number of supercells in the list
+     */
+    HINLINE SuperCellListMapping(BaseClass base, ListBox list, uint32_t size) :
+    BaseClass(base), list(list), size(size)
+    {
+    }
+
+    /**
+     * Generate grid dimension information for kernel calls
+     *
+     * @return size of the list in x direction, one in all other directions
+     */
+    HINLINE DataSpace<DIM> getGridDim() const
+    {
+        DataSpace<DIM> gridDim(DataSpace<DIM>::create(1));
+        gridDim.x() = size;
+        return gridDim;
+    }
+
+    /**
+     * Returns index of current logical block
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return mapped SuperCell index
+     */
+    HDINLINE DataSpace<DIM> getSuperCellIndex(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        return list[realSuperCellIdx.x()];
+    }
+
+    /** @return number of supercells in the list */
+    HINLINE uint32_t getSize() const
+    {
+        return size;
+    }
+
+private:
+
+    PMACC_ALIGN(list, ListBox);
+    PMACC_ALIGN(size, uint32_t);
+
+};
+
+} // namespace PMacc
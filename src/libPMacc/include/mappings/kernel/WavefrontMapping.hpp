@@ -0,0 +1,142 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "mappings/kernel/AreaMappingMethods.hpp"
+
+namespace PMacc
+{
+
+/** Mapping which walks over an area in diagonal wavefronts
+ *
+ * All supercells with the same sum of their (area relative) indices form one
+ * wavefront. Each supercell of a wavefront has all its lower neighbors
+ * (-1 in any dimension) in previous wavefronts and all its upper neighbors
+ * in later wavefronts. Kernels which read upper neighbors before and lower
+ * neighbors after an update can therefore work in place.
+ *
+ * The grid of one call covers the area with the last dimension collapsed,
+ * blocks for which isValid() is false must return immediately.
+ *
+ * Only areas which form a box are supported (CORE, CORE+BORDER, CORE+BORDER+GUARD).
+ */
+template<uint32_t areaType, class baseClass>
+class WavefrontMapping;
+
+template<
+uint32_t areaType,
+template<unsigned, class> class baseClass,
+unsigned DIM,
+class SuperCellSize_
+>
+class WavefrontMapping<areaType, baseClass<DIM, SuperCellSize_> > : public baseClass<DIM, SuperCellSize_>
+{
+public:
+    typedef baseClass<DIM, SuperCellSize_> BaseClass;
+
+    enum
+    {
+        AreaType = areaType, Dim = BaseClass::Dim
+    };
+
+
+    typedef typename BaseClass::SuperCellSize SuperCellSize;
+
+    HINLINE WavefrontMapping(BaseClass base) : BaseClass(base), wavefront(0), numWavefronts(1)
+    {
+        areaSuperCells = AreaMappingMethods<areaType, DIM>::getGridDim(*this, this->getGridSuperCells());
+        for (uint32_t d = 0; d < DIM; ++d)
+            numWavefronts += areaSuperCells[d] - 1;
+    }
+
+    /**
+     * Generate grid dimension information for kernel calls
+     *
+     * @return size of the area with a size of one in the last dimension
+     */
+    HINLINE DataSpace<DIM> getGridDim() const
+    {
+        DataSpace<DIM> gridDim(areaSuperCells);
+        gridDim[DIM - 1] = 1;
+        return gridDim;
+    }
+
+    /**
+     * Returns index of current logical block
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return mapped SuperCell index
+     */
+    HDINLINE DataSpace<DIM> getSuperCellIndex(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        DataSpace<DIM> areaIdx(realSuperCellIdx);
+        areaIdx[DIM - 1] = getLastComponent(realSuperCellIdx);
+        return AreaMappingMethods<areaType, DIM>::getBlockIndex(*this, this->getGridSuperCells(), areaIdx);
+    }
+
+    /** check if a block is part of the current wavefront
+     *
+     * @param realSuperCellIdx current SuperCell index (block index)
+     * @return true if the block maps to a supercell, else false
+     */
+    HDINLINE bool isValid(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        const int last = getLastComponent(realSuperCellIdx);
+        return last >= 0 && last < areaSuperCells[DIM - 1];
+    }
+
+    HDINLINE int getWavefront() const
+    {
+        return wavefront;
+    }
+
+    /** set mapper to next wavefront
+     *
+     * @return true if wavefront is valid, else false
+     */
+    HINLINE bool next()
+    {
+        wavefront++;
+        return wavefront < numWavefronts;
+    }
+
+private:
+
+    HDINLINE int getLastComponent(const DataSpace<DIM>& realSuperCellIdx) const
+    {
+        int last = wavefront;
+        for (uint32_t d = 0; d < DIM - 1; ++d)
+            last -= realSuperCellIdx[d];
+        return last;
+    }
+
+    PMACC_ALIGN(areaSuperCells, DataSpace<DIM>);
+    PMACC_ALIGN(wavefront, int);
+    PMACC_ALIGN(numWavefronts, int);
+
+};
+
+} // namespace PMacc
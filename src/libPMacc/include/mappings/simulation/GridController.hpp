@@ -156,6 +156,18 @@ namespace PMacc
                 return comm.getSize();
             }
 
+            /**
+             * Sets the direction in which the GPU nodes are reassigned by slide().
+             *
+             * Must be called before the first slide.
+             *
+             * @param direction 0 == x, 1 == y, 2 == z
+             */
+            void setSlideDirection(uint32_t direction)
+            {
+                comm.setSlideDirection(direction);
+            }
+
             /**
              * Initialises a slide of the simulation area.
              *
@@ -186,7 +198,7 @@ namespace PMacc
              *
              * \warning you are not allowed to call this method if moving
              *          the simulation does not use a moving window,
-             *          else static load balancing will break in y-direction
+             *          else static load balancing will break in slide direction
              *
              * @param[in] numSlides number of slides
              * @return true if the position of gpu is switched to the end, else false
@@ -243,20 +255,21 @@ namespace PMacc
              * (This function is idempotent)
              *
              * \warning the implementation of this method is not compatible with
-             *          static load balancing in y-direction
+             *          static load balancing in slide direction
              */
             void updateLocalDomainOffset()
             {
                 /* if we slide we must change our localDomain.offset of the simulation
-                 * (only change slide direction Y)
+                 * (only change slide direction)
                  */
-                int gpuOffset_y = this->getPosition().y();
+                const uint32_t slideDirection = comm.getSlideDirection();
+                int gpuOffset = this->getPosition()[slideDirection];
                 const SubGrid<DIM>& subGrid = Environment<DIM>::get().SubGrid();
                 DataSpace<DIM> localDomainOffset(subGrid.getLocalDomain().offset);
                 /* this is allowed in the case that we use sliding window
-                 * because size in Y direction is the same for all gpus domains
+                 * because size in slide direction is the same for all gpus domains
                  */
-                localDomainOffset.y() = gpuOffset_y * subGrid.getLocalDomain().size.y();
+                localDomainOffset[slideDirection] = gpuOffset * subGrid.getLocalDomain().size[slideDirection];
 
                 Environment<DIM>::get().SubGrid().setLocalDomainOffset(localDomainOffset);
             }
@@ -28,6 +28,17 @@
 
 namespace PMacc
 {
+    /** get the address of the element referenced by a DataBox access
+     *
+     * Boxes which return proxy objects instead of C++ references
+     * (e.g. VectorMultiBox) provide an overload next to their reference type.
+     */
+    template<typename T_Type>
+    HDINLINE T_Type* getAddressOf(T_Type& value)
+    {
+        return &value;
+    }
+
     namespace private_Box
     {
         template<unsigned DIM, class Base>
@@ -152,7 +163,7 @@ namespace PMacc
         HDINLINE Type shift(const DataSpace<Base::Dim>& offset) const
         {
             Type result(*this);
-            result.fixedPointer = &((*this)(offset));
+            result.fixedPointer = getAddressOf((*this)(offset));
             return result;
         }
 
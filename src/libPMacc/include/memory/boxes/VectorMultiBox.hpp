@@ -0,0 +1,359 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "memory/boxes/DataBox.hpp"
+
+namespace PMacc
+{
+
+/** reference to a vector which is stored component wise (structure of arrays)
+ *
+ * The components of the vector are located attributePitch bytes apart.
+ * Reading converts to the vector type, writing and the compound operators
+ * are forwarded to each component.
+ *
+ * @tparam T_Vector vector type (e.g. math::Vector), needs `type` and `dim`
+ */
+template<typename T_Vector>
+class VectorReference
+{
+public:
+    typedef T_Vector ValueType;
+    typedef typename ValueType::type ComponentType;
+    BOOST_STATIC_CONSTEXPR int dim = ValueType::dim;
+
+    HDINLINE VectorReference(ComponentType* ptr, const size_t attributePitch) :
+    ptr(ptr), attributePitch(attributePitch)
+    {
+    }
+
+    HDINLINE ComponentType& operator[](const int idx) const
+    {
+        return *((ComponentType*) ((char*) ptr + idx * attributePitch));
+    }
+
+    HDINLINE ComponentType& x() const
+    {
+        return (*this)[0];
+    }
+
+    HDINLINE ComponentType& y() const
+    {
+        return (*this)[1];
+    }
+
+    HDINLINE ComponentType& z() const
+    {
+        return (*this)[2];
+    }
+
+    HDINLINE operator ValueType() const
+    {
+        ValueType result;
+        for (int i = 0; i < dim; ++i)
+            result[i] = (*this)[i];
+        return result;
+    }
+
+    /* copy the referenced values, the reference itself is never rebound */
+    HDINLINE const VectorReference& operator=(const VectorReference& other) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] = other[i];
+        return *this;
+    }
+
+    template<typename T_Other>
+    HDINLINE const VectorReference& operator=(const T_Other& other) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] = other[i];
+        return *this;
+    }
+
+    template<typename T_Other>
+    HDINLINE const VectorReference& operator+=(const T_Other& other) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] += other[i];
+        return *this;
+    }
+
+    template<typename T_Other>
+    HDINLINE const VectorReference& operator-=(const T_Other& other) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] -= other[i];
+        return *this;
+    }
+
+    HDINLINE const VectorReference& operator*=(const ComponentType scalar) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] *= scalar;
+        return *this;
+    }
+
+    HDINLINE const VectorReference& operator/=(const ComponentType scalar) const
+    {
+        for (int i = 0; i < dim; ++i)
+            (*this)[i] /= scalar;
+        return *this;
+    }
+
+    HDINLINE ComponentType* getPointer() const
+    {
+        return ptr;
+    }
+
+private:
+    PMACC_ALIGN(ptr, ComponentType*);
+    PMACC_ALIGN(attributePitch, size_t);
+};
+
+/** address of the first component of a VectorReference
+ *
+ * used by DataBox::shift()
+ */
+template<typename T_Vector>
+HDINLINE typename T_Vector::type* getAddressOf(const VectorReference<T_Vector>& value)
+{
+    return value.getPointer();
+}
+
+/** box over vectors stored as structure of arrays
+ *
+ * All components share the same pitched layout, component i of the vector
+ * starts i * attributePitch bytes behind the first component.
+ * Access returns a VectorReference instead of a C++ reference.
+ *
+ * @tparam T_Vector vector type
+ * @tparam DIM dimension of the box
+ */
+template<typename T_Vector, unsigned DIM>
+class VectorMultiBox;
+
+template<typename T_Vector>
+class VectorMultiBox<T_Vector, DIM1>
+{
+public:
+
+    enum
+    {
+        Dim = DIM1
+    };
+    typedef T_Vector ValueType;
+    typedef typename ValueType::type ComponentType;
+    typedef VectorReference<ValueType> RefValueType;
+    typedef VectorMultiBox<T_Vector, DIM1> ReducedType;
+
+    HDINLINE RefValueType operator[](const int idx) const
+    {
+        return RefValueType(fixedPointer + idx, attributePitch);
+    }
+
+    HDINLINE VectorMultiBox(ComponentType* pointer, const DataSpace<DIM1> &offset, const DataSpace<DIM1>&,
+                            const size_t, const size_t attributePitch) :
+    attributePitch(attributePitch),
+    fixedPointer(pointer + offset[0])
+    {
+    }
+
+    HDINLINE VectorMultiBox(ComponentType* pointer, const size_t attributePitch) :
+    attributePitch(attributePitch),
+    fixedPointer(pointer)
+    {
+    }
+
+    /*Object must init by copy a valid instance*/
+    HDINLINE VectorMultiBox()
+    {
+    }
+
+    HDINLINE RefValueType operator*() const
+    {
+        return RefValueType(fixedPointer, attributePitch);
+    }
+
+    HDINLINE ComponentType* getPointer() const
+    {
+        return fixedPointer;
+    }
+
+    HDINLINE size_t getAttributePitch() const
+    {
+        return attributePitch;
+    }
+
+protected:
+
+    PMACC_ALIGN(attributePitch, size_t);
+    PMACC_ALIGN(fixedPointer, ComponentType*);
+};
+
+template<typename T_Vector>
+class VectorMultiBox<T_Vector, DIM2>
+{
+public:
+
+    enum
+    {
+        Dim = DIM2
+    };
+    typedef T_Vector ValueType;
+    typedef typename ValueType::type ComponentType;
+    typedef VectorReference<ValueType> RefValueType;
+    typedef VectorMultiBox<T_Vector, DIM1> ReducedType;
+
+    HDINLINE ReducedType operator[](const int idx) const
+    {
+        return ReducedType((ComponentType*) ((char*) this->fixedPointer + idx * pitch), attributePitch);
+    }
+
+    HDINLINE VectorMultiBox(ComponentType* pointer, const DataSpace<DIM2> &offset, const DataSpace<DIM2>&,
+                            const size_t pitch, const size_t attributePitch) :
+    pitch(pitch),
+    attributePitch(attributePitch),
+    fixedPointer((ComponentType*) ((char*) pointer + offset[1] * pitch) + offset[0])
+    {
+    }
+
+    HDINLINE VectorMultiBox(ComponentType* pointer, const size_t pitch, const size_t attributePitch) :
+    pitch(pitch),
+    attributePitch(attributePitch),
+    fixedPointer(pointer)
+    {
+    }
+
+    /*Object must init by copy a valid instance*/
+    HDINLINE VectorMultiBox()
+    {
+    }
+
+    HDINLINE RefValueType operator*() const
+    {
+        return RefValueType(fixedPointer, attributePitch);
+    }
+
+    HDINLINE ComponentType* getPointer() const
+    {
+        return fixedPointer;
+    }
+
+    HDINLINE size_t getAttributePitch() const
+    {
+        return attributePitch;
+    }
+
+protected:
+
+    HDINLINE VectorMultiBox<T_Vector, DIM1> reduceZ(const int zOffset) const
+    {
+        return VectorMultiBox<T_Vector, DIM1 > (
+                                                (ComponentType*) ((char*) (this->fixedPointer) + pitch * zOffset),
+                                                attributePitch
+                                                );
+    }
+
+    PMACC_ALIGN(pitch, size_t);
+    PMACC_ALIGN(attributePitch, size_t);
+    PMACC_ALIGN(fixedPointer, ComponentType*);
+};
+
+template<typename T_Vector>
+class VectorMultiBox<T_Vector, DIM3>
+{
+public:
+
+    enum
+    {
+        Dim = DIM3
+    };
+    typedef T_Vector ValueType;
+    typedef typename ValueType::type ComponentType;
+    typedef VectorReference<ValueType> RefValueType;
+    typedef VectorMultiBox<T_Vector, DIM2> ReducedType;
+
+    HDINLINE ReducedType operator[](const int idx) const
+    {
+        return ReducedType((ComponentType*) ((char*) (this->fixedPointer) + idx * pitch2D), pitch, attributePitch);
+    }
+
+    /** constructor
+     *
+     * @param pointer pointer to the origin of the physical memory of the first component
+     * @param offset offset (in elements)
+     * @param memSize size of the physical memory of one component (in elements)
+     * @param pitch number of bytes in one line (first dimension)
+     * @param attributePitch number of bytes between two components
+     */
+    HDINLINE VectorMultiBox(ComponentType* pointer, const DataSpace<DIM3> &offset, const DataSpace<DIM3> &memSize,
+                            const size_t pitch, const size_t attributePitch) :
+    pitch(pitch), pitch2D(memSize[1] * pitch),
+    attributePitch(attributePitch),
+    fixedPointer((ComponentType*) ((char*) pointer + offset[2] * (memSize[1] * pitch) + offset[1] * pitch) + offset[0])
+    {
+    }
+
+    /*Object must init by copy a valid instance*/
+    HDINLINE VectorMultiBox()
+    {
+    }
+
+    HDINLINE RefValueType operator*() const
+    {
+        return RefValueType(fixedPointer, attributePitch);
+    }
+
+    HDINLINE ComponentType* getPointer() const
+    {
+        return fixedPointer;
+    }
+
+    HDINLINE size_t getAttributePitch() const
+    {
+        return attributePitch;
+    }
+
+protected:
+
+    HDINLINE VectorMultiBox<T_Vector, DIM2> reduceZ(const int zOffset) const
+    {
+        return VectorMultiBox<T_Vector, DIM2 > (
+                                                (ComponentType*) ((char*) (this->fixedPointer) + pitch2D * zOffset),
+                                                pitch,
+                                                attributePitch
+                                                );
+    }
+
+    PMACC_ALIGN(pitch, size_t);
+    PMACC_ALIGN(pitch2D, size_t);
+    PMACC_ALIGN(attributePitch, size_t);
+    PMACC_ALIGN(fixedPointer, ComponentType*);
+};
+
+} //namespace PMacc
@@ -25,6 +25,8 @@
 #include "memory/buffers/DeviceBuffer.hpp"
 #include "memory/buffers/HostBuffer.hpp"
 
+#include <mpi.h>
+
 namespace PMacc
 {
 
@@ -82,6 +84,47 @@ namespace PMacc
 
         virtual DeviceBuffer<TYPE, DIM>& getDeviceDoubleBuffer()=0;
 
+        /**
+         * Returns true if MPI sends and receives straight from the device buffer
+         *
+         * This is only possible if device memory is host memory and the size
+         * of the exchange is fixed. The host buffer is not used in this case.
+         *
+         * @return true if no staging copies are needed
+         */
+        virtual bool isDirectExchange()=0;
+
+        /**
+         * Returns the MPI datatype describing the (pitched) device buffer
+         *
+         * Only valid if isDirectExchange() is true. One element of this type
+         * covers the whole exchange.
+         *
+         * @return committed MPI datatype
+         */
+        virtual MPI_Datatype getMPIDatatype()=0;
+
+        /**
+         * Returns a persistent MPI request which sends the whole exchange
+         *
+         * The request is created on first use and recreated if the neighbor
+         * ranks have changed (e.g. after a slide).
+         *
+         * @return inactive persistent request or NULL if the message size of
+         *         this exchange is not fixed
+         */
+        virtual MPI_Request* getPersistentSendRequest()=0;
+
+        /**
+         * Returns a persistent MPI request which receives the whole exchange
+         *
+         * @see getPersistentSendRequest
+         *
+         * @return inactive persistent request or NULL if the message size of
+         *         this exchange is not fixed
+         */
+        virtual MPI_Request* getPersistentReceiveRequest()=0;
+
     protected:
 
         Exchange(uint32_t extype, uint32_t tag) :
@@ -32,8 +32,12 @@
 #include "eventSystem/tasks/Factory.hpp"
 #include "eventSystem/tasks/TaskReceive.hpp"
 
+#include "communication/manager_common.h"
+#include "communication/ICommunicator.hpp"
+#include "mappings/simulation/EnvironmentController.hpp"
 #include "pmacc_types.hpp"
 
+#include <mpi.h>
 #include <cassert>
 
 namespace PMacc
@@ -80,7 +84,7 @@ namespace PMacc
             }
 #endif
 
-            this->hostBuffer = new HostBufferIntern<TYPE, DIM > (tmp_size);
+            initMessageBuffer(sizeOnDevice);
         }
 
         ExchangeIntern(DataSpace<DIM> exchangeDataSpace, uint32_t exchange,
@@ -89,13 +93,15 @@ namespace PMacc
         {
             this->deviceBuffer = new DeviceBufferIntern<TYPE, DIM > (exchangeDataSpace, sizeOnDevice);
            //  this->deviceBuffer = new DeviceBufferIntern<TYPE, DIM > (exchangeDataSpace, sizeOnDevice,true);
+#if(PMACC_CUDA_ENABLED == 1)
             if (DIM > DIM1)
             {
                 /*create double buffer on gpu for faster memory transfers*/
                this->deviceDoubleBuffer = new DeviceBufferIntern<TYPE, DIM > (exchangeDataSpace, false, true);
             }
+#endif
 
-            this->hostBuffer = new HostBufferIntern<TYPE, DIM > (exchangeDataSpace);
+            initMessageBuffer(sizeOnDevice);
         }
 
         /**
@@ -123,6 +129,17 @@ namespace PMacc
 
         virtual ~ExchangeIntern()
         {
+            int finalized = 0;
+            MPI_CHECK(MPI_Finalized(&finalized));
+            if (!finalized)
+            {
+                if (sendRequest != MPI_REQUEST_NULL)
+                    MPI_CHECK(MPI_Request_free(&sendRequest));
+                if (receiveRequest != MPI_REQUEST_NULL)
+                    MPI_CHECK(MPI_Request_free(&receiveRequest));
+                if (directExchange)
+                    MPI_CHECK(MPI_Type_free(&mpiDatatype));
+            }
             __delete(hostBuffer);
             __delete(deviceBuffer);
             __delete(deviceDoubleBuffer);
@@ -200,6 +217,9 @@ namespace PMacc
 
         virtual HostBuffer<TYPE, DIM>& getHostBuffer()
         {
+            /* direct exchanges never touch the host buffer, create it only on demand */
+            if (hostBuffer == NULL)
+                hostBuffer = new HostBufferIntern<TYPE, DIM > (deviceBuffer->getDataSpace());
             return *hostBuffer;
         }
 
@@ -218,6 +238,58 @@ namespace PMacc
             return *deviceDoubleBuffer;
         }
 
+        virtual bool isDirectExchange()
+        {
+            return directExchange;
+        }
+
+        virtual MPI_Datatype getMPIDatatype()
+        {
+            return mpiDatatype;
+        }
+
+        virtual MPI_Request* getPersistentSendRequest()
+        {
+            if (!fixedMessage)
+                return NULL;
+
+            ICommunicator& comm = Environment<DIM>::get().EnvironmentController().getCommunicator();
+            if (sendRequest == MPI_REQUEST_NULL || sendTopologyVersion != comm.getTopologyVersion())
+            {
+                if (sendRequest != MPI_REQUEST_NULL)
+                    MPI_CHECK(MPI_Request_free(&sendRequest));
+                if (directExchange)
+                    comm.initSend(this->getExchangeType(), (char*) deviceBuffer->getPointer(),
+                                  1, mpiDatatype, this->getCommunicationTag(), &sendRequest);
+                else
+                    comm.initSend(this->getExchangeType(), (char*) getHostBuffer().getBasePointer(),
+                                  getMessageBytes(), MPI_CHAR, this->getCommunicationTag(), &sendRequest);
+                sendTopologyVersion = comm.getTopologyVersion();
+            }
+            return &sendRequest;
+        }
+
+        virtual MPI_Request* getPersistentReceiveRequest()
+        {
+            if (!fixedMessage)
+                return NULL;
+
+            ICommunicator& comm = Environment<DIM>::get().EnvironmentController().getCommunicator();
+            if (receiveRequest == MPI_REQUEST_NULL || receiveTopologyVersion != comm.getTopologyVersion())
+            {
+                if (receiveRequest != MPI_REQUEST_NULL)
+                    MPI_CHECK(MPI_Request_free(&receiveRequest));
+                if (directExchange)
+                    comm.initReceive(this->getExchangeType(), (char*) deviceBuffer->getPointer(),
+                                     1, mpiDatatype, this->getCommunicationTag(), &receiveRequest);
+                else
+                    comm.initReceive(this->getExchangeType(), (char*) getHostBuffer().getBasePointer(),
+                                     getMessageBytes(), MPI_CHAR, this->getCommunicationTag(), &receiveRequest);
+                receiveTopologyVersion = comm.getTopologyVersion();
+            }
+            return &receiveRequest;
+        }
+
         EventTask startSend()
         {
             return Environment<>::get().Factory().createTaskSend(*this);
@@ -229,6 +301,85 @@ namespace PMacc
         }
 
     protected:
+
+        /**
+         * Select the message path of this exchange
+         *
+         * On host accelerators device memory is host memory, so MPI can read
+         * and write the (pitched) sub-box of the device buffer in place by
+         * using a derived datatype. Exchanges with a size stored on the device
+         * and one dimensional exchanges (particle stacks) transfer only a
+         * variable prefix, their receive size is tracked by the host buffer
+         * and therefore they are still staged.
+         *
+         * @param sizeOnDevice true if the current size of the exchange is stored on the device
+         */
+        void initMessageBuffer(bool sizeOnDevice)
+        {
+            hostBuffer = NULL;
+            directExchange = false;
+            sendRequest = MPI_REQUEST_NULL;
+            receiveRequest = MPI_REQUEST_NULL;
+            sendTopologyVersion = 0;
+            receiveTopologyVersion = 0;
+            /* field exchanges always transfer the full buffer and can use persistent requests */
+            fixedMessage = DIM > DIM1 && !sizeOnDevice;
+#if(PMACC_CUDA_ENABLED != 1)
+            if (DIM > DIM1 && !sizeOnDevice && deviceBuffer->getDataSpace().productOfComponents() != 0)
+            {
+                mpiDatatype = createMPIDatatype();
+                directExchange = true;
+                return;
+            }
+#endif
+            hostBuffer = new HostBufferIntern<TYPE, DIM > (deviceBuffer->getDataSpace());
+        }
+
+        /**
+         * Size of a fixed staged message in bytes
+         */
+        int getMessageBytes() const
+        {
+            return static_cast<int>(deviceBuffer->getDataSpace().productOfComponents() * sizeof (TYPE));
+        }
+
+        /**
+         * Create a MPI datatype which describes the device buffer in memory
+         *
+         * x is contiguous, y is strided by the pitch and z by the size of
+         * one (physical) xy-plane.
+         *
+         * @return committed MPI datatype
+         */
+        MPI_Datatype createMPIDatatype()
+        {
+            const DataSpace<DIM> size = deviceBuffer->getDataSpace();
+
+            MPI_Datatype current;
+            MPI_CHECK(MPI_Type_contiguous(static_cast<int>(size[0] * sizeof (TYPE)), MPI_BYTE, &current));
+
+            if (DIM >= DIM2)
+            {
+                const size_t pitch = deviceBuffer->getPitch();
+                MPI_Datatype plane;
+                MPI_CHECK(MPI_Type_create_hvector(size[1], 1, static_cast<MPI_Aint>(pitch), current, &plane));
+                MPI_CHECK(MPI_Type_free(&current));
+                current = plane;
+
+                if (DIM == DIM3)
+                {
+                    const size_t planeSize = pitch * deviceBuffer->getPhysicalMemorySize()[1];
+                    MPI_Datatype volume;
+                    MPI_CHECK(MPI_Type_create_hvector(size[2], 1, static_cast<MPI_Aint>(planeSize), current, &volume));
+                    MPI_CHECK(MPI_Type_free(&current));
+                    current = volume;
+                }
+            }
+
+            MPI_CHECK(MPI_Type_commit(&current));
+            return current;
+        }
+
         HostBufferIntern<TYPE, DIM> *hostBuffer;
 
         /*! This buffer is a vector which is used as message buffer for faster memcopy
@@ -236,6 +387,18 @@ namespace PMacc
         DeviceBufferIntern<TYPE, DIM> *deviceDoubleBuffer;
         DeviceBufferIntern<TYPE, DIM> *deviceBuffer;
 
+        /*! true if MPI uses deviceBuffer in place (see initMessageBuffer) */
+        bool directExchange;
+        MPI_Datatype mpiDatatype;
+
+        /*! true if every message transfers the whole buffer */
+        bool fixedMessage;
+        MPI_Request sendRequest;
+        MPI_Request receiveRequest;
+        /*! topology version of the communicator the requests are created for */
+        uint32_t sendTopologyVersion;
+        uint32_t receiveTopologyVersion;
+
     };
 
 }
@@ -357,6 +357,35 @@ public:
         addExchangeBuffer( receive, dataSpace, communicationTag, sizeOnDevice, sizeOnDevice );
     }
 
+    /**
+     * Change the size of a dedicated send exchange buffer.
+     *
+     * Only exchanges added with their own memory
+     * (see addExchangeBuffer(const Mask&, const DataSpace<DIM>&, ...)) can be resized.
+     * The content of the buffer is lost and no communication
+     * of the exchange may be in progress.
+     *
+     * @param ex exchange direction of the send buffer
+     * @param dataSpace new size of the exchange buffer
+     */
+    void resizeSendExchange(uint32_t ex, const DataSpace<DIM> &dataSpace)
+    {
+        resizeExchange(sendExchanges[ex], dataSpace);
+    }
+
+    /**
+     * Change the size of a dedicated receive exchange buffer.
+     *
+     * @see resizeSendExchange
+     *
+     * @param ex exchange direction of the receive buffer
+     * @param dataSpace new size of the exchange buffer
+     */
+    void resizeReceiveExchange(uint32_t ex, const DataSpace<DIM> &dataSpace)
+    {
+        resizeExchange(receiveExchanges[ex], dataSpace);
+    }
+
     /**
      * Returns whether this GridBuffer has an Exchange for sending in ex direction.
      *
@@ -504,6 +533,19 @@ private:
 
     friend class Environment<DIM>;
 
+    void resizeExchange(ExchangeIntern<BORDERTYPE, DIM>* &exchange, const DataSpace<DIM> &dataSpace)
+    {
+        assert(exchange != NULL);
+        assert(dataSpace.productOfComponents() != 0);
+
+        ExchangeIntern<BORDERTYPE, DIM>* oldExchange = exchange;
+        exchange = new ExchangeIntern<BORDERTYPE, DIM > (dataSpace,
+                                                         oldExchange->getExchangeType(),
+                                                         oldExchange->getCommunicationTag(),
+                                                         oldExchange->getDeviceBuffer().hasCurrentSizeOnDevice());
+        __delete(oldExchange);
+    }
+
     void init()
     {
         for (uint32_t i = 0; i < 27; ++i)
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+
+namespace PMacc
+{
+    namespace nvidia
+    {
+        namespace rng
+        {
+            namespace distributions
+            {
+
+                /*create a random float number from [0.0,1.0)
+                 *
+                 * uses the upper 24 of 32 random bits (the float mantissa),
+                 * works with any method whose state returns a uint32_t
+                 * on operator(), e.g. methods::Philox
+                 */
+                class UniformFromBits_float
+                {
+                public:
+                    typedef float Type;
+
+                    HDINLINE UniformFromBits_float()
+                    {
+                    }
+
+                    template<class RNGState>
+                    HDINLINE Type operator()(RNGState& state) const
+                    {
+                        return static_cast<Type>(state() >> 8) * (Type(1.0) / Type(16777216.0));
+                    }
+
+                };
+            }
+        }
+    }
+}
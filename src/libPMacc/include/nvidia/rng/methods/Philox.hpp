@@ -0,0 +1,150 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "pmacc_types.hpp"
+
+namespace PMacc
+{
+namespace nvidia
+{
+namespace rng
+{
+namespace methods
+{
+
+/** counter based random number generator Philox4x32-10
+ *
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC'11
+ *
+ * A random number is the encryption of a 128bit counter with a 64bit key.
+ * The generator has no state besides its position in the stream and does
+ * not need an accelerator to be created: each worker can create a
+ * statistically independent generator on the fly, e.g. with the key
+ * (seed, supercell index) and a stream per cell in the supercell.
+ */
+class Philox
+{
+public:
+
+    /** position in the random number stream
+     *
+     * four random 32bit words are created per encryption of the counter
+     */
+    struct State
+    {
+        uint32_t key[2];
+        /* counter[0] and counter[1] are a 64bit draw counter,
+         * counter[2] and counter[3] select the stream */
+        uint32_t counter[4];
+        uint32_t result[4];
+        uint32_t resultIdx;
+
+        /** @return next 32 random bits of the stream */
+        HDINLINE uint32_t operator()()
+        {
+            if (resultIdx == 4u)
+            {
+                Philox::generate(key, counter, result);
+                if (++counter[0] == 0u)
+                    ++counter[1];
+                resultIdx = 0u;
+            }
+            return result[resultIdx++];
+        }
+    };
+
+    typedef State StateType;
+
+    HDINLINE Philox()
+    {
+    }
+
+    /**
+     * @param seed first word of the key
+     * @param subsequence second word of the key, e.g. a linear supercell index
+     * @param stream stream within the subsequence, e.g. the cell in the supercell
+     */
+    HDINLINE Philox(uint32_t seed, uint32_t subsequence, uint32_t stream = 0u)
+    {
+        state.key[0] = seed;
+        state.key[1] = subsequence;
+        state.counter[0] = 0u;
+        state.counter[1] = 0u;
+        state.counter[2] = stream;
+        state.counter[3] = 0u;
+        state.resultIdx = 4u;
+    }
+
+    HDINLINE Philox(const Philox& other): state(other.state)
+    {
+    }
+
+    /** encrypt a counter with a key (ten Philox rounds)
+     *
+     * @param key 64bit key
+     * @param counter 128bit counter
+     * @param[out] result 128 random bits
+     */
+    static HDINLINE void generate(const uint32_t key[2], const uint32_t counter[4], uint32_t result[4])
+    {
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        result[0] = counter[0];
+        result[1] = counter[1];
+        result[2] = counter[2];
+        result[3] = counter[3];
+
+        for (int r = 0; r < 10; ++r)
+        {
+            if (r != 0)
+            {
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * result[0];
+            const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * result[2];
+            const uint32_t c1 = result[1];
+            const uint32_t c3 = result[3];
+            result[0] = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            result[1] = static_cast<uint32_t>(p1);
+            result[2] = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            result[3] = static_cast<uint32_t>(p0);
+        }
+    }
+
+protected:
+
+    HDINLINE StateType& getState()
+    {
+        return state;
+    }
+
+private:
+    PMACC_ALIGN(state, StateType);
+};
+}
+}
+}
+}
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "mappings/kernel/SuperCellListMapping.hpp"
+#include "particles/ActiveSuperCells.kernel"
+
+#include <vector>
+#include <cmath>
+
+namespace PMacc
+{
+
+/** list of the supercells with particles in CORE+BORDER
+ *
+ * Particle kernels started with the mappings of this class skip all empty
+ * supercells, e.g. the vacuum regions of a simulation. The list is not
+ * updated by the particle kernels: after particles were created in an empty
+ * supercell (shift, insert, creation, ...) update() must be called before
+ * the mappings are used again.
+ *
+ * The same update also collects the reachable supercells: all supercells
+ * which can hold particles after the particles were moved by at most one
+ * supercell and particles were received from the neighbors. Their mappings
+ * stay valid for the particles after a push, shift and exchange, e.g. for
+ * the current deposition, without a second update.
+ *
+ * @tparam T_MappingDesc mapping description of the particles
+ */
+template<class T_MappingDesc>
+class ActiveSuperCells
+{
+public:
+    typedef T_MappingDesc MappingDesc;
+
+    enum
+    {
+        Dim = MappingDesc::Dim
+    };
+
+    typedef SuperCellListMapping<MappingDesc> ListMapping;
+
+    ActiveSuperCells(MappingDesc cellDescription) :
+    cellDescription(cellDescription), numActive(0)
+    {
+        const DataSpace<Dim> gridSuperCells(cellDescription.getGridSuperCells());
+
+        numStrideClasses = DataSpace<Dim>::create(3).productOfComponents();
+        classCapacity = ((gridSuperCells + 2) / 3).productOfComponents();
+        numActiveInClass.resize(numStrideClasses, 0);
+
+        list = new ListBuffer(DataSpace<DIM1>(getAreaSuperCells().productOfComponents()));
+        strideList = new ListBuffer(DataSpace<DIM1>(numStrideClasses * classCapacity));
+        reachableStrideList = new ListBuffer(DataSpace<DIM1>(numStrideClasses * classCapacity));
+        counter = new GridBuffer<uint32_t, DIM1>(DataSpace<DIM1>(1 + 2 * numStrideClasses));
+        numReachableInClass.resize(numStrideClasses, 0);
+    }
+
+    virtual ~ActiveSuperCells()
+    {
+        __delete(list);
+        __delete(strideList);
+        __delete(reachableStrideList);
+        __delete(counter);
+    }
+
+    /** search all supercells with particles and all reachable supercells
+     *
+     * blocks the host until the number of supercells is known
+     *
+     * @param pb device particle box
+     */
+    template<class T_ParBox>
+    void update(T_ParBox pb)
+    {
+        counter->getDeviceBuffer().setValue(0);
+
+        const DataSpace<Dim> areaSuperCells(getAreaSuperCells());
+        dim3 grid(std::ceil(double(areaSuperCells.productOfComponents()) / 256.));
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __cudaKernel_OPTI(kernelFindActiveSuperCells<256>)
+                (grid, 256)
+                (pb, areaSuperCells, cellDescription.getGuardingSuperCells(),
+                 list->getDeviceBuffer().getDataBox(), strideList->getDeviceBuffer().getDataBox(),
+                 reachableStrideList->getDeviceBuffer().getDataBox(),
+                 classCapacity, counter->getDeviceBuffer().getBasePointer());
+        }
+        else
+        {
+            __cudaKernel(kernelFindActiveSuperCells<>)
+                (grid, 256)
+                (pb, areaSuperCells, cellDescription.getGuardingSuperCells(),
+                 list->getDeviceBuffer().getDataBox(), strideList->getDeviceBuffer().getDataBox(),
+                 reachableStrideList->getDeviceBuffer().getDataBox(),
+                 classCapacity, counter->getDeviceBuffer().getBasePointer());
+        }
+
+        counter->deviceToHost();
+        numActive = counter->getHostBuffer().getDataBox()[0];
+        for (uint32_t c = 0; c < numStrideClasses; ++c)
+        {
+            numActiveInClass[c] = counter->getHostBuffer().getDataBox()[c + 1];
+            numReachableInClass[c] = counter->getHostBuffer().getDataBox()[c + 1 + numStrideClasses];
+        }
+    }
+
+    /** @return number of supercells with particles */
+    uint32_t getNumActive() const
+    {
+        return numActive;
+    }
+
+    /** @return number of stride classes (3^Dim) */
+    uint32_t getNumStrideClasses() const
+    {
+        return numStrideClasses;
+    }
+
+    /** mapping to all supercells with particles */
+    ListMapping getMapping() const
+    {
+        return ListMapping(cellDescription, list->getDeviceBuffer().getDataBox(), numActive);
+    }
+
+    /** mapping to the supercells with particles of one stride class
+     *
+     * The supercells of one class have a distance of at least three
+     * supercells (replacement for StrideMapping with stride 3).
+     * Kernels must be started for all classes one after the other.
+     *
+     * @param strideClass class index [0, getNumStrideClasses())
+     */
+    ListMapping getStrideMapping(uint32_t strideClass) const
+    {
+        return ListMapping(
+            cellDescription,
+            strideList->getDeviceBuffer().getDataBox().shift(DataSpace<DIM1>(strideClass * classCapacity)),
+            numActiveInClass[strideClass]);
+    }
+
+    /** mapping to the reachable supercells of one stride class
+     *
+     * Superset of getStrideMapping() which also covers the particles after
+     * they were moved by one push and exchanged with the neighbors.
+     *
+     * @param strideClass class index [0, getNumStrideClasses())
+     */
+    ListMapping getReachableStrideMapping(uint32_t strideClass) const
+    {
+        return ListMapping(
+            cellDescription,
+            reachableStrideList->getDeviceBuffer().getDataBox().shift(DataSpace<DIM1>(strideClass * classCapacity)),
+            numReachableInClass[strideClass]);
+    }
+
+private:
+
+    typedef GridBuffer<DataSpace<Dim>, DIM1> ListBuffer;
+
+    DataSpace<Dim> getAreaSuperCells() const
+    {
+        return cellDescription.getGridSuperCells() -
+            DataSpace<Dim>::create(2 * cellDescription.getGuardingSuperCells());
+    }
+
+    MappingDesc cellDescription;
+    ListBuffer* list;
+    ListBuffer* strideList;
+    ListBuffer* reachableStrideList;
+    GridBuffer<uint32_t, DIM1>* counter;
+    uint32_t numStrideClasses;
+    uint32_t classCapacity;
+    uint32_t numActive;
+    std::vector<uint32_t> numActiveInClass;
+    std::vector<uint32_t> numReachableInClass;
+};
+
+} // namespace PMacc
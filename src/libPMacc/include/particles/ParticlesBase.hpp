@@ -31,6 +31,7 @@
 #include "particles/memory/buffers/ParticlesBuffer.hpp"
 
 #include "mappings/kernel/StrideMapping.hpp"
+#include "particles/ActiveSuperCells.hpp"
 #include "traits/NumberOfExchanges.hpp"
 
 
@@ -80,11 +81,18 @@ protected:
 
     BufferType *particlesBuffer;
 
-    ParticlesBase(MappingDesc description) : SimulationFieldHelper<MappingDesc>(description), particlesBuffer(NULL)
+    /* supercells with particles in CORE+BORDER */
+    ActiveSuperCells<MappingDesc> *activeSuperCells;
+
+    ParticlesBase(MappingDesc description) : SimulationFieldHelper<MappingDesc>(description), particlesBuffer(NULL),
+    activeSuperCells(new ActiveSuperCells<MappingDesc>(description))
     {
     }
 
-    virtual ~ParticlesBase(){}
+    virtual ~ParticlesBase()
+    {
+        __delete(activeSuperCells);
+    }
 
     /* Shift all particle in a AREA
      * @tparam AREA area which is used (CORE,BORDER,GUARD or a combination)
@@ -131,6 +139,52 @@ protected:
 
     }
 
+    /* Shift all particles in the supercells with particles in CORE+BORDER
+     *
+     * Same as shiftParticles<CORE + BORDER>() but empty supercells are skipped.
+     * The active supercells must be up to date, see updateActiveSuperCells().
+     */
+    void shiftActiveParticles()
+    {
+        __startTransaction(__getTransactionEvent());
+
+        ParticlesBoxType pBox = particlesBuffer->getDeviceParticleBox();
+        for (uint32_t strideClass = 0; strideClass < activeSuperCells->getNumStrideClasses(); ++strideClass)
+        {
+            typename ActiveSuperCells<MappingDesc>::ListMapping mapper(activeSuperCells->getStrideMapping(strideClass));
+            if (mapper.getSize() == 0)
+                continue;
+
+            constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+            if(useElements)
+            {
+                __cudaKernel_OPTI(kernelShiftParticles<TileSize>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+                __cudaKernel_OPTI(kernelFillGaps<TileSize>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+                __cudaKernel_OPTI(kernelFillGapsLastFrame<TileSize>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+            }
+            else
+            {
+                __cudaKernel(kernelShiftParticles<>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+                __cudaKernel(kernelFillGaps<>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+                __cudaKernel(kernelFillGapsLastFrame<>)
+                    (mapper.getGridDim(), TileSize)
+                    (pBox, mapper);
+            }
+        }
+
+        __setTransactionEvent(__endTransaction());
+    }
+
     /* fill gaps in a AREA
      * @tparam AREA area which is used (CORE,BORDER,GUARD or a combination)
      */
@@ -165,6 +219,23 @@ protected:
 
 public:
 
+    /* Search all supercells with particles in CORE+BORDER
+     *
+     * Must be called before getActiveSuperCells() is used if particles
+     * were created in empty supercells (blocks the host).
+     */
+    void updateActiveSuperCells()
+    {
+        activeSuperCells->update(particlesBuffer->getDeviceParticleBox());
+    }
+
+    /* Get the supercells with particles found by the last updateActiveSuperCells()
+     */
+    const ActiveSuperCells<MappingDesc>& getActiveSuperCells() const
+    {
+        return *activeSuperCells;
+    }
+
     /* fill gaps in a the complete simulation area (include GUARD)
      */
     void fillAllGaps()
@@ -187,6 +258,12 @@ public:
     template<uint32_t T_area>
     void deleteParticlesInArea();
 
+    /* Count particles in a direction.
+     * The number of particles in the guard of a direction is stored in the
+     * device particle counter of the exchange (see ParticlesBuffer::getSendExchangeCounter)
+     */
+    void countExchangeParticles(uint32_t exchangeType);
+
     /* Bash particles in a direction.
      * Copy all particles from the guard of a direction to the device exchange buffer
      */
@@ -196,6 +273,17 @@ public:
      */
     void insertParticles(uint32_t exchangeType);
 
+    /* Move all supercells one position backwards in a direction.
+     *
+     * The particles of the first supercells in direction are moved to the GUARD
+     * and must be send to the neighbor with the next communication.
+     * The last supercells get the particles of the GUARD, therefore the GUARD
+     * must be empty (e.g. after a communication).
+     *
+     * @param direction 0 == x, 1 == y, 2 == z
+     */
+    void slideSuperCells(uint32_t direction);
+
     ParticlesBoxType getDeviceParticlesBox()
     {
         return particlesBuffer->getDeviceParticleBox();
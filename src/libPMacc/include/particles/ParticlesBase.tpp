@@ -84,6 +84,34 @@ namespace PMacc
         particlesBuffer->reset( );
     }
 
+    template<typename T_ParticleDescription, class MappingDesc>
+    void ParticlesBase<T_ParticleDescription, MappingDesc>::countExchangeParticles(uint32_t exchangeType)
+    {
+        if (particlesBuffer->hasSendExchange(exchangeType))
+        {
+            ExchangeMapping<GUARD, MappingDesc> mapper(this->cellDescription, exchangeType);
+
+            DeviceBuffer<vint_t, DIM1>& counter = particlesBuffer->getSendExchangeCounter(exchangeType);
+            counter.setValue(0);
+            dim3 grid(mapper.getGridDim());
+            constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+            if(useElements)
+            {
+                __cudaKernel_OPTI(kernelCountExchangeParticles<TileSize>)
+                        (grid, TileSize)
+                        (particlesBuffer->getDeviceParticleBox(),
+                        counter.getBasePointer(), mapper);
+            }
+            else
+            {
+                __cudaKernel(kernelCountExchangeParticles<>)
+                        (grid, TileSize)
+                        (particlesBuffer->getDeviceParticleBox(),
+                        counter.getBasePointer(), mapper);
+            }
+        }
+    }
+
     template<typename T_ParticleDescription, class MappingDesc>
     void ParticlesBase<T_ParticleDescription, MappingDesc>::bashParticles(uint32_t exchangeType)
     {
@@ -142,6 +170,32 @@ namespace PMacc
         }
     }
 
+    template<typename T_ParticleDescription, class MappingDesc>
+    void ParticlesBase<T_ParticleDescription, MappingDesc>::slideSuperCells(uint32_t direction)
+    {
+        const DataSpace<Dim> gridSuperCells(this->cellDescription.getGridSuperCells());
+
+        DataSpace<Dim> columns(gridSuperCells);
+        columns[direction] = 1;
+
+        /* one thread per column of supercells in direction */
+        dim3 grid(ceil(double(columns.productOfComponents()) / 256.));
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __cudaKernel_OPTI(kernelSlideSuperCells<256>)
+                    (grid, 256)
+                    (particlesBuffer->getDeviceParticleBox(), gridSuperCells, direction);
+        }
+        else
+        {
+            __cudaKernel(kernelSlideSuperCells<>)
+                    (grid, 256)
+                    (particlesBuffer->getDeviceParticleBox(), gridSuperCells, direction);
+        }
+    }
+
 } //namespace PMacc
 
 #include "particles/AsyncCommunicationImpl.hpp"
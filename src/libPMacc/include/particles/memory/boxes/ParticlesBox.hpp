@@ -24,6 +24,8 @@
 #pragma once
 #if (PMACC_CUDA_ENABLED == 1)
 #include <mallocMC/mallocMC.hpp>
+#else
+#include "particles/memory/buffers/HostFrameHeap.hpp"
 #endif
 #include "particles/frame_types.hpp"
 #include "dimensions/DataSpace.hpp"
@@ -89,8 +91,10 @@ public:
         {
 #if (PMACC_CUDA_ENABLED == 1) && defined(__CUDA_ARCH__)
             tmp = (FrameType*) mallocMC::malloc( sizeof (FrameType) );
-#else
+#elif (PMACC_CUDA_ENABLED == 1)
             tmp = (FrameType*) malloc( sizeof (FrameType) );
+#else
+            tmp = (FrameType*) HostFrameHeap::getInstance( ).malloc( sizeof (FrameType) );
 #endif
             if ( tmp != NULL )
             {
@@ -125,8 +129,10 @@ public:
     {
 #if (PMACC_CUDA_ENABLED == 1) && defined(__CUDA_ARCH__)
         mallocMC::free( (void*) frame.ptr );
-#else
+#elif (PMACC_CUDA_ENABLED == 1)
         free( (void*) frame.ptr );
+#else
+        HostFrameHeap::getInstance( ).free( (void*) frame.ptr );
 #endif
         frame.ptr = NULL;
     }
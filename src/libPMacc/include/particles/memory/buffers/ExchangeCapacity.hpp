@@ -0,0 +1,98 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+namespace PMacc
+{
+
+/**
+ * Capacity of a runtime adaptive particle exchange stack.
+ *
+ * The high-water mark follows the maximum of the transferred particles
+ * and decays by one percent per transfer.
+ * A stack grows by 50% headroom over the required size and shrinks to twice the
+ * high-water mark if it is more than four times larger, the gap between both
+ * thresholds avoids reallocation for fluctuating particle numbers.
+ * The capacity never leaves [minCapacity, maxCapacity], transfers with more
+ * particles than maxCapacity are split into several rounds.
+ */
+class ExchangeCapacity
+{
+public:
+
+    ExchangeCapacity() : minCapacity(0), maxCapacity(0), highWaterMark(0.0)
+    {
+    }
+
+    /**
+     * @param minCapacity smallest number of particles of the stack
+     * @param maxCapacity largest number of particles of the stack
+     */
+    ExchangeCapacity(size_t minCapacity, size_t maxCapacity) :
+    minCapacity(minCapacity), maxCapacity(std::max(minCapacity, maxCapacity)), highWaterMark(0.0)
+    {
+    }
+
+    /**
+     * Calculates the capacity of the stack for the next transfer.
+     *
+     * @param capacity current number of particles which fit into the stack
+     * @param numParticles number of particles of the next transfer
+     * @return new number of particles which fit into the stack
+     */
+    size_t adapt(size_t capacity, size_t numParticles)
+    {
+        highWaterMark = std::max(double(numParticles), 0.99 * highWaterMark);
+
+        if (numParticles > capacity)
+            return std::max(std::min(numParticles + numParticles / 2, maxCapacity), capacity);
+
+        if (capacity > minCapacity && double(capacity) > 4.0 * highWaterMark)
+            return std::max(size_t(2.0 * highWaterMark), minCapacity);
+
+        return capacity;
+    }
+
+    /** @return moving high-water mark of the transferred particles */
+    double getHighWaterMark() const
+    {
+        return highWaterMark;
+    }
+
+    /** @return largest number of particles of the stack */
+    size_t getMaxCapacity() const
+    {
+        return maxCapacity;
+    }
+
+private:
+
+    size_t minCapacity;
+    size_t maxCapacity;
+    double highWaterMark;
+};
+
+} // namespace PMacc
@@ -0,0 +1,536 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace PMacc
+{
+
+/** frame heap for host accelerators
+ *
+ * Replaces `malloc`/`free` in ParticlesBox::getEmptyFrame and
+ * ParticlesBox::removeFrame if PMacc is not compiled for CUDA (there
+ * mallocMC is used). The heap is one reservation of `heapSize` bytes which
+ * is split into chunks of `chunkSize` bytes. Each chunk serves slots of exactly
+ * one size (one slot class per frame type).
+ *
+ * - each worker thread owns a private free list and a private chunk per slot
+ *   class, the fast path of malloc/free is free of any synchronization
+ * - a chunk is first touched by the worker which carves slots out of it,
+ *   therefore the pages are placed in the NUMA domain of this worker
+ *   (first-touch policy)
+ * - if a private free list exceeds `maxCachedSlots` the whole list is handed
+ *   back as one batch to a global lock-free stack of the slot class, an empty
+ *   worker takes over one batch (the stack head is tagged to avoid the
+ *   ABA problem)
+ *
+ * Requests which can not be served from the heap (heap not initialized,
+ * slot too large, too many slot classes) fall back to `std::malloc`, these
+ * rare allocations are registered to be told apart from slots of a
+ * released heap.
+ */
+class HostFrameHeap
+{
+public:
+
+    /** size of a chunk in bytes (and alignment of the heap) */
+    static const size_t chunkSize = 4u * 1024u * 1024u;
+    /** slot sizes are rounded up to a multiple of this value (cache line) */
+    static const size_t slotAlignment = 64u;
+    /** maximal number of different slot sizes */
+    static const uint32_t maxSlotClasses = 32u;
+    /** number of slots a worker keeps before they are moved to the global list */
+    static const uint32_t maxCachedSlots = 1024u;
+
+    /** allocation statistics
+     *
+     * The number of free slots in the global lists is only approximate
+     * because slots which are cached by a worker are not visible.
+     */
+    struct Statistics
+    {
+        size_t heapSize;
+        size_t numChunks;
+        size_t numUsedChunks;
+        size_t numGlobalFreeSlots;
+        uint32_t numSlotClasses;
+        uint64_t numFailedAllocations;
+    };
+
+    static HostFrameHeap& getInstance()
+    {
+        static HostFrameHeap instance;
+        return instance;
+    }
+
+    /** reserve the heap memory
+     *
+     * The memory is not touched, pages are mapped by the workers.
+     *
+     * @param heapSize size of the heap in bytes
+     */
+    void init(size_t heapSize)
+    {
+        finalize();
+
+        if (heapSize < chunkSize)
+        {
+            std::stringstream msg;
+            msg << "HostFrameHeap: heap size of " << heapSize
+                << " byte is smaller than one chunk (" << chunkSize << " byte)";
+            throw std::runtime_error(msg.str());
+        }
+
+        reservation = static_cast<char*>(std::malloc(heapSize + chunkSize));
+        if (reservation == NULL)
+            throw std::runtime_error("HostFrameHeap: can not reserve heap memory");
+
+        /* align the heap to the chunk size to find the chunk header of a slot */
+        const size_t misalignment = reinterpret_cast<size_t>(reservation) % chunkSize;
+        heapBegin = reservation + (misalignment == 0 ? 0 : chunkSize - misalignment);
+        numChunks = heapSize / chunkSize;
+        heapEnd = heapBegin + numChunks * chunkSize;
+        this->heapSize = heapSize;
+
+        nextChunk.store(0);
+        numFailedAllocations.store(0);
+        for (uint32_t i = 0; i < maxSlotClasses; ++i)
+        {
+            slotClasses[i].slotSize = 0;
+            slotClasses[i].batchStack.store(0);
+            slotClasses[i].numFreeSlots.store(0);
+        }
+        numSlotClasses.store(0);
+
+        /* invalidate all worker caches of a previous heap */
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    /** release the heap memory
+     *
+     * All frames allocated from the heap are invalid after this call.
+     * Frames of the released heap which are freed later (e.g. by destructors
+     * running after the finalization) are ignored.
+     */
+    void finalize()
+    {
+        if (reservation != NULL)
+        {
+            std::free(reservation);
+            reservation = NULL;
+            heapBegin = NULL;
+            heapEnd = NULL;
+            numChunks = 0;
+            heapSize = 0;
+            generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    bool isInitialized() const
+    {
+        return reservation != NULL;
+    }
+
+    /** allocate a slot
+     *
+     * @param size size in bytes
+     * @return pointer to the memory, NULL if the heap is exhausted
+     */
+    void* malloc(size_t size)
+    {
+        const size_t slotSize = roundUp(size);
+        if (!isInitialized() || slotSize > chunkSize - slotAlignment)
+            return fallbackMalloc(size);
+
+        const int32_t slotClass = getSlotClass(slotSize);
+        if (slotClass < 0)
+            return fallbackMalloc(size);
+
+        ThreadCache& cache = getThreadCache();
+
+        /* 1. private free list
+         * 2. a batch of slots freed by other workers
+         */
+        if (cache.head[slotClass] == NULL)
+            popGlobalBatch(cache, slotClass);
+        if (cache.head[slotClass] != NULL)
+            return popThreadSlot(cache, slotClass);
+
+        /* 3. carve a slot out of the private chunk */
+        if (cache.chunkCursor[slotClass] == NULL ||
+            cache.chunkCursor[slotClass] + slotSize > cache.chunkEnd[slotClass])
+        {
+            char* chunk = getEmptyChunk(static_cast<uint32_t>(slotClass));
+            if (chunk == NULL)
+            {
+                /* 4. heap is exhausted, retry batches released in the meantime */
+                popGlobalBatch(cache, slotClass);
+                if (cache.head[slotClass] != NULL)
+                    return popThreadSlot(cache, slotClass);
+
+                ++numFailedAllocations;
+                return NULL;
+            }
+            cache.chunkCursor[slotClass] = chunk + slotAlignment;
+            cache.chunkEnd[slotClass] = chunk + chunkSize;
+        }
+        void* result = cache.chunkCursor[slotClass];
+        cache.chunkCursor[slotClass] += slotSize;
+        return result;
+    }
+
+    /** free a slot
+     *
+     * @param ptr pointer returned by malloc(), NULL is allowed
+     */
+    void free(void* ptr)
+    {
+        if (ptr == NULL)
+            return;
+
+        char* charPtr = static_cast<char*>(ptr);
+        if (charPtr < heapBegin || charPtr >= heapEnd)
+        {
+            /* slot was allocated with the std::malloc fallback, else it is a
+             * slot of an already released heap and the memory is gone */
+            fallbackFree(ptr);
+            return;
+        }
+
+        const size_t chunkIdx = static_cast<size_t>(charPtr - heapBegin) / chunkSize;
+        const ChunkHeader* header = reinterpret_cast<ChunkHeader*>(heapBegin + chunkIdx * chunkSize);
+        const uint32_t slotClass = header->slotClass;
+
+        ThreadCache& cache = getThreadCache();
+
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = cache.head[slotClass];
+        if (cache.head[slotClass] == NULL)
+            cache.tail[slotClass] = slot;
+        cache.head[slotClass] = slot;
+        ++cache.numSlots[slotClass];
+
+        if (cache.numSlots[slotClass] > maxCachedSlots)
+            pushGlobalBatch(cache, slotClass);
+    }
+
+    /** get the number of slots of a given size which can still be allocated
+     *
+     * The result is approximate, slots cached by workers are not counted.
+     *
+     * @param size slot size in bytes
+     */
+    size_t getAvailableSlots(size_t size) const
+    {
+        const size_t slotSize = roundUp(size);
+        if (!isInitialized() || slotSize > chunkSize - slotAlignment)
+            return 0;
+
+        const size_t slotsPerChunk = (chunkSize - slotAlignment) / slotSize;
+        size_t result = (numChunks - getNumUsedChunks()) * slotsPerChunk;
+
+        const uint32_t numClasses = numSlotClasses.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < numClasses; ++i)
+            if (slotClasses[i].slotSize == slotSize)
+                result += slotClasses[i].numFreeSlots.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    Statistics getStatistics() const
+    {
+        Statistics stats;
+        stats.heapSize = heapSize;
+        stats.numChunks = numChunks;
+        stats.numUsedChunks = getNumUsedChunks();
+        stats.numSlotClasses = numSlotClasses.load(std::memory_order_acquire);
+        stats.numGlobalFreeSlots = 0;
+        for (uint32_t i = 0; i < stats.numSlotClasses; ++i)
+            stats.numGlobalFreeSlots += slotClasses[i].numFreeSlots.load(std::memory_order_relaxed);
+        stats.numFailedAllocations = numFailedAllocations.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+
+    /** free slots are linked via their first bytes
+     *
+     * The first slot of a batch in the global stack additionally stores
+     * the link to the next batch and the number of slots in the batch.
+     */
+    struct FreeSlot
+    {
+        FreeSlot* next;
+        uint64_t nextBatch;
+        uint32_t numSlots;
+    };
+
+    /** bits of a tagged stack head used for the slot index, the rest is the tag */
+    static const uint32_t indexBits = 40u;
+
+    /** stored in the first `slotAlignment` bytes of each chunk */
+    struct ChunkHeader
+    {
+        uint32_t slotClass;
+    };
+
+    struct SlotClass
+    {
+        size_t slotSize;
+        /** tagged head of the batch stack, index 0 is an empty stack */
+        std::atomic<uint64_t> batchStack;
+        std::atomic<size_t> numFreeSlots;
+    };
+
+    /** private state of one worker thread */
+    struct ThreadCache
+    {
+        uint64_t generation;
+        FreeSlot* head[maxSlotClasses];
+        FreeSlot* tail[maxSlotClasses];
+        uint32_t numSlots[maxSlotClasses];
+        char* chunkCursor[maxSlotClasses];
+        char* chunkEnd[maxSlotClasses];
+
+        void reset(uint64_t newGeneration)
+        {
+            generation = newGeneration;
+            for (uint32_t i = 0; i < maxSlotClasses; ++i)
+            {
+                head[i] = NULL;
+                tail[i] = NULL;
+                numSlots[i] = 0;
+                chunkCursor[i] = NULL;
+                chunkEnd[i] = NULL;
+            }
+        }
+    };
+
+    /** allocate with std::malloc and register the pointer */
+    void* fallbackMalloc(size_t size)
+    {
+        void* ptr = std::malloc(size);
+        if (ptr != NULL)
+        {
+            std::lock_guard<std::mutex> lock(fallbackMutex);
+            fallbackSlots.insert(ptr);
+        }
+        return ptr;
+    }
+
+    /** free a pointer if it was allocated by fallbackMalloc()
+     *
+     * @return true if the pointer was registered and is released
+     */
+    bool fallbackFree(void* ptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(fallbackMutex);
+            if (fallbackSlots.erase(ptr) == 0)
+                return false;
+        }
+        std::free(ptr);
+        return true;
+    }
+
+    static size_t roundUp(size_t size)
+    {
+        return ((size + slotAlignment - 1) / slotAlignment) * slotAlignment;
+    }
+
+    ThreadCache& getThreadCache()
+    {
+        /* a worker which leaves keeps its cached slots, accelerator
+         * worker threads live as long as the simulation
+         */
+        static thread_local ThreadCache cache = {0};
+        const uint64_t currentGeneration = generation.load(std::memory_order_acquire);
+        if (cache.generation != currentGeneration)
+            cache.reset(currentGeneration);
+        return cache;
+    }
+
+    /** get the index of the slot class, register the class if needed
+     *
+     * @return index of the slot class, -1 if all classes are in use
+     */
+    int32_t getSlotClass(size_t slotSize)
+    {
+        uint32_t numClasses = numSlotClasses.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < numClasses; ++i)
+            if (slotClasses[i].slotSize == slotSize)
+                return static_cast<int32_t>(i);
+
+        /* new frame types are rare, only happens once per species */
+        std::lock_guard<std::mutex> lock(registerMutex);
+        numClasses = numSlotClasses.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < numClasses; ++i)
+            if (slotClasses[i].slotSize == slotSize)
+                return static_cast<int32_t>(i);
+
+        if (numClasses == maxSlotClasses)
+            return -1;
+
+        slotClasses[numClasses].slotSize = slotSize;
+        numSlotClasses.store(numClasses + 1, std::memory_order_release);
+        return static_cast<int32_t>(numClasses);
+    }
+
+    size_t getNumUsedChunks() const
+    {
+        const size_t used = nextChunk.load(std::memory_order_relaxed);
+        return used < numChunks ? used : numChunks;
+    }
+
+    /** @return pointer to an unused chunk, NULL if the heap is exhausted */
+    char* getEmptyChunk(uint32_t slotClass)
+    {
+        const size_t chunkIdx = nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunkIdx >= numChunks)
+            return NULL;
+
+        char* chunk = heapBegin + chunkIdx * chunkSize;
+        reinterpret_cast<ChunkHeader*>(chunk)->slotClass = slotClass;
+        return chunk;
+    }
+
+    /** encode a slot pointer and a tag to a stack head */
+    uint64_t encode(FreeSlot* slot, uint64_t tag) const
+    {
+        const uint64_t idx = slot == NULL ?
+            0 : static_cast<uint64_t>(reinterpret_cast<char*>(slot) - heapBegin) / slotAlignment + 1u;
+        return idx | (tag << indexBits);
+    }
+
+    FreeSlot* decode(uint64_t head) const
+    {
+        const uint64_t idx = head & ((uint64_t(1) << indexBits) - 1u);
+        return idx == 0 ? NULL : reinterpret_cast<FreeSlot*>(heapBegin + (idx - 1u) * slotAlignment);
+    }
+
+    FreeSlot* popThreadSlot(ThreadCache& cache, int32_t slotClass)
+    {
+        FreeSlot* slot = cache.head[slotClass];
+        cache.head[slotClass] = slot->next;
+        if (slot->next == NULL)
+            cache.tail[slotClass] = NULL;
+        --cache.numSlots[slotClass];
+        return slot;
+    }
+
+    /** move one batch of the global stack into the (empty) worker cache */
+    void popGlobalBatch(ThreadCache& cache, int32_t slotClass)
+    {
+        SlotClass& sc = slotClasses[slotClass];
+        uint64_t oldHead = sc.batchStack.load(std::memory_order_acquire);
+        FreeSlot* batch;
+        do
+        {
+            batch = decode(oldHead);
+            if (batch == NULL)
+                return;
+            /* `batch` may already be reused by another worker, the value read
+             * here is discarded because the tag of the head has changed
+             */
+        }
+        while (!sc.batchStack.compare_exchange_weak(oldHead,
+                                                    batch->nextBatch | ((oldHead >> indexBits) + 1u) << indexBits,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_acquire));
+
+        sc.numFreeSlots.fetch_sub(batch->numSlots, std::memory_order_relaxed);
+
+        FreeSlot* tail = batch;
+        while (tail->next != NULL)
+            tail = tail->next;
+
+        cache.head[slotClass] = batch;
+        cache.tail[slotClass] = tail;
+        cache.numSlots[slotClass] = batch->numSlots;
+    }
+
+    /** move all slots of the worker cache as one batch to the global stack */
+    void pushGlobalBatch(ThreadCache& cache, uint32_t slotClass)
+    {
+        SlotClass& sc = slotClasses[slotClass];
+        FreeSlot* batch = cache.head[slotClass];
+        batch->numSlots = cache.numSlots[slotClass];
+
+        uint64_t oldHead = sc.batchStack.load(std::memory_order_relaxed);
+        do
+        {
+            batch->nextBatch = oldHead & ((uint64_t(1) << indexBits) - 1u);
+        }
+        while (!sc.batchStack.compare_exchange_weak(oldHead,
+                                                    encode(batch, (oldHead >> indexBits) + 1u),
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+        sc.numFreeSlots.fetch_add(cache.numSlots[slotClass], std::memory_order_relaxed);
+
+        cache.head[slotClass] = NULL;
+        cache.tail[slotClass] = NULL;
+        cache.numSlots[slotClass] = 0;
+    }
+
+    HostFrameHeap() :
+    reservation(NULL), heapBegin(NULL), heapEnd(NULL), heapSize(0), numChunks(0)
+    {
+        generation.store(1);
+        nextChunk.store(0);
+        numSlotClasses.store(0);
+        numFailedAllocations.store(0);
+    }
+
+    ~HostFrameHeap()
+    {
+        finalize();
+    }
+
+    HostFrameHeap(const HostFrameHeap&);
+    HostFrameHeap& operator=(const HostFrameHeap&);
+
+    char* reservation;
+    char* heapBegin;
+    char* heapEnd;
+    size_t heapSize;
+    size_t numChunks;
+    /** incremented on each init/finalize to invalidate the worker caches */
+    std::atomic<uint64_t> generation;
+
+    std::atomic<size_t> nextChunk;
+    std::atomic<uint32_t> numSlotClasses;
+    std::atomic<uint64_t> numFailedAllocations;
+    SlotClass slotClasses[maxSlotClasses];
+    std::mutex registerMutex;
+    /** pointers of all living std::malloc fallback allocations */
+    std::unordered_set<void*> fallbackSlots;
+    std::mutex fallbackMutex;
+};
+
+} //namespace PMacc
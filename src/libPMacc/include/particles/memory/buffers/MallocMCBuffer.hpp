@@ -23,14 +23,24 @@
 #pragma once
 
 
+#include "pmacc_types.hpp"
 #include "dataManagement/ISimulationData.hpp"
 
+#if (PMACC_CUDA_ENABLED == 1)
 #include "mallocMC/mallocMC.hpp"
+#else
+#include "particles/memory/buffers/HostFrameHeap.hpp"
+#endif
 #include <string>
 
 namespace PMacc
 {
 
+    /** host side view of the frame heap
+     *
+     * For CUDA the mallocMC heap is copied to the host, for host accelerators
+     * the HostFrameHeap is used directly (no copy, offset is zero).
+     */
     class MallocMCBuffer : public ISimulationData
     {
     public:
@@ -56,11 +66,19 @@ namespace PMacc
 
         void synchronize();
 
+        /** number of slots with `slotSize` bytes which can still be allocated */
+        size_t getAvailableSlots(size_t slotSize);
+
+        /** size of the frame heap in bytes */
+        size_t getHeapSize();
+
     private:
 
         char* hostPtr;
         int64_t hostBufferOffset;
+#if (PMACC_CUDA_ENABLED == 1)
         mallocMC::HeapInfo deviceHeapInfo;
+#endif
 
     };
 
@@ -32,22 +32,45 @@ namespace PMacc
 
 MallocMCBuffer::MallocMCBuffer( ) : hostPtr( NULL ),hostBufferOffset(0)
 {
+#if (PMACC_CUDA_ENABLED == 1)
     /* currently mallocMC has only one heap */
     this->deviceHeapInfo=mallocMC::getHeapLocations()[0];
+#endif
     Environment<>::get().DataConnector().registerData( *this);
 }
 
 MallocMCBuffer::~MallocMCBuffer( )
 {
+#if (PMACC_CUDA_ENABLED == 1)
     if ( hostPtr != NULL )
         cudaHostUnregister(hostPtr);
+#endif
 
     __deleteArray(hostPtr);
 
 }
 
+size_t MallocMCBuffer::getAvailableSlots( size_t slotSize )
+{
+#if (PMACC_CUDA_ENABLED == 1)
+    return mallocMC::getAvailableSlots( slotSize );
+#else
+    return HostFrameHeap::getInstance( ).getAvailableSlots( slotSize );
+#endif
+}
+
+size_t MallocMCBuffer::getHeapSize( )
+{
+#if (PMACC_CUDA_ENABLED == 1)
+    return deviceHeapInfo.size;
+#else
+    return HostFrameHeap::getInstance( ).getStatistics( ).heapSize;
+#endif
+}
+
 void MallocMCBuffer::synchronize( )
 {
+#if (PMACC_CUDA_ENABLED == 1)
     /** \todo: we had no abstraction to create a host buffer and a pseudo
      *         device buffer (out of the mallocMC ptr) and copy both with our event
      *         system.
@@ -68,6 +91,13 @@ void MallocMCBuffer::synchronize( )
     __startOperation(ITask::TASK_CUDA);
     __startOperation(ITask::TASK_HOST);
     CUDA_CHECK(cudaMemcpy(hostPtr, deviceHeapInfo.p, deviceHeapInfo.size, cudaMemcpyDeviceToHost));
+#else
+    /* frames of host accelerators are already in host memory, only wait
+     * until all kernels which can modify the frames are finished
+     */
+    __startOperation(ITask::TASK_CUDA);
+    __startOperation(ITask::TASK_HOST);
+#endif
 
 }
 
@@ -28,11 +28,14 @@
 #include "dimensions/GridLayout.hpp"
 #include "memory/dataTypes/Mask.hpp"
 #include "particles/memory/buffers/StackExchangeBuffer.hpp"
+#include "particles/memory/buffers/ExchangeCapacity.hpp"
 #include "eventSystem/EventSystem.hpp"
 #include "particles/memory/dataTypes/SuperCell.hpp"
 
 #include "math/Vector.hpp"
 
+#include <algorithm>
+
 #include "particles/boostExtension/InheritGenerators.hpp"
 #include "compileTime/conversion/MakeSeq.hpp"
 
@@ -149,6 +152,7 @@ public:
 
         exchangeMemoryIndexer = new GridBuffer<PopPushType, DIM1 > (DataSpace<DIM1 > (0));
         framesExchanges = new GridBuffer< ParticleType, DIM1, ParticleTypeBorder > (DataSpace<DIM1 > (0));
+        exchangeParticlesCounter = new GridBuffer<vint_t, DIM1 > (DataSpace<DIM1 > (0));
 
         //std::cout << "size: " << sizeof (ParticleType) << " " << sizeof (ParticleTypeBorder) << std::endl;
         DataSpace<DIM> superCellsCount = gridSize / superCellSize;
@@ -170,6 +174,7 @@ public:
         __delete(superCells);
         __delete(framesExchanges);
         __delete(exchangeMemoryIndexer);
+        __delete(exchangeParticlesCounter);
     }
 
     /**
@@ -185,17 +190,37 @@ public:
     /**
      * Adds an exchange buffer to frames.
      *
+     * The exchange stacks are resized before each transfer to fit the number
+     * of transferred particles (see adaptSendExchange, adaptReceiveExchange),
+     * usedMemory is only the initial size. Transfers with more particles than
+     * fit into maxMemory are split into several rounds.
+     *
      * @param receive Mask describing receive directions
-     * @param usedMemory memory to be used for this exchange
+     * @param usedMemory initial memory to be used for this exchange
+     * @param communicationTag tag of the exchange
+     * @param maxMemory memory an exchange stack may grow to (at least usedMemory)
      */
-    void addExchange(Mask receive, size_t usedMemory, uint32_t communicationTag)
+    void addExchange(Mask receive, size_t usedMemory, uint32_t communicationTag, size_t maxMemory)
     {
 
-        size_t numBorderFrames = usedMemory / SizeOfOneBorderElement;
+        size_t numBorderFrames = std::max(usedMemory / SizeOfOneBorderElement, getMinExchangeCapacity());
+        const size_t maxBorderFrames = std::max(maxMemory / SizeOfOneBorderElement, numBorderFrames);
+
+        for (uint32_t ex = 1; ex < 27; ++ex)
+        {
+            if (receive.isSet(ex))
+            {
+                /* send and receive stacks of opposite directions have the same limit */
+                receiveCapacity[ex] = ExchangeCapacity(getMinExchangeCapacity(), maxBorderFrames);
+                sendCapacity[Mask::getMirroredExchangeType(ex)] = ExchangeCapacity(getMinExchangeCapacity(), maxBorderFrames);
+            }
+        }
 
         framesExchanges->addExchangeBuffer(receive, DataSpace<DIM1 > (numBorderFrames), communicationTag, true, false);
 
         exchangeMemoryIndexer->addExchangeBuffer(receive, DataSpace<DIM1 > (numBorderFrames), communicationTag | (1u << (20 - 5)), true, false);
+
+        exchangeParticlesCounter->addExchangeBuffer(receive, DataSpace<DIM1 > (1), communicationTag | (2u << (20 - 5)), false, false);
     }
 
     /**
@@ -262,6 +287,90 @@ public:
             (framesExchanges->getReceiveExchange(ex), exchangeMemoryIndexer->getReceiveExchange(ex));
     }
 
+    /**
+     * Returns the device buffer holding the number of particles to send in ex direction.
+     *
+     * The buffer has one element and is filled by ParticlesBase::countExchangeParticles().
+     *
+     * @param ex direction to query
+     * @return device buffer of the particle counter
+     */
+    DeviceBuffer<vint_t, DIM1>& getSendExchangeCounter(uint32_t ex)
+    {
+
+        return exchangeParticlesCounter->getSendExchange(ex).getDeviceBuffer();
+    }
+
+    /**
+     * Returns the number of particles of the last sent particle counter in ex direction.
+     *
+     * Valid after the transfer started with asyncSendParticlesCount() is finished.
+     *
+     * @param ex direction to query
+     * @return number of particles
+     */
+    size_t getSendParticlesCount(uint32_t ex)
+    {
+
+        return *(exchangeParticlesCounter->getSendExchange(ex).getHostBuffer().getBasePointer());
+    }
+
+    /**
+     * Returns the number of particles of the last received particle counter in ex direction.
+     *
+     * Valid after the transfer started with asyncReceiveParticlesCount() is finished.
+     *
+     * @param ex direction to query
+     * @return number of particles
+     */
+    size_t getReceiveParticlesCount(uint32_t ex)
+    {
+
+        return *(exchangeParticlesCounter->getReceiveExchange(ex).getHostBuffer().getBasePointer());
+    }
+
+    /**
+     * Resizes the send stack of direction ex to fit numParticles particles.
+     *
+     * The stack grows if the particles do not fit and shrinks if it is
+     * much larger than the moving high-water mark of the last transfers
+     * (see ExchangeCapacity). If the particles do not fit into the largest
+     * stack, the transfer needs several rounds.
+     * The content of the stack is lost if its size is changed.
+     *
+     * @param ex direction of the send stack
+     * @param numParticles number of particles of the next transfer
+     */
+    void adaptSendExchange(uint32_t ex, size_t numParticles)
+    {
+        const size_t capacity = getSendExchangeStack(ex).getMaxParticlesCount();
+        const size_t newCapacity = sendCapacity[ex].adapt(capacity, numParticles);
+        if (newCapacity != capacity)
+        {
+            framesExchanges->resizeSendExchange(ex, DataSpace<DIM1 > (newCapacity));
+            exchangeMemoryIndexer->resizeSendExchange(ex, DataSpace<DIM1 > (newCapacity));
+        }
+    }
+
+    /**
+     * Resizes the receive stack of direction ex to fit numParticles particles.
+     *
+     * @see adaptSendExchange
+     *
+     * @param ex direction of the receive stack
+     * @param numParticles number of particles of the next transfer
+     */
+    void adaptReceiveExchange(uint32_t ex, size_t numParticles)
+    {
+        const size_t capacity = getReceiveExchangeStack(ex).getMaxParticlesCount();
+        const size_t newCapacity = receiveCapacity[ex].adapt(capacity, numParticles);
+        if (newCapacity != capacity)
+        {
+            framesExchanges->resizeReceiveExchange(ex, DataSpace<DIM1 > (newCapacity));
+            exchangeMemoryIndexer->resizeReceiveExchange(ex, DataSpace<DIM1 > (newCapacity));
+        }
+    }
+
     /**
      * Starts sync data from own device buffer to neighbor device buffer.
      *
@@ -293,6 +402,28 @@ public:
             exchangeMemoryIndexer->asyncReceive(serialEvent, ex);
     }
 
+    /**
+     * Starts sending the particle counter of direction ex to the neighbor.
+     *
+     * @see getSendExchangeCounter
+     */
+    EventTask asyncSendParticlesCount(EventTask serialEvent, uint32_t ex)
+    {
+
+        return exchangeParticlesCounter->asyncSend(serialEvent, ex);
+    }
+
+    /**
+     * Starts receiving the particle counter of direction ex from the neighbor.
+     *
+     * @see getReceiveParticlesCount
+     */
+    EventTask asyncReceiveParticlesCount(EventTask serialEvent, uint32_t ex)
+    {
+
+        return exchangeParticlesCounter->asyncReceive(serialEvent, ex);
+    }
+
     /**
      * Returns number of supercells in each dimension.
      *
@@ -335,11 +466,24 @@ public:
 
 
 private:
+
+    /** smallest capacity of an exchange stack (number of particles of one frame) */
+    static size_t getMinExchangeCapacity()
+    {
+        return math::CT::volume<SuperCellSize>::type::value;
+    }
+
     GridBuffer<PopPushType, DIM1> *exchangeMemoryIndexer;
 
     GridBuffer<SuperCellType, DIM> *superCells;
     /*GridBuffer for hold borderFrames, we need a own buffer to create first exchanges without core memory*/
     GridBuffer< ParticleType, DIM1, ParticleTypeBorder> *framesExchanges;
+    /*GridBuffer to send the number of particles of an exchange before the particles*/
+    GridBuffer<vint_t, DIM1> *exchangeParticlesCounter;
+
+    /*capacity limits and moving high-water marks per exchange direction*/
+    ExchangeCapacity sendCapacity[27];
+    ExchangeCapacity receiveCapacity[27];
 
     DataSpace<DIM> superCellSize;
     DataSpace<DIM> gridSize;
@@ -123,27 +123,23 @@ struct CountParticles
 {
 
     /** Get particle count
-     *
-     * @tparam AREA area were particles are counted (CORE, BORDER, GUARD)
      *
      * @param buffer source particle buffer
-     * @param cellDescription instance of MappingDesction
+     * @param mapper mapper which describes the supercells were particles are counted
      * @param filter filter instance which must inharid from PositionFilter
-     * @return number of particles in defined area
+     * @return number of particles in the supercells of the mapper
      */
-    template<uint32_t AREA, class PBuffer, class Filter, class CellDesc>
-    static uint64_cu countOnDevice(PBuffer& buffer, CellDesc cellDescription, Filter filter)
+    template<class PBuffer, class Filter, class T_Mapping>
+    static uint64_cu countInMapping(PBuffer& buffer, const T_Mapping& mapper, Filter filter)
     {
         GridBuffer<uint64_cu, DIM1> counter(DataSpace<DIM1>(1));
 
-        dim3 block(CellDesc::SuperCellSize::toRT().toDim3());
-
-        AreaMapping<AREA, CellDesc> mapper(cellDescription);
+        dim3 block(T_Mapping::SuperCellSize::toRT().toDim3());
 
         constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
         if(useElements)
         {
-            using ElemSize = typename  CellDesc::SuperCellSize;
+            using ElemSize = typename T_Mapping::SuperCellSize;
             __cudaKernel_OPTI(kernelCountParticles<ElemSize>)
                 (mapper.getGridDim(), block)
                 (buffer.getDeviceParticlesBox(),
@@ -153,7 +149,7 @@ struct CountParticles
         }
         else
         {
-            using ElemSize = typename PMacc::math::CT::make_Int<CellDesc::Dim,1>::type::vector_type;
+            using ElemSize = typename PMacc::math::CT::make_Int<T_Mapping::Dim,1>::type::vector_type;
             __cudaKernel(kernelCountParticles<ElemSize>)
                 (mapper.getGridDim(), block)
                 (buffer.getDeviceParticlesBox(),
@@ -166,6 +162,22 @@ struct CountParticles
         return *(counter.getHostBuffer().getDataBox());
     }
 
+    /** Get particle count
+     *
+     * @tparam AREA area were particles are counted (CORE, BORDER, GUARD)
+     *
+     * @param buffer source particle buffer
+     * @param cellDescription instance of MappingDesction
+     * @param filter filter instance which must inharid from PositionFilter
+     * @return number of particles in defined area
+     */
+    template<uint32_t AREA, class PBuffer, class Filter, class CellDesc>
+    static uint64_cu countOnDevice(PBuffer& buffer, CellDesc cellDescription, Filter filter)
+    {
+        AreaMapping<AREA, CellDesc> mapper(cellDescription);
+        return countInMapping(buffer, mapper, filter);
+    }
+
     /** Get particle count
      *
      * @param buffer source particle buffer
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "math/Vector.hpp"
+#include "algorithms/math.hpp"
+
+namespace PMacc
+{
+namespace particles
+{
+namespace operations
+{
+
+/** momenta of two particles which replace a group of particles
+ *
+ * The two particles get half of the weighting of the group each. Their
+ * momenta are the mean momentum of the group plus and minus a momentum
+ * perpendicular to it, so that both have the mean kinetic energy of the
+ * group. This conserves the weighting, the momentum and the kinetic energy
+ * of the group.
+ * All momenta and energies are per real particle.
+ *
+ * @tparam T_Float floating point type
+ * @tparam T_isMassless true for massless particles, the energy is then `|p| * c`
+ */
+template<typename T_Float, bool T_isMassless>
+struct MergeToPair
+{
+    typedef ::PMacc::math::Vector<T_Float, DIM3> Float3;
+
+    /**
+     * @param mass mass of a real particle (ignored for massless particles)
+     * @param speedOfLight speed of light in the units of mass and momentum
+     */
+    HDINLINE MergeToPair(const T_Float mass, const T_Float speedOfLight) :
+    mass(mass), speedOfLight(speedOfLight)
+    {
+    }
+
+    /** momentum of one of the two particles
+     *
+     * @param meanMom weighted mean momentum of the group
+     * @param meanEnergy weighted mean kinetic energy of the group
+     * @param rank 0 or 1, selects the particle
+     */
+    HDINLINE Float3 operator()(const Float3& meanMom, const T_Float meanEnergy, const int rank) const
+    {
+        /* the momentum perpendicular to the mean momentum cancels out */
+        const T_Float newMomAbs = getMomentum(meanEnergy);
+        const T_Float perpMom = ::PMacc::algorithms::math::sqrt(
+            ::PMacc::algorithms::math::max(newMomAbs * newMomAbs - ::PMacc::algorithms::math::abs2(meanMom), T_Float(0.0)));
+        const T_Float sign = rank == 0 ? T_Float(1.0) : T_Float(-1.0);
+        return meanMom + sign * perpMom * getPerpendicularDirection(meanMom);
+    }
+
+    /** kinetic energy of a real particle */
+    HDINLINE T_Float getKineticEnergy(const Float3& mom) const
+    {
+        const T_Float c2 = speedOfLight * speedOfLight;
+        const T_Float mom2c2 = ::PMacc::algorithms::math::abs2(mom) * c2;
+        if (T_isMassless)
+            return ::PMacc::algorithms::math::sqrt(mom2c2);
+
+        /* (gamma - 1) * m * c^2 without cancellation for small momenta */
+        const T_Float restEnergy = mass * c2;
+        return mom2c2 / (::PMacc::algorithms::math::sqrt(restEnergy * restEnergy + mom2c2) + restEnergy);
+    }
+
+    /** absolute momentum of a real particle with the given kinetic energy */
+    HDINLINE T_Float getMomentum(const T_Float kineticEnergy) const
+    {
+        if (T_isMassless)
+            return kineticEnergy / speedOfLight;
+
+        const T_Float restEnergy = mass * speedOfLight * speedOfLight;
+        return ::PMacc::algorithms::math::sqrt(kineticEnergy * (kineticEnergy + T_Float(2.0) * restEnergy)) / speedOfLight;
+    }
+
+    /** unit vector perpendicular to a vector
+     *
+     * Uses the cross product with the axis of the smallest component,
+     * returns the x axis for a zero vector.
+     */
+    HDINLINE static Float3 getPerpendicularDirection(const Float3& vec)
+    {
+        uint32_t axis = 0;
+        for (uint32_t d = 1; d < 3; ++d)
+            if (::PMacc::algorithms::math::abs(vec[d]) < ::PMacc::algorithms::math::abs(vec[axis]))
+                axis = d;
+
+        Float3 unitAxis(Float3::create(0.0));
+        unitAxis[axis] = T_Float(1.0);
+
+        const Float3 perp = ::PMacc::algorithms::math::cross(vec, unitAxis);
+        const T_Float perpAbs2 = ::PMacc::algorithms::math::abs2(perp);
+        if (perpAbs2 == T_Float(0.0))
+            return Float3(1.0, 0.0, 0.0);
+        return perp / ::PMacc::algorithms::math::sqrt(perpAbs2);
+    }
+
+private:
+
+    T_Float mass;
+    T_Float speedOfLight;
+};
+
+} // namespace operations
+} // namespace particles
+} // namespace PMacc
@@ -44,16 +44,14 @@ namespace PMacc
         parBase(parBase),
         exchange(exchange),
         state(Constructor),
-        maxSize(parBase.getParticlesBuffer().getReceiveExchangeStack(exchange).getMaxParticlesCount()),
         initDependency(__getTransactionEvent()),
-        lastSize(0) { }
+        maxSize(0), lastSize(0) { }
 
         virtual void init()
         {
             state = Init;
-            lastReceiveEvent = parBase.getParticlesBuffer().asyncReceiveParticles(initDependency, exchange);
-            initDependency = lastReceiveEvent;
-            state = WaitForReceive;
+            countEvent = parBase.getParticlesBuffer().asyncReceiveParticlesCount(initDependency, exchange);
+            state = WaitForCount;
         }
 
         bool executeIntern()
@@ -62,6 +60,24 @@ namespace PMacc
             {
                 case Init:
                     break;
+                case WaitForCount:
+
+                    if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(countEvent.getTaskId()))
+                    {
+                        state = InitReceive;
+                        /* the stack must fit all particles before the receive is started */
+                        parBase.getParticlesBuffer().adaptReceiveExchange(
+                            exchange,
+                            parBase.getParticlesBuffer().getReceiveParticlesCount(exchange)
+                        );
+                        maxSize = parBase.getParticlesBuffer().getReceiveExchangeStack(exchange).getMaxParticlesCount();
+                        lastReceiveEvent = parBase.getParticlesBuffer().asyncReceiveParticles(countEvent, exchange);
+                        state = WaitForReceive;
+                    }
+
+                    break;
+                case InitReceive:
+                    break;
                 case WaitForReceive:
 
                     if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(lastReceiveEvent.getTaskId()))
@@ -72,7 +88,6 @@ namespace PMacc
                         lastSize = parBase.getParticlesBuffer().getReceiveExchangeStack(exchange).getHostParticlesCurrentSize();
                         parBase.insertParticles(exchange);
                         tmpEvent = __endTransaction();
-                        initDependency = tmpEvent;
                         state = WaitForInsert;
                     }
 
@@ -82,14 +97,16 @@ namespace PMacc
                 case WaitForInsert:
                     if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(tmpEvent.getTaskId()))
                     {
-                        state=Wait;
+                        state = Wait;
                         assert(lastSize <= maxSize);
-                        //check for next bash round
+                        /* the sender adapts its stack with the same particle count,
+                         * a full stack means that another bash round follows
+                         */
                         if (lastSize == maxSize)
                         {
                             std::cerr << "recv max size " << maxSize << " particles" << std::endl;
-                            init(); //call init and run a full send cycle
-
+                            lastReceiveEvent = parBase.getParticlesBuffer().asyncReceiveParticles(tmpEvent, exchange);
+                            state = WaitForReceive;
                         }
                         else
                         {
@@ -127,6 +144,8 @@ namespace PMacc
         {
             Constructor,
             Init,
+            WaitForCount,
+            InitReceive,
             WaitForReceive,
             InitInsert,
             WaitForInsert,
@@ -141,6 +160,7 @@ namespace PMacc
         ParBase& parBase;
         state_t state;
         EventTask tmpEvent;
+        EventTask countEvent;
         EventTask lastReceiveEvent;
         EventTask initDependency;
         uint32_t exchange;
@@ -42,17 +42,17 @@ namespace PMacc
         parBase(parBase),
         exchange(exchange),
         state(Constructor),
-        maxSize(parBase.getParticlesBuffer().getSendExchangeStack(exchange).getMaxParticlesCount()),
         initDependency(__getTransactionEvent()),
-        lastSize(0),lastSendEvent(EventTask()){ }
+        maxSize(0), lastSize(0), lastSendEvent(EventTask()){ }
 
         virtual void init()
         {
             state = Init;
             __startTransaction(initDependency);
-            parBase.bashParticles(exchange);
-            tmpEvent = __endTransaction();
-            state = WaitForBash;
+            parBase.countExchangeParticles(exchange);
+            countEvent = parBase.getParticlesBuffer().asyncSendParticlesCount(__getTransactionEvent(), exchange);
+            __endTransaction();
+            state = WaitForCount;
         }
 
         bool executeIntern()
@@ -61,6 +61,22 @@ namespace PMacc
             {
                 case Init:
                     break;
+                case WaitForCount:
+                    /* the counter is on the host after it was sent */
+                    if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(countEvent.getTaskId()))
+                    {
+                        state = InitBash;
+                        parBase.getParticlesBuffer().adaptSendExchange(
+                            exchange,
+                            parBase.getParticlesBuffer().getSendParticlesCount(exchange)
+                        );
+                        maxSize = parBase.getParticlesBuffer().getSendExchangeStack(exchange).getMaxParticlesCount();
+                        initDependency = countEvent;
+                        startBash();
+                    }
+                    break;
+                case InitBash:
+                    break;
                 case WaitForBash:
 
                     if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(tmpEvent.getTaskId()) &&
@@ -80,19 +96,17 @@ namespace PMacc
                 case InitSend:
                     break;
                 case WaitForSend:
-                    if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(tmpEvent.getTaskId()))
+                    assert(lastSize <= maxSize);
+                    /* a full stack means the stack is at its maximum and
+                     * more particles are left in the guard (next bash round)
+                     */
+                    if (lastSize == maxSize)
                     {
-                        assert(lastSize<=maxSize);
-                        //check for next bash round
-                        if (lastSize == maxSize)
-                        {
-                            std::cerr<<"send max size "<<maxSize<<" particles"<<std::endl;
-                            init(); //call init and run a full send cycle
-
-                        }
-                        else
-                            state = WaitForSendEnd;
+                        std::cerr << "send max size " << maxSize << " particles" << std::endl;
+                        startBash();
                     }
+                    else
+                        state = WaitForSendEnd;
                     break;
                 case WaitForSendEnd:
                     if (NULL == Environment<>::get().Manager().getITaskIfNotFinished(lastSendEvent.getTaskId()))
@@ -124,10 +138,21 @@ namespace PMacc
 
     private:
 
+        /* bash the particles of the guard after initDependency is finished */
+        void startBash()
+        {
+            __startTransaction(initDependency);
+            parBase.bashParticles(exchange);
+            tmpEvent = __endTransaction();
+            state = WaitForBash;
+        }
+
         enum state_t
         {
             Constructor,
             Init,
+            WaitForCount,
+            InitBash,
             WaitForBash,
             InitSend,
             WaitForSend,
@@ -140,6 +165,7 @@ namespace PMacc
         ParBase& parBase;
         state_t state;
         EventTask tmpEvent;
+        EventTask countEvent;
         EventTask lastSendEvent;
         EventTask initDependency;
         uint32_t exchange;
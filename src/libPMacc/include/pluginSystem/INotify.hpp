@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include "dataManagement/ISimulationData.hpp"
+
+#include <vector>
+
 namespace PMacc
 {
     /*
@@ -53,6 +57,57 @@ namespace PMacc
          */
         virtual void notify( uint32_t currentStep ) = 0;
 
+        /** Has the notification a part which can run concurrently?
+         *
+         * If true, notifyConcurrent() is called after notify() in the same
+         * step. It is executed by a worker thread of the PluginConnector
+         * while the simulation continues with the next step.
+         *
+         * @return true if notifyConcurrent() is implemented
+         */
+        virtual bool isConcurrentNotify() const
+        {
+            return false;
+        }
+
+        /** Datasets read by notifyConcurrent()
+         *
+         * The PluginConnector synchronizes the host copies of these datasets
+         * once per step before the plugins are notified. They are not
+         * modified until all concurrent notifications finished.
+         *
+         * @return ids of datasets in the DataConnector
+         */
+        virtual std::vector<SimulationDataId> getConcurrentReadData() const
+        {
+            return std::vector<SimulationDataId>();
+        }
+
+        /** Concurrent part of the notification
+         *
+         * Must only work on host memory: the datasets named by
+         * getConcurrentReadData() and data staged by the plugin in notify().
+         * Kernels, the event system and the DataConnector must not be used.
+         *
+         * @param currentStep simulation iteration step of the last notify()
+         */
+        virtual void notifyConcurrent( uint32_t )
+        {
+        }
+
+        /** Does notifyConcurrent() call MPI collectives?
+         *
+         * Collective notifications are executed one after another in the
+         * order of their registration, which is the same on all ranks.
+         * They must use their own communicators.
+         *
+         * @return true if MPI collectives are called
+         */
+        virtual bool isCollectiveNotify() const
+        {
+            return true;
+        }
+
         /** When was the plugin notified last?
          *
          * @return last notify time step
@@ -92,6 +92,29 @@ namespace PMacc
          */
         virtual void checkpoint(uint32_t currentStep, const std::string checkpointDirectory) = 0;
 
+        /**
+         * Is a checkpoint of this plugin still written in the background?
+         *
+         * Plugins which write checkpoints asynchronously
+         * (see SimulationDescription::isCheckpointAsync) override this method.
+         *
+         * @return true if the last checkpoint is not yet written completely
+         */
+        virtual bool isCheckpointPending()
+        {
+            return false;
+        }
+
+        /**
+         * Blocks until the last checkpoint of this plugin is written.
+         *
+         * @return false if writing the last checkpoint failed
+         */
+        virtual bool waitForCheckpoint()
+        {
+            return true;
+        }
+
         /**
          * Restart notification callback.
          *
@@ -25,9 +25,14 @@
 
 #include "pluginSystem/INotify.hpp"
 #include "pluginSystem/IPlugin.hpp"
+#include "simulationControl/Profiler.hpp"
 
+#include <pthread.h>
 #include <vector>
 #include <list>
+#include <deque>
+#include <set>
+#include <string>
 
 namespace PMacc
 {
@@ -40,6 +45,8 @@ namespace PMacc
     {
     private:
         typedef std::list<std::pair<INotify*, uint32_t> > NotificationList;
+        /* plugin and step of a concurrent notification */
+        typedef std::pair<INotify*, uint32_t> Task;
 
     public:
 
@@ -82,6 +89,8 @@ namespace PMacc
          */
         void unloadPlugins()
         {
+            stopConcurrentWorkers();
+
             // unload all plugins
             for (std::list<IPlugin*>::reverse_iterator iter = plugins.rbegin();
                  iter != plugins.rend(); ++iter)
@@ -131,13 +140,79 @@ namespace PMacc
                 throw PluginException("Notifications for a NULL object are not allowed.");
         }
 
+        /**
+         * Start worker threads for the concurrent part of notifications
+         *
+         * @param numWorkers number of threads, 0 runs all notifications in
+         *                   the calling thread
+         * @param allowCollectives true if MPI may be called concurrently
+         *                         (MPI_THREAD_MULTIPLE), else collective
+         *                         notifications stay in the calling thread
+         */
+        void startConcurrentWorkers(uint32_t numWorkers, bool allowCollectives)
+        {
+            stopConcurrentWorkers();
+
+            collectivesInWorkers = allowCollectives;
+            /* the arguments must not move while the threads are running */
+            workerArgs.resize(numWorkers);
+            workers.resize(numWorkers);
+            for (uint32_t i = 0; i < numWorkers; ++i)
+            {
+                workerArgs[i] = std::make_pair(this, i);
+                if (pthread_create(&workers[i], NULL, &PluginConnector::runWorker, &workerArgs[i]) != 0)
+                {
+                    workers.resize(i);
+                    stopConcurrentWorkers();
+                    throw PluginException("Failed to start a worker thread for concurrent notifications.");
+                }
+            }
+        }
+
+        /**
+         * Datasets read by the concurrent notifications in a step
+         *
+         * The host copies of these datasets must be synchronized before
+         * notifyPlugins() is called with the same step.
+         *
+         * @param currentStep current simulation iteration step
+         * @return unique ids of all datasets read by notified plugins
+         */
+        std::vector<SimulationDataId> getConcurrentReadData(uint32_t currentStep)
+        {
+            std::set<SimulationDataId> ids;
+            if (workers.empty())
+                return std::vector<SimulationDataId>();
+
+            for (NotificationList::iterator iter = notificationList.begin();
+                    iter != notificationList.end(); ++iter)
+            {
+                INotify* notifiedObj = iter->first;
+                if (currentStep % iter->second == 0 && notifiedObj->isConcurrentNotify())
+                {
+                    std::vector<SimulationDataId> readData = notifiedObj->getConcurrentReadData();
+                    ids.insert(readData.begin(), readData.end());
+                }
+            }
+            return std::vector<SimulationDataId>(ids.begin(), ids.end());
+        }
+
         /**
          * Notifies plugins that data should be dumped.
          *
+         * The concurrent part of notifications is queued to the worker
+         * threads, it is finished at the latest with the next call.
+         *
          * @param currentStep current simulation iteration step
          */
         void notifyPlugins(uint32_t currentStep)
         {
+            waitForConcurrentPlugins();
+
+            std::vector<Task> independentQueue;
+            std::vector<Task> collectiveQueue;
+            simulationControl::Profiler& profiler = simulationControl::Profiler::getInstance();
+
             for (NotificationList::iterator iter = notificationList.begin();
                     iter != notificationList.end(); ++iter)
             {
@@ -145,10 +220,58 @@ namespace PMacc
                 uint32_t period = iter->second;
                 if (currentStep % period == 0)
                 {
+                    if (profiler.isEnabled())
+                    {
+                        IPlugin* plugin = dynamic_cast<IPlugin*>(notifiedObj);
+                        profiler.startPhase(plugin != NULL ? plugin->pluginGetName() : std::string("notify"));
+                    }
                     notifiedObj->notify(currentStep);
+                    if (notifiedObj->isConcurrentNotify())
+                    {
+                        const bool isCollective = notifiedObj->isCollectiveNotify();
+                        if (workers.empty() || (isCollective && !collectivesInWorkers))
+                            notifiedObj->notifyConcurrent(currentStep);
+                        else if (isCollective)
+                            collectiveQueue.push_back(std::make_pair(notifiedObj, currentStep));
+                        else
+                            independentQueue.push_back(std::make_pair(notifiedObj, currentStep));
+                    }
                     notifiedObj->setLastNotify(currentStep);
+                    profiler.endPhase();
                 }
             }
+
+            if (independentQueue.empty() && collectiveQueue.empty())
+                return;
+
+            pthread_mutex_lock(&taskMutex);
+            independentTasks.insert(independentTasks.end(), independentQueue.begin(), independentQueue.end());
+            collectiveTasks.insert(collectiveTasks.end(), collectiveQueue.begin(), collectiveQueue.end());
+            numPendingTasks += independentQueue.size() + collectiveQueue.size();
+            pthread_cond_broadcast(&taskCond);
+            pthread_mutex_unlock(&taskMutex);
+        }
+
+        /**
+         * Blocks until all concurrent notifications are finished.
+         *
+         * Must be called before data read by concurrent notifications is
+         * modified on the host.
+         */
+        void waitForConcurrentPlugins()
+        {
+            if (workers.empty())
+                return;
+
+            pthread_mutex_lock(&taskMutex);
+            while (numPendingTasks != 0)
+                pthread_cond_wait(&doneCond, &taskMutex);
+            std::string error;
+            error.swap(taskError);
+            pthread_mutex_unlock(&taskMutex);
+
+            if (!error.empty())
+                throw PluginException("Concurrent plugin notification failed: " + error);
         }
 
         /**
@@ -167,6 +290,38 @@ namespace PMacc
             }
         }
 
+        /**
+         * Checks if any plugin still writes a checkpoint in the background.
+         *
+         * @return true if at least one checkpoint is pending
+         */
+        bool isCheckpointPending()
+        {
+            for (std::list<IPlugin*>::iterator iter = plugins.begin();
+                    iter != plugins.end(); ++iter)
+            {
+                if ((*iter)->isCheckpointPending())
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * Blocks until all plugins finished writing their checkpoints.
+         *
+         * @return false if at least one plugin failed to write its checkpoint
+         */
+        bool waitForCheckpoints()
+        {
+            bool success = true;
+            for (std::list<IPlugin*>::iterator iter = plugins.begin();
+                    iter != plugins.end(); ++iter)
+            {
+                success = (*iter)->waitForCheckpoint() && success;
+            }
+            return success;
+        }
+
         /**
          * Notifies plugins that a restart is required.
          *
@@ -224,17 +379,126 @@ namespace PMacc
             return instance;
         }
 
-        PluginConnector()
+        PluginConnector() :
+        collectivesInWorkers(false),
+        stopWorkers(false),
+        numPendingTasks(0)
         {
-
+            pthread_mutex_init(&taskMutex, NULL);
+            pthread_cond_init(&taskCond, NULL);
+            pthread_cond_init(&doneCond, NULL);
         }
 
         virtual ~PluginConnector()
         {
+            pthread_cond_destroy(&doneCond);
+            pthread_cond_destroy(&taskCond);
+            pthread_mutex_destroy(&taskMutex);
+        }
+
+        /**
+         * Finish all concurrent notifications and join the worker threads
+         */
+        void stopConcurrentWorkers()
+        {
+            if (workers.empty())
+                return;
+
+            pthread_mutex_lock(&taskMutex);
+            while (numPendingTasks != 0)
+                pthread_cond_wait(&doneCond, &taskMutex);
+            stopWorkers = true;
+            pthread_cond_broadcast(&taskCond);
+            pthread_mutex_unlock(&taskMutex);
 
+            for (size_t i = 0; i < workers.size(); ++i)
+                pthread_join(workers[i], NULL);
+
+            workers.clear();
+            stopWorkers = false;
+        }
+
+        static void *runWorker(void *p_args)
+        {
+            std::pair<PluginConnector*, uint32_t>* args =
+                (std::pair<PluginConnector*, uint32_t>*) (p_args);
+            args->first->processTasks(args->second);
+            return NULL;
+        }
+
+        /**
+         * Execute queued concurrent notifications until the workers are stopped
+         *
+         * @param workerIdx index of the calling worker thread
+         */
+        void processTasks(uint32_t workerIdx)
+        {
+            pthread_mutex_lock(&taskMutex);
+            while (true)
+            {
+                /* collective notifications are executed by the first worker
+                 * only, so their MPI calls are ordered equally on all ranks */
+                std::deque<Task>* queue = NULL;
+                if (workerIdx == 0 && !collectiveTasks.empty())
+                    queue = &collectiveTasks;
+                else if (!independentTasks.empty())
+                    queue = &independentTasks;
+
+                if (queue == NULL)
+                {
+                    if (stopWorkers)
+                        break;
+                    pthread_cond_wait(&taskCond, &taskMutex);
+                    continue;
+                }
+
+                Task task = queue->front();
+                queue->pop_front();
+                pthread_mutex_unlock(&taskMutex);
+
+                /* nothing may escape the worker, otherwise the task is
+                 * never finished and waitForPendingTasks() deadlocks */
+                std::string error;
+                try
+                {
+                    task.first->notifyConcurrent(task.second);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                    if (error.empty())
+                        error = "unknown std::exception";
+                }
+                catch (...)
+                {
+                    error = "unknown exception";
+                }
+
+                pthread_mutex_lock(&taskMutex);
+                if (!error.empty() && taskError.empty())
+                    taskError = error;
+                if (--numPendingTasks == 0)
+                    pthread_cond_broadcast(&doneCond);
+            }
+            pthread_mutex_unlock(&taskMutex);
         }
 
         std::list<IPlugin*> plugins;
         NotificationList notificationList;
+
+        /* worker threads for concurrent notifications and their arguments */
+        std::vector<pthread_t> workers;
+        std::vector<std::pair<PluginConnector*, uint32_t> > workerArgs;
+        bool collectivesInWorkers;
+
+        /* queued concurrent notifications, protected by taskMutex */
+        pthread_mutex_t taskMutex;
+        pthread_cond_t taskCond;
+        pthread_cond_t doneCond;
+        std::deque<Task> independentTasks;
+        std::deque<Task> collectiveTasks;
+        bool stopWorkers;
+        size_t numPendingTasks;
+        std::string taskError;
     };
 }
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "Environment.hpp"
+#include "simulationControl/Profiler.hpp"
+
+#include <string>
+
+namespace PMacc
+{
+namespace simulationControl
+{
+
+/**
+ * Measures a phase of the Profiler from construction until destruction.
+ *
+ * If the profiler synchronizes phases, all tasks and kernels started within
+ * the phase are finished before it ends.
+ */
+class ProfilePhase
+{
+public:
+    /**
+     * @param name name of the phase within the enclosing phase
+     */
+    ProfilePhase( const std::string& name )
+    {
+        Environment<>::get().Profiler().startPhase( name );
+    }
+
+    ~ProfilePhase()
+    {
+        Profiler& profiler = Environment<>::get().Profiler();
+        if( profiler.isSyncPhases() )
+        {
+            Environment<>::get().Manager().waitForAllTasks();
+            CUDA_CHECK( cudaDeviceSynchronize() );
+        }
+        profiler.endPhase();
+    }
+
+private:
+    ProfilePhase( const ProfilePhase& );
+    ProfilePhase& operator=( const ProfilePhase& );
+};
+
+} // namespace simulationControl
+} // namespace PMacc
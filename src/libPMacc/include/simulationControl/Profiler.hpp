@@ -0,0 +1,387 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulationControl/TimeInterval.hpp"
+#include "communication/manager_common.h"
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace PMacc
+{
+
+class PluginConnector;
+
+namespace simulationControl
+{
+
+/**
+ * Measures the wall clock time of the phases of a simulation step.
+ *
+ * Phases are started and ended in the main thread and can be nested, a
+ * nested phase is identified by the path of all open phases. Time spent in
+ * the event system while waiting for tasks is added to the innermost open
+ * phase as wait time.
+ * The measurement is switched on at runtime and costs nothing but a check
+ * of a flag otherwise.
+ *
+ * Singleton class.
+ */
+class Profiler
+{
+public:
+    /** Switch on the measurement
+     *
+     * @param syncPhases wait for all device work at the end of each phase,
+     *                   gives the device time of a phase but prevents the
+     *                   overlap of phases
+     * @param recordTrace keep every single phase for a trace, memory grows
+     *                    with the number of steps
+     */
+    void enable( const bool syncPhases, const bool recordTrace )
+    {
+        enabled = true;
+        sync = syncPhases;
+        trace = recordTrace;
+        startTime = TimeIntervall::getTime();
+    }
+
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /** Must the device be synchronized at the end of each phase? */
+    bool isSyncPhases() const
+    {
+        return enabled && sync;
+    }
+
+    /** Open a phase
+     *
+     * @param name name of the phase, unique within the enclosing phase
+     */
+    void startPhase( const std::string& name )
+    {
+        if( !enabled )
+            return;
+
+        OpenPhase phase;
+        phase.path = openPhases.empty() ? name : openPhases.back().path + "/" + name;
+        phase.start = TimeIntervall::getTime();
+        phase.waitTime = 0.0;
+        openPhases.push_back( phase );
+    }
+
+    /** Close the innermost open phase */
+    void endPhase()
+    {
+        if( !enabled || openPhases.empty() )
+            return;
+
+        const double end = TimeIntervall::getTime();
+        const OpenPhase& phase = openPhases.back();
+
+        PhaseStatistics& statistics = phases[phase.path];
+        statistics.time += end - phase.start;
+        statistics.waitTime += phase.waitTime;
+        statistics.calls++;
+
+        if( trace )
+        {
+            TraceEvent event;
+            event.path = phase.path;
+            event.start = phase.start;
+            event.duration = end - phase.start;
+            traceEvents.push_back( event );
+        }
+
+        const double waitTime = phase.waitTime;
+        openPhases.pop_back();
+        /* the wait time of a nested phase is part of the enclosing phase */
+        if( !openPhases.empty() )
+            openPhases.back().waitTime += waitTime;
+    }
+
+    /** Begin to wait for tasks of the event system
+     *
+     * Waits can be nested, only the outermost wait is measured. The time
+     * until endWait() is added to the innermost open phase.
+     */
+    void startWait()
+    {
+        if( enabled && numWaits++ == 0 )
+            waitStart = TimeIntervall::getTime();
+    }
+
+    /** End a wait started with startWait() */
+    void endWait()
+    {
+        if( enabled && --numWaits == 0 && !openPhases.empty() )
+            openPhases.back().waitTime += TimeIntervall::getTime() - waitStart;
+    }
+
+    /** Aggregate the phases of all ranks and write them as JSON
+     *
+     * The phases opened on rank 0 are reported, for each the minimum,
+     * maximum and mean time over all ranks is given.
+     * Must be called collectively.
+     *
+     * @param filename output file, written by rank 0
+     * @param comm communicator of all ranks
+     */
+    void writeStatistics( const std::string& filename, MPI_Comm comm ) const
+    {
+        if( !enabled )
+            return;
+
+        int rank;
+        int numRanks;
+        MPI_CHECK( MPI_Comm_rank( comm, &rank ) );
+        MPI_CHECK( MPI_Comm_size( comm, &numRanks ) );
+
+        /* agree on the phases of rank 0 */
+        std::string names;
+        if( rank == 0 )
+        {
+            for( PhaseMap::const_iterator it = phases.begin(); it != phases.end(); ++it )
+                names += it->first + '\n';
+        }
+        uint64_t namesSize = names.size();
+        MPI_CHECK( MPI_Bcast( &namesSize, 1, MPI_UINT64_T, 0, comm ) );
+        names.resize( namesSize );
+        if( namesSize != 0 )
+            MPI_CHECK( MPI_Bcast( &names[0], int( namesSize ), MPI_CHAR, 0, comm ) );
+
+        std::vector<std::string> paths;
+        std::istringstream namesStream( names );
+        std::string path;
+        while( std::getline( namesStream, path ) )
+            paths.push_back( path );
+
+        /* 0: time, 1: wait time */
+        const size_t numPhases = paths.size();
+        std::vector<double> local( 2 * numPhases, 0.0 );
+        for( size_t i = 0; i < numPhases; ++i )
+        {
+            PhaseMap::const_iterator it = phases.find( paths[i] );
+            if( it != phases.end() )
+            {
+                local[2 * i] = it->second.time;
+                local[2 * i + 1] = it->second.waitTime;
+            }
+        }
+
+        std::vector<double> minTime( local.size() );
+        std::vector<double> maxTime( local.size() );
+        std::vector<double> sumTime( local.size() );
+        if( numPhases != 0 )
+        {
+            const int count = int( local.size() );
+            MPI_CHECK( MPI_Reduce( &local[0], &minTime[0], count, MPI_DOUBLE, MPI_MIN, 0, comm ) );
+            MPI_CHECK( MPI_Reduce( &local[0], &maxTime[0], count, MPI_DOUBLE, MPI_MAX, 0, comm ) );
+            MPI_CHECK( MPI_Reduce( &local[0], &sumTime[0], count, MPI_DOUBLE, MPI_SUM, 0, comm ) );
+        }
+
+        if( rank != 0 )
+            return;
+
+        std::ofstream file( filename.c_str() );
+        if( !file )
+            throw std::runtime_error( "Profiler: can not open file " + filename );
+
+        file << std::setprecision( 6 ) << std::fixed;
+        file << "{\n  \"ranks\": " << numRanks << ",\n  \"unit\": \"ms\",\n  \"phases\": [";
+        for( size_t i = 0; i < numPhases; ++i )
+        {
+            file << ( i == 0 ? "\n" : ",\n" );
+            file << "    {\"name\": \"" << escape( paths[i] ) << "\", \"calls\": " << phases.find( paths[i] )->second.calls;
+            for( int k = 0; k < 2; ++k )
+            {
+                const size_t idx = 2 * i + k;
+                file << ", \"" << ( k == 0 ? "time" : "wait" ) << "\": {\"min\": " << minTime[idx] <<
+                    ", \"max\": " << maxTime[idx] <<
+                    ", \"mean\": " << sumTime[idx] / double( numRanks ) << "}";
+            }
+            file << "}";
+        }
+        file << "\n  ]\n}\n";
+    }
+
+    /** Write all recorded phases of all ranks as Chrome trace
+     *
+     * The file can be loaded with chrome://tracing, each rank is shown as
+     * one process. Must be called collectively.
+     *
+     * @param filename output file, written by rank 0
+     * @param comm communicator of all ranks
+     */
+    void writeTrace( const std::string& filename, MPI_Comm comm ) const
+    {
+        if( !enabled || !trace )
+            return;
+
+        int rank;
+        int numRanks;
+        MPI_CHECK( MPI_Comm_rank( comm, &rank ) );
+        MPI_CHECK( MPI_Comm_size( comm, &numRanks ) );
+
+        /* common origin of the time axis */
+        double origin = startTime;
+        MPI_CHECK( MPI_Allreduce( &startTime, &origin, 1, MPI_DOUBLE, MPI_MIN, comm ) );
+
+        /* complete events in microseconds */
+        std::ostringstream events;
+        events << std::setprecision( 3 ) << std::fixed;
+        for( size_t i = 0; i < traceEvents.size(); ++i )
+        {
+            const TraceEvent& event = traceEvents[i];
+            /* nested phases are shown stacked, the name is the last part of the path */
+            const std::string name = event.path.substr( event.path.rfind( '/' ) + 1 );
+            events << ",\n{\"name\": \"" << escape( name ) << "\", \"ph\": \"X\", \"pid\": " << rank <<
+                ", \"tid\": 0, \"ts\": " << ( event.start - origin ) * 1000. <<
+                ", \"dur\": " << event.duration * 1000. <<
+                ", \"args\": {\"path\": \"" << escape( event.path ) << "\"}}";
+        }
+        const std::string localEvents = events.str();
+
+        int localSize = int( localEvents.size() );
+        std::vector<int> sizes( numRanks );
+        MPI_CHECK( MPI_Gather( &localSize, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, comm ) );
+
+        std::vector<int> offsets( numRanks, 0 );
+        int totalSize = 0;
+        for( int i = 0; i < numRanks; ++i )
+        {
+            offsets[i] = totalSize;
+            totalSize += sizes[i];
+        }
+        std::string allEvents( rank == 0 ? totalSize : 0, ' ' );
+        char dummy;
+        MPI_CHECK( MPI_Gatherv( const_cast<char*>( localEvents.data() ), localSize, MPI_CHAR,
+                                allEvents.empty() ? &dummy : &allEvents[0], &sizes[0], &offsets[0], MPI_CHAR,
+                                0, comm ) );
+
+        if( rank != 0 )
+            return;
+
+        std::ofstream file( filename.c_str() );
+        if( !file )
+            throw std::runtime_error( "Profiler: can not open file " + filename );
+
+        file << "{\"traceEvents\": [\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"rank 0\"}}";
+        for( int i = 1; i < numRanks; ++i )
+            file << ",\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << i <<
+                ", \"args\": {\"name\": \"rank " << i << "\"}}";
+        file << allEvents << "\n]}\n";
+    }
+
+private:
+    friend class Environment<DIM1>;
+    friend class Environment<DIM2>;
+    friend class Environment<DIM3>;
+    /* notifications of plugins are measured as phases */
+    friend class PMacc::PluginConnector;
+
+    struct OpenPhase
+    {
+        std::string path;
+        double start;
+        double waitTime;
+    };
+
+    struct PhaseStatistics
+    {
+        double time;
+        double waitTime;
+        uint64_t calls;
+
+        PhaseStatistics() : time( 0.0 ), waitTime( 0.0 ), calls( 0 )
+        {
+        }
+    };
+
+    struct TraceEvent
+    {
+        std::string path;
+        double start;
+        double duration;
+    };
+
+    typedef std::map<std::string, PhaseStatistics> PhaseMap;
+
+    static std::string escape( const std::string& str )
+    {
+        std::string result;
+        for( size_t i = 0; i < str.size(); ++i )
+        {
+            if( str[i] == '"' || str[i] == '\\' )
+                result += '\\';
+            result += str[i];
+        }
+        return result;
+    }
+
+    static Profiler& getInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler() :
+    enabled( false ),
+    sync( false ),
+    trace( false ),
+    startTime( 0.0 ),
+    numWaits( 0 ),
+    waitStart( 0.0 )
+    {
+    }
+
+    bool enabled;
+    bool sync;
+    bool trace;
+
+    /* wall clock time in msec when the measurement was switched on */
+    double startTime;
+
+    /* depth of nested waits and start of the outermost wait */
+    uint32_t numWaits;
+    double waitStart;
+
+    std::vector<OpenPhase> openPhases;
+    PhaseMap phases;
+    std::vector<TraceEvent> traceEvents;
+};
+
+} // namespace simulationControl
+} // namespace PMacc
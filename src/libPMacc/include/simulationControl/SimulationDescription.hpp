@@ -101,6 +101,29 @@ public:
         currentStep = setCurrentStep;
     }
 
+    /** Are checkpoints written asynchronously?
+     *
+     * If true, plugins may stage the checkpoint data and write it while
+     * the simulation continues.
+     *
+     * @return bool true if asynchronous checkpoints are requested
+     */
+    bool isCheckpointAsync()
+    {
+        return checkpointAsync;
+    }
+
+    /** Set asynchronous checkpoints
+     *
+     * @see isCheckpointAsync
+     *
+     * @param[in] bool setCheckpointAsync
+     */
+    void setCheckpointAsync( const bool setCheckpointAsync )
+    {
+        checkpointAsync = setCheckpointAsync;
+    }
+
 protected:
     /** author that runs the simulation */
     std::string author;
@@ -111,6 +134,9 @@ protected:
     /** current time step of simulation */
     uint32_t currentStep;
 
+    /** write checkpoints in the background */
+    bool checkpointAsync;
+
 private:
     friend class Environment<DIM1>;
     friend class Environment<DIM2>;
@@ -125,7 +151,8 @@ private:
     SimulationDescription() :
     author(""),
     runSteps(0),
-    currentStep(0)
+    currentStep(0),
+    checkpointAsync(false)
     {
     }
 };
@@ -32,9 +32,12 @@
 #include "dataManagement/DataConnector.hpp"
 #include "Environment.hpp"
 #include "pluginSystem/IPlugin.hpp"
+#include "simulationControl/ProfilePhase.hpp"
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <algorithm>
 #include <fstream>
 
 namespace PMacc
@@ -65,8 +68,33 @@ public:
     restartStep(-1),
     restartDirectory("checkpoints"),
     restartRequested(false),
+    checkpointAsync(false),
+    checkpointTimePeriod(0),
+    checkpointDeadline(0),
+    checkpointCostEstimate(0),
+    concurrentPluginWorkers(0),
+    profile(false),
+    profileFile("profile.json"),
+    profileSync(false),
+    profileTrace(""),
     CHECKPOINT_MASTER_FILE("checkpoints.txt"),
-    author("")
+    author(""),
+    pendingCheckpoint(false),
+    pendingCheckpointStep(0),
+    checkpointComm(MPI_COMM_NULL),
+    checkpointRequest(MPI_REQUEST_NULL),
+    checkpointLocalFailed(0),
+    checkpointGlobalFailed(0),
+    startTime(TimeIntervall::getTime()),
+    checkpointStartTime(0.0),
+    checkpointCost(-1.0),
+    lastCheckpointTime(startTime),
+    nextTimedCheckpointStep(std::numeric_limits<uint32_t>::max()),
+    nextDeadlineCheckpointStep(std::numeric_limits<uint32_t>::max()),
+    nextScheduleStep(0),
+    lastScheduleStep(0),
+    lastScheduleTime(startTime),
+    stopRequested(false)
     {
         tSimulation.toggleStart();
         tInit.toggleStart();
@@ -131,14 +159,41 @@ public:
      */
     virtual void dumpOneStep(uint32_t currentStep)
     {
-        Environment<DIM>::get().DataConnector().invalidate();
+        DataConnector &dc = Environment<DIM>::get().DataConnector();
+        PluginConnector &pluginConnector = Environment<DIM>::get().PluginConnector();
+        dc.invalidate();
+
+        /* one host snapshot of all data read by concurrent notifications */
+        std::vector<SimulationDataId> snapshot = pluginConnector.getConcurrentReadData(currentStep);
+        for (size_t i = 0; i < snapshot.size(); ++i)
+        {
+            dc.getData<ISimulationData>(snapshot[i]);
+            dc.releaseData(snapshot[i]);
+        }
 
         /* trigger notification */
-        Environment<DIM>::get().PluginConnector().notifyPlugins(currentStep);
+        {
+            simulationControl::ProfilePhase phase("plugins");
+            pluginConnector.notifyPlugins(currentStep);
+        }
+
+        /* commit a checkpoint which was written in the background */
+        finishCheckpoint(false);
 
         /* trigger checkpoint notification */
-        if (checkpointPeriod && (currentStep % checkpointPeriod == 0))
+        const bool isTimedCheckpoint = isScheduledCheckpoint(currentStep);
+        if ((checkpointPeriod && (currentStep % checkpointPeriod == 0)) || isTimedCheckpoint)
         {
+            simulationControl::ProfilePhase phase("checkpoint");
+
+            /* only one asynchronous checkpoint can be in flight */
+            finishCheckpoint(true);
+            /* plugins checkpoint their output files */
+            pluginConnector.waitForConcurrentPlugins();
+
+            checkpointStartTime = TimeIntervall::getTime();
+            onCheckpointStarted(currentStep);
+
             /* first synchronize: if something failed, we can spare the time
              * for the checkpoint writing */
             CUDA_CHECK(cudaDeviceSynchronize());
@@ -148,7 +203,8 @@ public:
             GridController<DIM> &gc = Environment<DIM>::get().GridController();
             /* can be spared for better scalings, but allows to spare the
              * time for checkpointing if some ranks died */
-            MPI_CHECK(MPI_Barrier(gc.getCommunicator().getMPIComm()));
+            if (!checkpointAsync)
+                MPI_CHECK(MPI_Barrier(gc.getCommunicator().getMPIComm()));
 
             /* create directory containing checkpoints  */
             if (numCheckpoints == 0)
@@ -156,8 +212,20 @@ public:
                 Environment<DIM>::get().Filesystem().createDirectoryWithPermissions(checkpointDirectory);
             }
 
-            Environment<DIM>::get().PluginConnector().checkpointPlugins(currentStep,
-                                                                        checkpointDirectory);
+            pluginConnector.checkpointPlugins(currentStep, checkpointDirectory);
+            /* the simulation itself is not registered as plugin */
+            checkpoint(currentStep, checkpointDirectory);
+
+            if (checkpointAsync)
+            {
+                /* plugins staged their data and write it in the background,
+                 * the checkpoint is committed by finishCheckpoint() */
+                pendingCheckpoint = true;
+                pendingCheckpointStep = currentStep;
+                numCheckpoints++;
+                resetSchedule(currentStep);
+                return;
+            }
 
             /* important synchronize: only if no errors occured until this
              * point guarantees that a checkpoint is usable */
@@ -175,6 +243,8 @@ public:
                 writeCheckpointStep(currentStep);
             }
             numCheckpoints++;
+            checkpointCost = TimeIntervall::getTime() - checkpointStartTime;
+            resetSchedule(currentStep);
         }
     }
 
@@ -213,7 +283,9 @@ public:
     {
         init();
 
-        for (uint32_t nthSoftRestart = 0; nthSoftRestart <= softRestarts; ++nthSoftRestart)
+        for (uint32_t nthSoftRestart = 0;
+             nthSoftRestart <= softRestarts && !stopRequested;
+             ++nthSoftRestart)
         {
             resetAll(0);
             uint32_t currentStep = fillSimulation();
@@ -238,6 +310,7 @@ public:
                 This becomes only important, if movingWindowCheck does more than merely checking for a slide.
                 TO DO in a new feature: Turn this into a general hook for pre-checks (window slides are just one possible action). */
                 movingWindowCheck(currentStep);
+                simulationControl::ProfilePhase phase("dump");
                 dumpOneStep(currentStep);
             }
             else
@@ -250,16 +323,31 @@ public:
             /* dump 0% output */
             dumpTimes(tSimCalculation, tRound, roundAvg, currentStep);
 
+            /* time based checkpoints are scheduled relative to the first
+             * simulated step */
+            lastCheckpointTime = TimeIntervall::getTime();
+            resetSchedule(currentStep);
+
 
             /** \todo currently we assume this is the only point in the simulation
              *        that is allowed to manipulate `currentStep`. Else, one needs to
              *        add and act on changed values via
              *        `SimulationDescription().getCurrentStep()` in this loop
              */
-            while (currentStep < Environment<>::get().SimulationDescription().getRunSteps())
+            while (currentStep < Environment<>::get().SimulationDescription().getRunSteps() &&
+                   !stopRequested)
             {
                 tRound.toggleStart();
-                runOneStep(currentStep);
+                {
+                    simulationControl::ProfilePhase phase("runOneStep");
+                    runOneStep(currentStep);
+                }
+                {
+                    /* the host snapshot of the last step is freed for the
+                     * moving window and the next dump */
+                    simulationControl::ProfilePhase phase("concurrentPlugins");
+                    Environment<DIM>::get().PluginConnector().waitForConcurrentPlugins();
+                }
                 tRound.toggleEnd();
                 roundAvg += tRound.getInterval();
 
@@ -268,13 +356,21 @@ public:
                 /*output after a round*/
                 dumpTimes(tSimCalculation, tRound, roundAvg, currentStep);
 
-                movingWindowCheck(currentStep);
+                {
+                    simulationControl::ProfilePhase phase("movingWindow");
+                    movingWindowCheck(currentStep);
+                }
                 /*dump after simulated step*/
-                dumpOneStep(currentStep);
+                {
+                    simulationControl::ProfilePhase phase("dump");
+                    dumpOneStep(currentStep);
+                }
             }
 
             // simulatation end
             Environment<>::get().Manager().waitForAllTasks();
+            Environment<DIM>::get().PluginConnector().waitForConcurrentPlugins();
+            finishCheckpoint(true);
 
             tSimCalculation.toggleEnd();
 
@@ -286,6 +382,11 @@ public:
             }
 
         } // softRestarts loop
+
+        MPI_Comm comm = getGridController().getCommunicator().getMPIComm();
+        Environment<DIM>::get().Profiler().writeStatistics(profileFile, comm);
+        if (!profileTrace.empty())
+            Environment<DIM>::get().Profiler().writeTrace(profileTrace, comm);
     }
 
     virtual void pluginRegisterHelp(po::options_description& desc)
@@ -304,6 +405,30 @@ public:
             ("checkpoints", po::value<uint32_t>(&checkpointPeriod), "Period for checkpoint creation")
             ("checkpoint-directory", po::value<std::string>(&checkpointDirectory)->default_value(checkpointDirectory),
              "Directory for checkpoints")
+            ("checkpoint-async", po::value<bool>(&checkpointAsync)->zero_tokens(),
+             "Write checkpoints in the background while the simulation continues")
+            ("checkpoint-timeperiod", po::value<uint32_t>(&checkpointTimePeriod),
+             "Create a checkpoint at the latest after this wall clock time [minutes]")
+            ("checkpoint-deadline", po::value<uint32_t>(&checkpointDeadline),
+             "Wall clock time reserved for the job [minutes], a final checkpoint is created "
+             "before it ends and the simulation is stopped afterwards")
+            ("checkpoint-cost", po::value<uint32_t>(&checkpointCostEstimate),
+             "Expected wall clock time to write a checkpoint [minutes], kept free before "
+             "--checkpoint-deadline until a checkpoint was measured (default: 10% of the deadline)")
+            ("plugins-concurrent", po::value<uint32_t>(&concurrentPluginWorkers)->default_value(0),
+             "Number of threads for plugins which support concurrent notifications, "
+             "they are executed while the next step is computed (0: notify all plugins in order)")
+            ("profile", po::value<bool>(&profile)->zero_tokens(),
+             "Measure the time of the phases of each step and of each plugin, "
+             "the statistics over all ranks are written to --profile-file")
+            ("profile-file", po::value<std::string>(&profileFile)->default_value(profileFile),
+             "JSON file for the time statistics of --profile")
+            ("profile-sync", po::value<bool>(&profileSync)->zero_tokens(),
+             "Wait for all device work at the end of each profiled phase "
+             "(device time is assigned to the phase, but phases do not overlap anymore)")
+            ("profile-trace", po::value<std::string>(&profileTrace)->default_value(profileTrace),
+             "Write all profiled phases of all ranks to this file in Chrome trace format "
+             "(memory grows with the number of steps)")
             ("author", po::value<std::string>(&author)->default_value(std::string("")),
              "The author that runs the simulation and is responsible for created output files");
     }
@@ -317,14 +442,47 @@ public:
     {
         Environment<>::get().SimulationDescription().setRunSteps(runSteps);
         Environment<>::get().SimulationDescription().setAuthor(author);
+        Environment<>::get().SimulationDescription().setCheckpointAsync(checkpointAsync);
 
         calcProgress();
 
         output = (getGridController().getGlobalRank() == 0);
+
+        if (profile || profileSync || !profileTrace.empty())
+            Environment<DIM>::get().Profiler().enable(profileSync, !profileTrace.empty());
+
+        if (checkpointAsync)
+        {
+            /* the confirmation of background checkpoints is posted at
+             * different points of the time loop on each rank, a separate
+             * communicator keeps it apart from all other collectives */
+            MPI_CHECK(MPI_Comm_dup(getGridController().getCommunicator().getMPIComm(),
+                                   &checkpointComm));
+        }
+
+        if (concurrentPluginWorkers != 0)
+        {
+            /* plugins with MPI collectives can only run in a worker if MPI
+             * can be called concurrently to the simulation */
+            int threadLevel;
+            MPI_CHECK(MPI_Query_thread(&threadLevel));
+            const bool allowCollectives = (threadLevel >= MPI_THREAD_MULTIPLE);
+            if (!allowCollectives && output)
+            {
+                std::cout << "MPI_THREAD_MULTIPLE is not supported, plugins calling "
+                    "MPI collectives are notified in order" << std::endl;
+            }
+            Environment<DIM>::get().PluginConnector().startConcurrentWorkers(
+                concurrentPluginWorkers, allowCollectives);
+        }
     }
 
     void pluginUnload()
     {
+        if (checkpointComm != MPI_COMM_NULL)
+        {
+            MPI_CHECK(MPI_Comm_free(&checkpointComm));
+        }
     }
 
     void restart(uint32_t, const std::string)
@@ -361,6 +519,29 @@ protected:
     /* restart requested */
     bool restartRequested;
 
+    /* write checkpoints in the background */
+    bool checkpointAsync;
+
+    /* maximal wall clock time between two checkpoints in minutes */
+    uint32_t checkpointTimePeriod;
+
+    /* wall clock time since program start in minutes, at which the job ends */
+    uint32_t checkpointDeadline;
+
+    /* expected time in minutes to write a checkpoint, 0 estimates it from
+     * checkpointDeadline */
+    uint32_t checkpointCostEstimate;
+
+    /* number of threads for concurrent plugin notifications */
+    uint32_t concurrentPluginWorkers;
+
+    /* measure the phases of each step, see simulationControl::Profiler */
+    bool profile;
+    std::string profileFile;
+    bool profileSync;
+    /* file for a Chrome trace, empty if disabled */
+    std::string profileTrace;
+
     /* filename for checkpoint master file with all checkpoint timesteps */
     const std::string CHECKPOINT_MASTER_FILE;
 
@@ -369,6 +550,218 @@ protected:
 
 private:
 
+    /**
+     * Commit an asynchronously written checkpoint
+     *
+     * As soon as all local plugins finished writing, their writers are joined
+     * and a non-blocking reduction of the failure flags is posted. After all
+     * ranks took part, the checkpoint is appended to the master file if no
+     * rank failed to write it.
+     *
+     * @param wait block until the pending checkpoint is committed
+     */
+    void finishCheckpoint(bool wait)
+    {
+        if (!pendingCheckpoint)
+            return;
+
+        PluginConnector& pluginConnector = Environment<DIM>::get().PluginConnector();
+        int finished = 0;
+
+#if (MPI_VERSION >= 3)
+        if (checkpointRequest == MPI_REQUEST_NULL)
+        {
+            if (!wait && pluginConnector.isCheckpointPending())
+                return;
+
+            /* returns immediately if the writers are done already */
+            checkpointLocalFailed = pluginConnector.waitForCheckpoints() ? 0 : 1;
+            MPI_CHECK(MPI_Iallreduce(&checkpointLocalFailed, &checkpointGlobalFailed, 1,
+                                     MPI_INT, MPI_LOR, checkpointComm, &checkpointRequest));
+        }
+
+        if (wait)
+        {
+            MPI_CHECK(MPI_Wait(&checkpointRequest, MPI_STATUS_IGNORE));
+            finished = 1;
+        }
+        else
+            MPI_CHECK(MPI_Test(&checkpointRequest, &finished, MPI_STATUS_IGNORE));
+#else
+        /* without a non-blocking reduction the commit is deferred to the
+         * next point where all ranks wait anyway */
+        if (!wait)
+            return;
+
+        checkpointLocalFailed = pluginConnector.waitForCheckpoints() ? 0 : 1;
+        MPI_CHECK(MPI_Allreduce(&checkpointLocalFailed, &checkpointGlobalFailed, 1,
+                                MPI_INT, MPI_LOR, checkpointComm));
+        finished = 1;
+#endif
+
+        if (finished)
+        {
+            /* MPI_Wait and MPI_Test reset the request to MPI_REQUEST_NULL */
+            if (getGridController().getGlobalRank() == 0)
+            {
+                if (checkpointGlobalFailed)
+                    std::cerr << "Error: asynchronous checkpoint at step " << pendingCheckpointStep
+                        << " failed on at least one rank and is not usable for a restart" << std::endl;
+                else
+                    writeCheckpointStep(pendingCheckpointStep);
+            }
+            pendingCheckpoint = false;
+            checkpointCost = TimeIntervall::getTime() - checkpointStartTime;
+        }
+    }
+
+    /**
+     * Number of steps which fit into a wall clock time
+     *
+     * @param remainingTime time in msec
+     * @param stepTime average time per step in msec
+     */
+    static uint32_t stepsWithin(const double remainingTime, const double stepTime)
+    {
+        if (remainingTime <= 0.0)
+            return 0;
+        const double steps = remainingTime / stepTime;
+        if (steps >= double(std::numeric_limits<uint32_t>::max()))
+            return std::numeric_limits<uint32_t>::max();
+        return uint32_t(steps);
+    }
+
+    /**
+     * Add \p steps to \p currentStep without overflow
+     */
+    static uint32_t addSteps(const uint32_t currentStep, const uint32_t steps)
+    {
+        if (steps > std::numeric_limits<uint32_t>::max() - currentStep)
+            return std::numeric_limits<uint32_t>::max();
+        return currentStep + steps;
+    }
+
+    /**
+     * Restart the measurement of the average step time
+     *
+     * @param currentStep step from which on the time is measured
+     */
+    void resetSchedule(const uint32_t currentStep)
+    {
+        lastScheduleStep = currentStep;
+        lastScheduleTime = TimeIntervall::getTime();
+        nextScheduleStep = addSteps(currentStep, 1);
+    }
+
+    /**
+     * Expected wall clock time of the next checkpoint in msec
+     *
+     * Before the first checkpoint was measured, the time given with
+     * --checkpoint-cost or else a tenth of the deadline is assumed, so that
+     * the final checkpoint of a job without earlier checkpoints still fits.
+     */
+    double getCheckpointCost() const
+    {
+        if (checkpointCost >= 0.0)
+            return checkpointCost;
+        if (checkpointCostEstimate != 0)
+            return double(checkpointCostEstimate) * 60000.;
+        return 0.1 * double(checkpointDeadline) * 60000.;
+    }
+
+    /**
+     * Predict the steps of the next time based checkpoints
+     *
+     * The average wall clock time per step (including all plugins, but
+     * without checkpoints) is measured since the last schedule. The
+     * prediction is agreed on by all ranks with an allreduce, it is
+     * refreshed halfway to the predicted checkpoint to follow changes of the
+     * step time.
+     *
+     * @param currentStep current simulation step
+     */
+    void scheduleCheckpoints(const uint32_t currentStep)
+    {
+        const double now = TimeIntervall::getTime();
+
+        if (currentStep == lastScheduleStep)
+        {
+            nextScheduleStep = addSteps(currentStep, 1);
+            return;
+        }
+        const double stepTime = (now - lastScheduleTime) / double(currentStep - lastScheduleStep);
+
+        /* 0: time period, 1: deadline */
+        uint32_t steps[2] = {std::numeric_limits<uint32_t>::max(),
+                             std::numeric_limits<uint32_t>::max()};
+
+        if (checkpointTimePeriod != 0)
+        {
+            const double periodEnd = lastCheckpointTime + double(checkpointTimePeriod) * 60000.;
+            steps[0] = stepsWithin(periodEnd - now, stepTime);
+        }
+        if (checkpointDeadline != 0 && nextDeadlineCheckpointStep != 0)
+        {
+            /* the final checkpoint must be finished before the deadline,
+             * keep the cost of the last checkpoint and one step as margin */
+            const double deadline = startTime + double(checkpointDeadline) * 60000.;
+            steps[1] = stepsWithin(deadline - now - getCheckpointCost() - stepTime, stepTime);
+        }
+
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, steps, 2, MPI_UINT32_T, MPI_MIN,
+                                getGridController().getCommunicator().getMPIComm()));
+
+        nextTimedCheckpointStep = addSteps(currentStep, steps[0]);
+        if (nextDeadlineCheckpointStep != 0)
+            nextDeadlineCheckpointStep = addSteps(currentStep, steps[1]);
+
+        const uint32_t nextCheckpoint = std::min(steps[0], steps[1]);
+        lastScheduleStep = currentStep;
+        lastScheduleTime = now;
+        nextScheduleStep = addSteps(currentStep, std::max(nextCheckpoint / 2u, 1u));
+    }
+
+    /**
+     * Check if a time based checkpoint must be created
+     *
+     * @param currentStep current simulation step
+     * @return true if all ranks scheduled a checkpoint for this step
+     */
+    bool isScheduledCheckpoint(const uint32_t currentStep)
+    {
+        if (checkpointTimePeriod == 0 && checkpointDeadline == 0)
+            return false;
+
+        if (currentStep >= nextScheduleStep)
+            scheduleCheckpoints(currentStep);
+
+        return currentStep >= nextTimedCheckpointStep ||
+            (nextDeadlineCheckpointStep != 0 && currentStep >= nextDeadlineCheckpointStep);
+    }
+
+    /**
+     * Update the schedule for a checkpoint which is created now
+     *
+     * @param currentStep current simulation step
+     */
+    void onCheckpointStarted(const uint32_t currentStep)
+    {
+        lastCheckpointTime = checkpointStartTime;
+        nextTimedCheckpointStep = std::numeric_limits<uint32_t>::max();
+
+        if (nextDeadlineCheckpointStep != 0 && currentStep >= nextDeadlineCheckpointStep)
+        {
+            /* 0 marks that the final checkpoint is written */
+            nextDeadlineCheckpointStep = 0;
+            stopRequested = true;
+            if (output)
+            {
+                std::cout << "final checkpoint before deadline at step " << currentStep <<
+                    ", simulation is stopped afterwards" << std::endl;
+            }
+        }
+    }
+
     /**
      * Set how often the elapsed time is printed.
      *
@@ -454,6 +847,38 @@ private:
     TimeIntervall tSimulation;
     TimeIntervall tInit;
 
+    /* an asynchronous checkpoint was started but is not yet committed */
+    bool pendingCheckpoint;
+    uint32_t pendingCheckpointStep;
+
+    /* communicator and request to confirm asynchronous checkpoints */
+    MPI_Comm checkpointComm;
+    MPI_Request checkpointRequest;
+    /* failure flags of the asynchronous checkpoint (local and or-reduced),
+     * buffers of the non-blocking reduction */
+    int checkpointLocalFailed;
+    int checkpointGlobalFailed;
+
+    /* wall clock times in msec for time based checkpoints */
+    double startTime;
+    double checkpointStartTime;
+    /* measured time of the last checkpoint, negative before the first one */
+    double checkpointCost;
+    double lastCheckpointTime;
+
+    /* steps of the predicted checkpoints, the deadline step is 0 after the
+     * final checkpoint was created */
+    uint32_t nextTimedCheckpointStep;
+    uint32_t nextDeadlineCheckpointStep;
+
+    /* steps at which the prediction is refreshed and was last refreshed */
+    uint32_t nextScheduleStep;
+    uint32_t lastScheduleStep;
+    double lastScheduleTime;
+
+    /* stop the time loop after the final checkpoint before the deadline */
+    bool stopRequested;
+
 };
 
 } // namespace PMacc
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STL
+#include <stdint.h> /* uint32_t */
+#include <string>
+#include <vector>
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// PMacc
+#include <Environment.hpp>
+#include <eventSystem/EventSystem.hpp>
+#include "pmacc_types.hpp"
+
+
+/*******************************************************************************
+ * Configuration
+ ******************************************************************************/
+
+/* MPI and the environment are initialized by the global fixture in
+ * "test/memory/memoryUT.cu"
+ */
+
+/**
+ * Task which is finished after it was polled `numPolls` times.
+ */
+class PollTask : public ::PMacc::ITask
+{
+public:
+
+    PollTask(uint32_t numPolls) : remainingPolls(numPolls)
+    {
+        setTaskType(::PMacc::ITask::TASK_HOST);
+    }
+
+    void init()
+    {
+    }
+
+    void event(::PMacc::id_t, ::PMacc::EventType, ::PMacc::IEventData*)
+    {
+    }
+
+    std::string toString()
+    {
+        return "PollTask";
+    }
+
+protected:
+
+    bool executeIntern()
+    {
+        if (remainingPolls == 0)
+            return true;
+        --remainingPolls;
+        return false;
+    }
+
+    uint32_t remainingPolls;
+};
+
+/**
+ * Adds `numTasks` PollTasks which need up to `maxPolls` polls to finish while
+ * the manager is executed in between, like during a simulation step.
+ *
+ * @return ids of all added tasks
+ */
+std::vector< ::PMacc::id_t > runPollTasks(uint32_t numTasks, uint32_t maxPolls)
+{
+    ::PMacc::Manager& manager = ::PMacc::Environment<>::get().Manager();
+
+    std::vector< ::PMacc::id_t > taskIds;
+    taskIds.reserve(numTasks);
+    for (uint32_t i = 0; i < numTasks; ++i)
+    {
+        PollTask* task = new PollTask(i % (maxPolls + 1));
+        task->init();
+        manager.addTask(task);
+        taskIds.push_back(task->getId());
+        /* keep a realistic number of tasks alive (like a simulation step) */
+        if (i % 64 == 63)
+            manager.execute();
+    }
+    manager.waitForAllTasks();
+    return taskIds;
+}
+
+/**
+ * Times runPollTasks() to measure the task bookkeeping (add, poll, lookup,
+ * delete).
+ *
+ * @return number of tasks per second
+ */
+double measureTaskThroughput(uint32_t numTasks, uint32_t maxPolls)
+{
+    namespace pt = boost::posix_time;
+
+    pt::ptime start = pt::microsec_clock::local_time();
+    runPollTasks(numTasks, maxPolls);
+    pt::time_duration duration = pt::microsec_clock::local_time() - start;
+
+    const double seconds = static_cast<double>(duration.total_microseconds()) * 1.0e-6;
+    return seconds > 0. ? static_cast<double>(numTasks) / seconds : 0.;
+}
+
+
+/*******************************************************************************
+ * Test Suites
+ ******************************************************************************/
+BOOST_AUTO_TEST_SUITE( eventSystem )
+
+  BOOST_AUTO_TEST_SUITE( Manager )
+
+  /**
+   * Checks that every added task is finished and can not be found anymore.
+   */
+  BOOST_AUTO_TEST_CASE( finishAllTasks ){
+      ::PMacc::Manager& manager = ::PMacc::Environment<>::get().Manager();
+
+      std::vector< ::PMacc::EventTask > events;
+      for (uint32_t i = 0; i < 5000; ++i)
+      {
+          PollTask* task = new PollTask(i % 7);
+          task->init();
+          manager.addTask(task);
+          events.push_back(::PMacc::EventTask(task->getId()));
+      }
+
+      /* wait for a task in the middle first, than for all others */
+      events[2500].waitForFinished();
+      BOOST_CHECK( events[2500].isFinished() );
+
+      manager.waitForAllTasks();
+      for (size_t i = 0; i < events.size(); ++i)
+          BOOST_CHECK( manager.getITaskIfNotFinished(events[i].getTaskId()) == NULL );
+  }
+
+  /**
+   * Checks that tasks added while the manager is executed (nested polling
+   * of the task list) are all finished and removed from the manager.
+   */
+  BOOST_AUTO_TEST_CASE( interleavedExecute ){
+      ::PMacc::Manager& manager = ::PMacc::Environment<>::get().Manager();
+
+      const std::vector< ::PMacc::id_t > taskIds = runPollTasks(100000, 3);
+      BOOST_CHECK_EQUAL( taskIds.size(), 100000u );
+
+      uint32_t numUnfinished = 0;
+      for (size_t i = 0; i < taskIds.size(); ++i)
+          if (manager.getITaskIfNotFinished(taskIds[i]) != NULL)
+              ++numUnfinished;
+      BOOST_CHECK_EQUAL( numUnfinished, 0u );
+      BOOST_CHECK_EQUAL( manager.getCount(), 0u );
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
+
+  /* micro benchmarks, they only report and never fail
+   *
+   * run with `--run_test=eventSystem/Benchmark --log_level=message`
+   */
+  BOOST_AUTO_TEST_SUITE( Benchmark )
+
+  /**
+   * Reports the throughput of the task bookkeeping in tasks per second.
+   */
+  BOOST_AUTO_TEST_CASE( taskThroughput ){
+      const double tasksPerSecond = measureTaskThroughput(1000000, 3);
+      BOOST_TEST_MESSAGE( "event system throughput: " << tasksPerSecond << " tasks/s" );
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
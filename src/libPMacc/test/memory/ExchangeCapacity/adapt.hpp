@@ -0,0 +1,89 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* #includes in "test/memoryUT.cu" */
+
+/**
+ * Checks the capacity of a particle exchange stack:
+ * growth to 1.5 times the particles of a transfer, the limits,
+ * the shrinking to twice the high-water mark and the hysteresis.
+ */
+BOOST_AUTO_TEST_CASE( grow ){
+    ::PMacc::ExchangeCapacity capacity(10, 10000);
+
+    BOOST_CHECK_EQUAL(capacity.adapt(100, 200), static_cast<size_t>(300));
+    BOOST_CHECK_EQUAL(capacity.adapt(300, 300), static_cast<size_t>(300));
+
+}
+
+BOOST_AUTO_TEST_CASE( limits ){
+    ::PMacc::ExchangeCapacity capacity(10, 1000);
+
+    BOOST_CHECK_EQUAL(capacity.adapt(100, 800), static_cast<size_t>(1000));
+    BOOST_CHECK_EQUAL(capacity.adapt(1000, 5000), static_cast<size_t>(1000));
+    BOOST_CHECK_EQUAL(capacity.getMaxCapacity(), static_cast<size_t>(1000));
+
+    ::PMacc::ExchangeCapacity empty(10, 1000);
+    BOOST_CHECK_EQUAL(empty.adapt(10, 0), static_cast<size_t>(10));
+    BOOST_CHECK_EQUAL(empty.adapt(100, 0), static_cast<size_t>(10));
+
+    /* the limit is never below the minimum */
+    ::PMacc::ExchangeCapacity clamped(10, 5);
+    BOOST_CHECK_EQUAL(clamped.getMaxCapacity(), static_cast<size_t>(10));
+
+}
+
+BOOST_AUTO_TEST_CASE( shrink ){
+    ::PMacc::ExchangeCapacity capacity(10, 10000);
+
+    BOOST_CHECK_EQUAL(capacity.adapt(1000, 100), static_cast<size_t>(200));
+
+}
+
+BOOST_AUTO_TEST_CASE( hysteresis ){
+    ::PMacc::ExchangeCapacity capacity(10, 10000);
+
+    /* between two and four times the high-water mark the stack keeps its size */
+    BOOST_CHECK_EQUAL(capacity.adapt(300, 100), static_cast<size_t>(300));
+    BOOST_CHECK_EQUAL(capacity.adapt(300, 150), static_cast<size_t>(300));
+    BOOST_CHECK_EQUAL(capacity.adapt(300, 80), static_cast<size_t>(300));
+
+}
+
+BOOST_AUTO_TEST_CASE( decay ){
+    ::PMacc::ExchangeCapacity capacity(10, 10000);
+
+    BOOST_CHECK_EQUAL(capacity.adapt(1500, 1000), static_cast<size_t>(1500));
+
+    /* 0.99^k * 1000 drops below 1500 / 4 after 98 empty transfers */
+    for(int i = 1; i < 98; ++i){
+        BOOST_CHECK_EQUAL(capacity.adapt(1500, 0), static_cast<size_t>(1500));
+    }
+    BOOST_CHECK_CLOSE(capacity.getHighWaterMark(), 1000.0 * std::pow(0.99, 97), 1.0e-6);
+
+    const size_t shrunk = capacity.adapt(1500, 0);
+    BOOST_CHECK_EQUAL(shrunk, static_cast<size_t>(2.0 * capacity.getHighWaterMark()));
+    BOOST_CHECK_LT(shrunk, static_cast<size_t>(1500));
+
+}
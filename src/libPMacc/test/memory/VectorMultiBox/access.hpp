@@ -0,0 +1,80 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* #includes in "test/memoryUT.cu" */
+
+/**
+ * Checks that a VectorMultiBox writes each component into its own plane and
+ * that shifted boxes reference the same memory.
+ */
+struct AccessTest {
+
+    template<typename T_Dim>
+    void operator()(T_Dim){
+
+        typedef ::PMacc::math::Vector<float, 3> Data;
+        typedef ::PMacc::DataBox< ::PMacc::VectorMultiBox<Data, T_Dim::value> > Box;
+
+        ::PMacc::DataSpace<T_Dim::value> const dataSpace = ::PMacc::DataSpace<T_Dim::value>::create(4);
+        size_t const numElements = static_cast<size_t>(dataSpace.productOfComponents());
+        size_t const pitch = dataSpace[0] * sizeof(float);
+        size_t const attributePitch = numElements * sizeof(float);
+
+        std::vector<float> memory(Data::dim * numElements, 0.0f);
+        Box box(::PMacc::VectorMultiBox<Data, T_Dim::value>(&(memory[0]),
+                                                             ::PMacc::DataSpace<T_Dim::value>(),
+                                                             dataSpace,
+                                                             pitch,
+                                                             attributePitch));
+
+        ::PMacc::DataSpace<T_Dim::value> const cell = ::PMacc::DataSpace<T_Dim::value>::create(1);
+        size_t linearCell = 0;
+        for(int d = T_Dim::value - 1; d >= 0; --d)
+            linearCell = linearCell * dataSpace[d] + cell[d];
+
+        box(cell) = Data(1.0f, 2.0f, 3.0f);
+        box(cell) += Data(1.0f, 1.0f, 1.0f);
+        box(cell) *= 2.0f;
+
+        for(int c = 0; c < Data::dim; ++c){
+            BOOST_CHECK_EQUAL( memory[c * numElements + linearCell], 2.0f * (c + 2.0f) );
+        }
+
+        Box const shifted = box.shift(cell);
+        Data const value = shifted(::PMacc::DataSpace<T_Dim::value>());
+        BOOST_CHECK_EQUAL( value.x(), 4.0f );
+        BOOST_CHECK_EQUAL( value.y(), 6.0f );
+        BOOST_CHECK_EQUAL( value.z(), 8.0f );
+
+        /* copy between two cells */
+        box(::PMacc::DataSpace<T_Dim::value>()) = shifted(::PMacc::DataSpace<T_Dim::value>());
+        BOOST_CHECK_EQUAL( memory[2 * numElements], 8.0f );
+    }
+
+};
+
+BOOST_AUTO_TEST_CASE( access ){
+    ::boost::mpl::for_each< Dims >( AccessTest() );
+
+}
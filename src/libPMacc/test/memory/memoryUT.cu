@@ -41,6 +41,10 @@
 #include <memory/buffers/HostBuffer.hpp>
 #include <memory/buffers/DeviceBufferIntern.hpp>
 #include <memory/buffers/DeviceBuffer.hpp>
+#include <memory/boxes/DataBox.hpp>
+#include <memory/boxes/VectorMultiBox.hpp>
+#include <particles/memory/buffers/ExchangeCapacity.hpp>
+#include <math/Vector.hpp>
 #include <dimensions/DataSpace.hpp>
 #include "pmacc_types.hpp" /* DIM1,DIM2,DIM3 */
 
@@ -128,4 +132,12 @@ BOOST_AUTO_TEST_SUITE( memory )
   #include "HostBufferIntern/setValue.hpp"
   BOOST_AUTO_TEST_SUITE_END()
 
+  BOOST_AUTO_TEST_SUITE( VectorMultiBox )
+  #include "VectorMultiBox/access.hpp"
+  BOOST_AUTO_TEST_SUITE_END()
+
+  BOOST_AUTO_TEST_SUITE( ExchangeCapacity )
+  #include "ExchangeCapacity/adapt.hpp"
+  BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
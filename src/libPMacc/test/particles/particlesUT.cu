@@ -0,0 +1,141 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STL
+#include <vector>
+#include <cmath>
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+
+// PMacc
+#include <particles/operations/MergeToPair.hpp>
+#include "pmacc_types.hpp"
+
+
+/*******************************************************************************
+ * Configuration
+ ******************************************************************************/
+
+/**
+ * Merges a group of particles to a pair and checks that the weighting,
+ * the momentum and the kinetic energy of the group are conserved.
+ *
+ * The group is a deterministic set of weightings and momenta (per real
+ * particle) around meanMom with the spread `spread`.
+ */
+template<bool T_isMassless>
+void checkMergeConservation(const double mass, const double meanMom, const double spread)
+{
+    typedef ::PMacc::particles::operations::MergeToPair<double, T_isMassless> Merge;
+    typedef typename Merge::Float3 Float3;
+
+    const double speedOfLight = 1.0;
+    const Merge merge(mass, speedOfLight);
+
+    std::vector<double> weighting;
+    std::vector<Float3> mom;
+    for (int i = 0; i < 17; ++i)
+    {
+        weighting.push_back(1.0 + 0.25 * double(i % 5));
+        mom.push_back(Float3(meanMom + spread * std::sin(double(i)),
+                             spread * std::cos(double(3 * i)),
+                             -0.5 * meanMom + spread * std::sin(double(7 * i))));
+    }
+
+    double sumWeighting = 0.0;
+    Float3 sumMom(Float3::create(0.0));
+    double sumEnergy = 0.0;
+    for (size_t i = 0; i < weighting.size(); ++i)
+    {
+        sumWeighting += weighting[i];
+        sumMom = sumMom + weighting[i] * mom[i];
+        sumEnergy += weighting[i] * merge.getKineticEnergy(mom[i]);
+    }
+
+    const double newWeighting = 0.5 * sumWeighting;
+    Float3 newSumMom(Float3::create(0.0));
+    double newSumEnergy = 0.0;
+    for (int rank = 0; rank < 2; ++rank)
+    {
+        const Float3 newMom = merge(sumMom / sumWeighting, sumEnergy / sumWeighting, rank);
+        newSumMom = newSumMom + newWeighting * newMom;
+        newSumEnergy += newWeighting * merge.getKineticEnergy(newMom);
+    }
+
+    const double tolerance = 1.0e-9;
+    const double momScale = std::sqrt(sumMom.x() * sumMom.x() + sumMom.y() * sumMom.y() + sumMom.z() * sumMom.z()) +
+        sumWeighting * spread;
+    BOOST_CHECK_CLOSE( 2.0 * newWeighting, sumWeighting, tolerance );
+    for (uint32_t d = 0; d < 3; ++d)
+        BOOST_CHECK_SMALL( newSumMom[d] - sumMom[d], tolerance * momScale );
+    BOOST_CHECK_CLOSE( newSumEnergy, sumEnergy, tolerance );
+}
+
+
+/*******************************************************************************
+ * Test Suites
+ ******************************************************************************/
+
+BOOST_AUTO_TEST_SUITE( particles )
+
+/**
+ * Non-relativistic and relativistic groups of massive particles.
+ */
+BOOST_AUTO_TEST_CASE( mergeToPairMassive )
+{
+    checkMergeConservation<false>(1.0, 1.0e-3, 1.0e-4);
+    checkMergeConservation<false>(1.0, 0.5, 0.2);
+    checkMergeConservation<false>(1.0, 20.0, 5.0);
+    /* all momenta around zero */
+    checkMergeConservation<false>(1.0, 0.0, 0.1);
+}
+
+/**
+ * Massless particles (photons), the energy is |p| * c.
+ */
+BOOST_AUTO_TEST_CASE( mergeToPairMassless )
+{
+    checkMergeConservation<true>(0.0, 1.0, 0.2);
+    checkMergeConservation<true>(0.0, 20.0, 5.0);
+}
+
+/**
+ * The direction of the momentum difference of the pair is perpendicular
+ * to the mean momentum and has unit length.
+ */
+BOOST_AUTO_TEST_CASE( mergeToPairPerpendicular )
+{
+    typedef ::PMacc::particles::operations::MergeToPair<double, false> Merge;
+    typedef Merge::Float3 Float3;
+
+    const Float3 vectors[3] = {Float3(1.0, 2.0, 3.0), Float3(0.0, 0.0, -4.0), Float3(0.0, 0.0, 0.0)};
+    for (int i = 0; i < 3; ++i)
+    {
+        const Float3 perp = Merge::getPerpendicularDirection(vectors[i]);
+        const double dot = perp.x() * vectors[i].x() + perp.y() * vectors[i].y() + perp.z() * vectors[i].z();
+        BOOST_CHECK_SMALL( dot, 1.0e-12 );
+        BOOST_CHECK_CLOSE( perp.x() * perp.x() + perp.y() * perp.y() + perp.z() * perp.z(), 1.0, 1.0e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
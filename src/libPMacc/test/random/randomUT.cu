@@ -0,0 +1,182 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STL
+#include <stdint.h> /* uint32_t */
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// PMacc
+#include <nvidia/rng/RNG.hpp>
+#include <nvidia/rng/methods/Philox.hpp>
+#include <nvidia/rng/distributions/UniformFromBits_float.hpp>
+#include "pmacc_types.hpp"
+
+
+/**
+ * Philox generator which returns the raw words of its stream on the host.
+ */
+struct PhiloxStream : public ::PMacc::nvidia::rng::methods::Philox
+{
+    PhiloxStream(uint32_t seed, uint32_t subsequence, uint32_t stream) :
+        ::PMacc::nvidia::rng::methods::Philox(seed, subsequence, stream)
+    {
+    }
+
+    uint32_t operator()()
+    {
+        return this->getState()();
+    }
+};
+
+/**
+ * Monte Carlo creation decision of particle creators (ionization, photons):
+ * each cell draws from its own stream (supercell index and cell in the
+ * supercell select the stream, like creation::RandomNrForMonteCarlo) and a
+ * new particle is created if the number is below `probability`.
+ *
+ * @param[out] seconds wall clock time of the decisions
+ * @return number of created particles
+ */
+uint64_t runCreationDecisions(uint32_t numSuperCells, uint32_t cellsPerSuperCell,
+                              float probability, double& seconds)
+{
+    namespace pt = boost::posix_time;
+    ::PMacc::nvidia::rng::distributions::UniformFromBits_float dist;
+
+    uint64_t numCreated = 0;
+    pt::ptime start = pt::microsec_clock::local_time();
+    for (uint32_t superCell = 0; superCell < numSuperCells; ++superCell)
+        for (uint32_t cell = 0; cell < cellsPerSuperCell; ++cell)
+        {
+            PhiloxStream stream(42u, superCell, cell);
+            if (dist(stream) < probability)
+                ++numCreated;
+        }
+    pt::time_duration duration = pt::microsec_clock::local_time() - start;
+
+    seconds = static_cast<double>(duration.total_microseconds()) * 1.0e-6;
+    return numCreated;
+}
+
+
+/*******************************************************************************
+ * Test Suites
+ ******************************************************************************/
+
+BOOST_AUTO_TEST_SUITE( random )
+
+/**
+ * Known answer tests of the Random123 reference implementation:
+ * counter (four words) and key (two words) followed by the result.
+ */
+BOOST_AUTO_TEST_CASE( philoxKnownAnswer )
+{
+    typedef ::PMacc::nvidia::rng::methods::Philox Philox;
+
+    const uint32_t kat[3][10] = {
+        {0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u,
+         0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+        {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu,
+         0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+        {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, 0xa4093822u, 0x299f31d0u,
+         0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}
+    };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        uint32_t result[4];
+        Philox::generate(kat[i] + 4, kat[i], result);
+        for (int w = 0; w < 4; ++w)
+            BOOST_CHECK_EQUAL( result[w], kat[i][6 + w] );
+    }
+}
+
+/**
+ * A stream returns the words of consecutive counters in order and
+ * the float distribution stays within [0.0,1.0).
+ */
+BOOST_AUTO_TEST_CASE( philoxStream )
+{
+    namespace nvrng = ::PMacc::nvidia::rng;
+    typedef nvrng::methods::Philox Philox;
+
+    const uint32_t key[2] = {42u, 7u};
+    PhiloxStream stream(key[0], key[1], 3u);
+    for (uint32_t draw = 0; draw < 3u; ++draw)
+    {
+        const uint32_t counter[4] = {draw, 0u, 3u, 0u};
+        uint32_t expected[4];
+        Philox::generate(key, counter, expected);
+        for (int w = 0; w < 4; ++w)
+            BOOST_CHECK_EQUAL( stream(), expected[w] );
+    }
+
+    nvrng::distributions::UniformFromBits_float dist;
+    PhiloxStream other(key[0], key[1], 4u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float r = dist(other);
+        BOOST_CHECK( r >= 0.0f );
+        BOOST_CHECK( r < 1.0f );
+    }
+}
+
+/* micro benchmarks, they only report the rate
+ *
+ * run with `--run_test=random/Benchmark --log_level=message`
+ */
+BOOST_AUTO_TEST_SUITE( Benchmark )
+
+/**
+ * Reports the rate of Monte Carlo creation decisions and of created
+ * particles, the random numbers bound the creation rate of the ionization
+ * and photon creators on host accelerators.
+ */
+BOOST_AUTO_TEST_CASE( creationThroughput )
+{
+    /* 256 cells per supercell like a 8x8x4 supercell */
+    const uint32_t numSuperCells = 4096u;
+    const uint32_t cellsPerSuperCell = 256u;
+    const float probability = 0.5f;
+
+    double seconds = 0.;
+    const uint64_t numCreated = runCreationDecisions(numSuperCells, cellsPerSuperCell,
+                                                     probability, seconds);
+    const double numDecisions = double(numSuperCells) * double(cellsPerSuperCell);
+
+    /* the streams are independent: the fraction of created particles
+     * matches the probability */
+    BOOST_CHECK_CLOSE( double(numCreated) / numDecisions, double(probability), 1.0 );
+
+    if (seconds > 0.)
+    {
+        BOOST_TEST_MESSAGE( "creation decisions: " << numDecisions / seconds << " cells/s" );
+        BOOST_TEST_MESSAGE( "created particles: " << double(numCreated) / seconds << " particles/s" );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
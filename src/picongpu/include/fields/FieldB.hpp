@@ -39,6 +39,7 @@
 #include "memory/buffers/GridBuffer.hpp"
 #include "mappings/simulation/GridController.hpp"
 #include "fields/LaserPhysics.def"
+#include "fields/FieldStorage.hpp"
 #include "memory/boxes/DataBox.hpp"
 #include "memory/boxes/PitchedBox.hpp"
 
@@ -56,7 +57,11 @@ namespace picongpu
         typedef promoteType<float_64, ValueType>::type UnitValueType;
         BOOST_STATIC_CONSTEXPR int numComponents = ValueType::dim;
 
-        typedef DataBox<PitchedBox<ValueType, simDim> > DataBoxType;
+        /** memory of the field, layout selected by EMFieldLayout (fieldSolver.param) */
+        typedef fieldLayout::FieldStorage<ValueType, EMFieldLayout> Storage;
+
+        typedef Storage::DataBoxType DataBoxType;
+        typedef Storage::HostDataBoxType HostDataBoxType;
 
         typedef MappingDesc::SuperCellSize SuperCellSize;
 
@@ -84,7 +89,7 @@ namespace picongpu
 
         void init(FieldE &fieldE, LaserPhysics &laserPhysics);
 
-        DataBoxType getHostDataBox();
+        HostDataBoxType getHostDataBox();
 
         GridLayout<simDim> getGridLayout();
 
@@ -98,13 +103,16 @@ namespace picongpu
 
         void syncToDevice();
 
+        /** apply the already uploaded device buffer of getGridBuffer() to the field */
+        void applyGridBuffer();
+
     private:
 
         void absorbeBorder();
 
         void laserManipulation(uint32_t currentStep);
 
-        GridBuffer<ValueType, simDim> *fieldB;
+        Storage *fieldB;
 
         FieldE *fieldE;
         LaserPhysics *laser;
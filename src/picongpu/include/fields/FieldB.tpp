@@ -66,7 +66,7 @@ SimulationFieldHelper<MappingDesc>( cellDescription ),
 fieldE( NULL )
 {
     /*#####create FieldB###############*/
-    fieldB = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
+    fieldB = new Storage( cellDescription );
 
     typedef typename PMacc::particles::traits::FilterByFlag
     <
@@ -156,6 +156,11 @@ void FieldB::syncToDevice( )
     fieldB->hostToDevice( );
 }
 
+void FieldB::applyGridBuffer( )
+{
+    fieldB->applyGridBuffer( );
+}
+
 EventTask FieldB::asyncCommunication( EventTask serialEvent )
 {
 
@@ -178,28 +183,27 @@ GridLayout<simDim> FieldB::getGridLayout( )
     return cellDescription.getGridLayout( );
 }
 
-FieldB::DataBoxType FieldB::getHostDataBox( )
+FieldB::HostDataBoxType FieldB::getHostDataBox( )
 {
 
-    return fieldB->getHostBuffer( ).getDataBox( );
+    return fieldB->getHostDataBox( );
 }
 
 FieldB::DataBoxType FieldB::getDeviceDataBox( )
 {
 
-    return fieldB->getDeviceBuffer( ).getDataBox( );
+    return fieldB->getDeviceDataBox( );
 }
 
 GridBuffer<FieldB::ValueType, simDim> &FieldB::getGridBuffer( )
 {
 
-    return *fieldB;
+    return fieldB->getGridBuffer( );
 }
 
 void FieldB::reset( uint32_t )
 {
-    fieldB->getHostBuffer( ).reset( true );
-    fieldB->getDeviceBuffer( ).reset( false );
+    fieldB->reset( );
 }
 
 HDINLINE
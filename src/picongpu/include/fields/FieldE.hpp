@@ -38,6 +38,7 @@
 #include "memory/buffers/GridBuffer.hpp"
 #include "mappings/simulation/GridController.hpp"
 #include "fields/LaserPhysics.def"
+#include "fields/FieldStorage.hpp"
 #include "memory/boxes/DataBox.hpp"
 #include "memory/boxes/PitchedBox.hpp"
 
@@ -57,7 +58,11 @@ namespace picongpu
 
         typedef MappingDesc::SuperCellSize SuperCellSize;
 
-        typedef DataBox<PitchedBox<ValueType, simDim> > DataBoxType;
+        /** memory of the field, layout selected by EMFieldLayout (fieldSolver.param) */
+        typedef fieldLayout::FieldStorage<ValueType, EMFieldLayout> Storage;
+
+        typedef Storage::DataBoxType DataBoxType;
+        typedef Storage::HostDataBoxType HostDataBoxType;
 
 
         FieldE(MappingDesc cellDescription);
@@ -86,7 +91,7 @@ namespace picongpu
 
         DataBoxType getDeviceDataBox();
 
-        DataBoxType getHostDataBox();
+        HostDataBoxType getHostDataBox();
 
         GridBuffer<ValueType,simDim>& getGridBuffer();
 
@@ -98,6 +103,9 @@ namespace picongpu
 
         void syncToDevice();
 
+        /** apply the already uploaded device buffer of getGridBuffer() to the field */
+        void applyGridBuffer();
+
         void laserManipulation(uint32_t currentStep);
 
     private:
@@ -105,7 +113,7 @@ namespace picongpu
         void absorbeBorder();
 
 
-        GridBuffer<ValueType,simDim> *fieldE;
+        Storage *fieldE;
 
         FieldB *fieldB;
 
@@ -60,7 +60,7 @@ FieldE::FieldE( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription ),
 fieldB( NULL )
 {
-    fieldE = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
+    fieldE = new Storage( cellDescription );
     typedef typename PMacc::particles::traits::FilterByFlag
     <
         VectorAllSpecies,
@@ -148,6 +148,11 @@ void FieldE::syncToDevice( )
     fieldE->hostToDevice( );
 }
 
+void FieldE::applyGridBuffer( )
+{
+    fieldE->applyGridBuffer( );
+}
+
 EventTask FieldE::asyncCommunication( EventTask serialEvent )
 {
     return fieldE->asyncCommunication( serialEvent );
@@ -163,17 +168,17 @@ void FieldE::init( FieldB &fieldB, LaserPhysics &laserPhysics )
 
 FieldE::DataBoxType FieldE::getDeviceDataBox( )
 {
-    return fieldE->getDeviceBuffer( ).getDataBox( );
+    return fieldE->getDeviceDataBox( );
 }
 
-FieldE::DataBoxType FieldE::getHostDataBox( )
+FieldE::HostDataBoxType FieldE::getHostDataBox( )
 {
-    return fieldE->getHostBuffer( ).getDataBox( );
+    return fieldE->getHostDataBox( );
 }
 
 GridBuffer<FieldE::ValueType, simDim> &FieldE::getGridBuffer( )
 {
-    return *fieldE;
+    return fieldE->getGridBuffer( );
 }
 
 GridLayout< simDim> FieldE::getGridLayout( )
@@ -195,10 +200,10 @@ void FieldE::laserManipulation( uint32_t currentStep )
 
     DataSpace<simDim-1> gridBlocks;
     DataSpace<simDim-1> blockSize;
-    gridBlocks.x()=fieldE->getGridLayout( ).getDataSpaceWithoutGuarding( ).x( ) / SuperCellSize::x::value;
+    gridBlocks.x()=cellDescription.getGridLayout( ).getDataSpaceWithoutGuarding( ).x( ) / SuperCellSize::x::value;
     blockSize.x()=SuperCellSize::x::value;
 #if(SIMDIM ==DIM3)
-    gridBlocks.y()=fieldE->getGridLayout( ).getDataSpaceWithoutGuarding( ).z( ) / SuperCellSize::z::value;
+    gridBlocks.y()=cellDescription.getGridLayout( ).getDataSpaceWithoutGuarding( ).z( ) / SuperCellSize::z::value;
     blockSize.y()=SuperCellSize::z::value;
 #endif
 
@@ -212,8 +217,7 @@ void FieldE::laserManipulation( uint32_t currentStep )
 
 void FieldE::reset( uint32_t )
 {
-    fieldE->getHostBuffer( ).reset( true );
-    fieldE->getDeviceBuffer( ).reset( false );
+    fieldE->reset( );
 }
 
 
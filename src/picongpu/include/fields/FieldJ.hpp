@@ -42,6 +42,7 @@
 
 #include "math/Vector.hpp"
 #include "particles/Particles.hpp"
+#include "particles/traits/GetSubCycling.hpp"
 
 namespace picongpu
 {
@@ -104,6 +105,12 @@ public:
 
     static uint32_t getCommTag();
 
+    /** deposit the current of a species
+     *
+     * A sub-cycled species deposits the current of its last push (averaged
+     * over its N steps) into its own buffer only in its push steps, the
+     * buffer is added to this field in every step.
+     */
     template<uint32_t AREA, class ParticlesClass>
     void computeCurrent(ParticlesClass &parClass, uint32_t currentStep);
 
@@ -143,6 +150,9 @@ public:
 
 private:
 
+    /* add a current buffer of the size of this field (including the guard) */
+    void addCurrent(DeviceBuffer<ValueType, simDim>& current);
+
     GridBuffer<ValueType, simDim> fieldJ;
     GridBuffer<ValueType, simDim>* fieldJrecv;
 
@@ -167,4 +177,29 @@ struct ComputeCurrent
     }
 };
 
+/** add the averaged current of a species only if it is sub-cycled
+ *
+ * Used with ENABLE_FUSED_PUSH_CURRENT, all other species deposit their
+ * current during the push.
+ */
+template<typename T_SpeciesName, typename T_Area>
+struct ComputeSubCycledCurrent
+{
+
+    template<typename T_StorageTuple>
+    HINLINE void operator()( FieldJ* fieldJ,
+                            T_StorageTuple& tuple,
+                            const uint32_t currentStep) const
+    {
+        typedef T_SpeciesName SpeciesName;
+        typedef typename SpeciesName::type SpeciesType;
+
+        if( traits::GetSubCycling<SpeciesType>::type::getValue() == 1u )
+            return;
+
+        ComputeCurrent<T_SpeciesName, T_Area> computeCurrent;
+        computeCurrent( fieldJ, tuple, currentStep );
+    }
+};
+
 } // namespace picongpu
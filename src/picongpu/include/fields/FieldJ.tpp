@@ -42,6 +42,7 @@
 
 #include <boost/mpl/accumulate.hpp>
 #include "particles/traits/GetCurrentSolver.hpp"
+#include "particles/traits/GetSubCycling.hpp"
 #include "traits/GetMargin.hpp"
 #include "traits/Resolve.hpp"
 #include "traits/SIBaseUnits.hpp"
@@ -63,13 +64,23 @@ fieldJ( cellDescription.getGridLayout( ) ), fieldE( NULL ), fieldB( NULL ), fiel
         VectorAllSpecies,
         typename PMacc::math::CT::make_Int<simDim, 0>::type,
         PMacc::math::CT::max<bmpl::_1, GetLowerMargin< GetCurrentSolver<bmpl::_2> > >
-        >::type LowerMarginShapes;
+        >::type LowerMarginSolvers;
 
     typedef bmpl::accumulate<
         VectorAllSpecies,
         typename PMacc::math::CT::make_Int<simDim, 0>::type,
         PMacc::math::CT::max<bmpl::_1, GetUpperMargin< GetCurrentSolver<bmpl::_2> > >
-        >::type UpperMarginShapes;
+        >::type UpperMarginSolvers;
+
+#if (ENABLE_FUSED_PUSH_CURRENT == 1)
+    /* the current is deposited within the push, before a particle is moved
+     * to its new supercell: the particle can be one cell further out */
+    typedef typename PMacc::math::CT::make_Int<simDim, 1>::type MoveMargin;
+#else
+    typedef typename PMacc::math::CT::make_Int<simDim, 0>::type MoveMargin;
+#endif
+    typedef typename PMacc::math::CT::add<LowerMarginSolvers, MoveMargin>::type LowerMarginShapes;
+    typedef typename PMacc::math::CT::add<UpperMarginSolvers, MoveMargin>::type UpperMarginShapes;
 
     /* margins are always positive, also for lower margins
      * additional current interpolations and current filters on FieldJ might
@@ -301,7 +312,7 @@ FieldJ::getCommTag( )
 }
 
 template<uint32_t AREA, class ParticlesClass>
-void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t )
+void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t currentStep )
 {
 #if (PMACC_CUDA_ENABLED == 1)
     /** tune paramter to use more threads than cells in a supercell
@@ -325,15 +336,64 @@ void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t )
         typename GetMargin<ParticleCurrentSolver>::UpperMargin
         > BlockArea;
 
-    StrideMapping<AREA, 3, MappingDesc> mapper( cellDescription );
+    /* a sub-cycled species was moved over N * DELTA_T at its last push, the
+     * particles did not move since then: the current of the push is the
+     * average over the N steps, it is deposited once and added in each step
+     */
+    DeviceBuffer<ValueType, simDim>* averagedCurrent = parClass.getAveragedCurrent( );
+    if( averagedCurrent != NULL && !traits::isPushStep<ParticlesClass>( currentStep ) )
+    {
+        addCurrent( *averagedCurrent );
+        return;
+    }
+
     typename ParticlesClass::ParticlesBoxType pBox = parClass.getDeviceParticlesBox( );
     FieldJ::DataBoxType jBox = this->fieldJ.getDeviceBuffer( ).getDataBox( );
-    FrameSolver solver( DELTA_T );
+    if( averagedCurrent != NULL )
+    {
+        averagedCurrent->setValue( ValueType::create( 0.0 ) );
+        jBox = averagedCurrent->getDataBox( );
+    }
+    FrameSolver solver( traits::getPushDeltaTime<ParticlesClass>( ) );
 
-    DataSpace<simDim> blockSize( mapper.getSuperCellSize( ) );
+    DataSpace<simDim> blockSize( MappingDesc::SuperCellSize::toRT( ) );
     blockSize[simDim - 1] *= workerMultiplier;
     constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
 
+    if( AREA == CORE + BORDER )
+    {
+        /* skip empty supercells: the reachable supercells found before the
+         * push of this step cover the moved and received particles
+         */
+        const uint32_t numStrideClasses = parClass.getActiveSuperCells( ).getNumStrideClasses( );
+        for( uint32_t strideClass = 0; strideClass < numStrideClasses; ++strideClass )
+        {
+            PMACC_AUTO( listMapper, parClass.getActiveSuperCells( ).getReachableStrideMapping( strideClass ) );
+            if( listMapper.getSize( ) == 0 )
+                continue;
+
+            if(useElements)
+            {
+                using ElemSize = typename  MappingDesc::SuperCellSize;
+                __cudaKernel_OPTI( kernelComputeCurrent<workerMultiplier, BlockArea, AREA, ElemSize> )
+                    ( listMapper.getGridDim( ), blockSize )
+                    ( jBox,
+                      pBox, solver, listMapper );
+            }
+            else
+            {
+                __cudaKernel( kernelComputeCurrent<workerMultiplier, BlockArea, AREA> )
+                    ( listMapper.getGridDim( ), blockSize )
+                    ( jBox,
+                      pBox, solver, listMapper );
+            }
+        }
+        if( averagedCurrent != NULL )
+            addCurrent( *averagedCurrent );
+        return;
+    }
+
+    StrideMapping<AREA, 3, MappingDesc> mapper( cellDescription );
     do
     {
         if(useElements)
@@ -356,6 +416,32 @@ void FieldJ::computeCurrent( ParticlesClass &parClass, uint32_t )
     for (int i =0; i< 100;++i)
         mapper.next( );
 
+    if( averagedCurrent != NULL )
+        addCurrent( *averagedCurrent );
+}
+
+void FieldJ::addCurrent( DeviceBuffer<ValueType, simDim>& current )
+{
+    constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+    if(useElements)
+    {
+        using ElemSize = typename  MappingDesc::SuperCellSize;
+        __picKernelArea_OPTI( kernelAddCurrent<ElemSize> )(
+                         cellDescription,
+                         CORE + BORDER + GUARD )
+            ( MappingDesc::SuperCellSize::toRT( ).toDim3( ) )
+            ( this->fieldJ.getDeviceBuffer( ).getDataBox( ),
+              current.getDataBox( ) );
+    }
+    else
+    {
+        __picKernelArea( kernelAddCurrent<> )(
+                         cellDescription,
+                         CORE + BORDER + GUARD )
+            ( MappingDesc::SuperCellSize::toRT( ).toDim3( ) )
+            ( this->fieldJ.getDeviceBuffer( ).getDataBox( ),
+              current.getDataBox( ) );
+    }
 }
 
 template<uint32_t AREA, class T_CurrentInterpolation>
@@ -39,14 +39,64 @@ class FieldManipulator
 {
 public:
 
+    /** check if the absorber is applied at a border of the local domain
+     *
+     * The absorber is active at open (not communicating) boundaries with a
+     * thickness > 0. It is disabled at the top during the laser init time and
+     * on the side the moving window moves to.
+     *
+     * @param currentStep current simulation time step
+     * @param exchange planar exchange type of the border (LEFT, RIGHT, ...)
+     */
+    static bool isAbsorberActive(uint32_t currentStep, uint32_t exchange)
+    {
+        if (Environment<simDim>::get().GridController().getCommunicationMask().isSet(exchange))
+            return false;
+
+        uint32_t direction = 0; /*set direction to X (default)*/
+        if (exchange >= BOTTOM && exchange <= TOP)
+            direction = 1; /*set direction to Y*/
+        if (exchange >= BACK)
+            direction = 2; /*set direction to Z*/
+
+        /* exchange mod 2 to find positive or negative direction
+         * positive direction = 1
+         * negative direction = 0
+         */
+        uint32_t pos_or_neg = exchange % 2;
+
+        if (ABSORBER_CELLS[direction][pos_or_neg] == 0)
+            return false;
+
+        /* disable the absorber on top side if
+         *      no slide was performed and
+         *      laser init time is not over
+         *      laser::laserPlain <= absorber cells in negative y direction
+         */
+        if( laser::laserPlain <= ABSORBER_CELLS[1][0])
+        {
+            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+            if (numSlides == 0 && ((currentStep * DELTA_T) <= laserProfile::INIT_TIME))
+            {
+                if (exchange == TOP) return false; /*disable laser on top side*/
+            }
+        }
+
+        /* if sliding window is active we disable absorber on the side the window moves to */
+        if (MovingWindow::getInstance().isSlidingWindowActive() &&
+            direction == MovingWindow::getInstance().getMoveDirection() &&
+            pos_or_neg == 1) return false;
+
+        return true;
+    }
+
     template<class BoxedMemory>
     static void absorbBorder(uint32_t currentStep, MappingDesc &cellDescription, BoxedMemory deviceBox)
     {
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
         for (uint32_t i = 1; i < NumberOfExchanges<simDim>::value; ++i)
         {
             /* only call for planes: left right top bottom back front*/
-            if (FRONT % i == 0 && !(Environment<simDim>::get().GridController().getCommunicationMask().isSet(i)))
+            if (FRONT % i == 0 && isAbsorberActive(currentStep, i))
             {
                 uint32_t direction = 0; /*set direction to X (default)*/
                 if (i >= BOTTOM && i <= TOP)
@@ -54,33 +104,11 @@ public:
                 if (i >= BACK)
                     direction = 2; /*set direction to Z*/
 
-                /* exchange mod 2 to find positive or negative direction
-                 * positive direction = 1
-                 * negative direction = 0
-                 */
                 uint32_t pos_or_neg = i % 2;
 
                 uint32_t thickness = ABSORBER_CELLS[direction][pos_or_neg];
                 float_X absorber_strength = ABSORBER_STRENGTH[direction][pos_or_neg];
 
-                if (thickness == 0) continue; /*if the absorber has no thickness we check the next side*/
-
-                /* disable the absorber on top side if
-                 *      no slide was performed and
-                 *      laser init time is not over
-                 *      laser::laserPlain <= absorber cells in negative y direction
-                 */
-                if( laser::laserPlain <= ABSORBER_CELLS[1][0])
-                {
-                    if (numSlides == 0 && ((currentStep * DELTA_T) <= laserProfile::INIT_TIME))
-                    {
-                        if (i == TOP) continue; /*disable laser on top side*/
-                    }
-                }
-
-                /* if sliding window is active we disable absorber on bottom side*/
-                if (MovingWindow::getInstance().isSlidingWindowActive() && i == BOTTOM) continue;
-
                 ExchangeMapping<GUARD, MappingDesc> mapper(cellDescription, i);
                 constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
                 if(useElements)
@@ -101,6 +129,49 @@ public:
         }
     }
 
+    /** move a field by one supercell backwards in direction of the moving window
+     *
+     * The guard must hold the values of the neighbors (communication is finished).
+     * On the last device in slide direction the exposed cells are set to zero.
+     *
+     * @param cellDescription mapping description of the field
+     * @param deviceBox box of the field (including guard)
+     */
+    template<class BoxedMemory>
+    static void slideField(MappingDesc &cellDescription, BoxedMemory deviceBox)
+    {
+        typedef typename BoxedMemory::ValueType ValueType;
+
+        const uint32_t direction = MovingWindow::getInstance().getMoveDirection();
+        const DataSpace<simDim> gridCells(cellDescription.getGridLayout().getDataSpace());
+        const int shiftCells = SuperCellSize::toRT()[direction];
+
+        DataSpace<simDim> columns(gridCells);
+        columns[direction] = 1;
+        dim3 grid(ceil(double(columns.productOfComponents()) / 256.));
+
+        /* only the last device in slide direction has no neighbor which provides
+         * the values for the exposed cells via the guard
+         */
+        int clearBegin = gridCells[direction];
+        if (MovingWindow::getInstance().isLastGPUInMoveDirection())
+            clearBegin -= cellDescription.getGuardingSuperCells() * shiftCells + shiftCells;
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __cudaKernel_OPTI(kernelSlideField<256>)
+                (grid, 256)
+                (deviceBox, gridCells, direction, shiftCells, clearBegin, ValueType::create(0.0));
+        }
+        else
+        {
+            __cudaKernel(kernelSlideField<>)
+                (grid, 256)
+                (deviceBox, gridCells, direction, shiftCells, clearBegin, ValueType::create(0.0));
+        }
+    }
+
     static PMacc::traits::StringProperty getStringProperties()
     {
         PMacc::traits::StringProperty propList;
@@ -135,8 +206,11 @@ public:
                 if( boundaryName == "open" )
                 {
                     std::ostringstream boundaryParam;
-                    boundaryParam << "exponential damping over "
-                                  << ABSORBER_CELLS[axis][axisDir] << " cells";
+                    if( fieldAbsorber::usePml )
+                        boundaryParam << "convolutional PML over ";
+                    else
+                        boundaryParam << "exponential damping over ";
+                    boundaryParam << ABSORBER_CELLS[axis][axisDir] << " cells";
                     propList[directionName]["param"] = boundaryParam.str();
                 }
                 else
@@ -0,0 +1,288 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "simulation_classTypes.hpp"
+
+#include "fields/FieldLayout.def"
+#include "fields/FieldStorage.kernel"
+
+#include "memory/buffers/GridBuffer.hpp"
+#include "memory/buffers/MultiGridBuffer.hpp"
+#include "memory/boxes/DataBox.hpp"
+#include "memory/boxes/PitchedBox.hpp"
+#include "memory/boxes/VectorMultiBox.hpp"
+#include "mappings/kernel/AreaMapping.hpp"
+#include "eventSystem/EventSystem.hpp"
+
+namespace picongpu
+{
+namespace fieldLayout
+{
+using namespace PMacc;
+
+/** vector field stored as array of structs
+ *
+ * thin wrapper around a GridBuffer, this is the classic layout
+ */
+template<typename T_ValueType>
+class FieldStorage<T_ValueType, ArrayOfStructs>
+{
+public:
+    typedef T_ValueType ValueType;
+    typedef GridBuffer<ValueType, simDim> GridBufferType;
+    typedef DataBox<PitchedBox<ValueType, simDim> > DataBoxType;
+    typedef DataBoxType HostDataBoxType;
+
+    FieldStorage(MappingDesc cellDescription) :
+    buffer(cellDescription.getGridLayout())
+    {
+    }
+
+    void addExchange(uint32_t dataPlace, const Mask &receive, DataSpace<simDim> guardingCells, uint32_t communicationTag)
+    {
+        buffer.addExchange(dataPlace, receive, guardingCells, communicationTag);
+    }
+
+    EventTask asyncCommunication(EventTask serialEvent)
+    {
+        return buffer.asyncCommunication(serialEvent);
+    }
+
+    void deviceToHost()
+    {
+        buffer.deviceToHost();
+    }
+
+    void hostToDevice()
+    {
+        buffer.hostToDevice();
+    }
+
+    /** the grid buffer is the storage itself, nothing to apply */
+    void applyGridBuffer()
+    {
+    }
+
+    void reset()
+    {
+        buffer.getHostBuffer().reset(true);
+        buffer.getDeviceBuffer().reset(false);
+    }
+
+    DataBoxType getDeviceDataBox()
+    {
+        return buffer.getDeviceBuffer().getDataBox();
+    }
+
+    HostDataBoxType getHostDataBox()
+    {
+        return buffer.getHostBuffer().getDataBox();
+    }
+
+    GridBufferType& getGridBuffer()
+    {
+        return buffer;
+    }
+
+private:
+
+    GridBufferType buffer;
+};
+
+/** vector field stored as struct of arrays
+ *
+ * Each component lives in an own plane of a MultiGridBuffer and is
+ * exchanged with its own communication tag. On device the field is accessed
+ * via a VectorMultiBox which hides the layout from the kernels.
+ *
+ * Host side access (getHostDataBox, getGridBuffer) goes through an array of
+ * structs copy which is allocated on first use, so that plugins and the
+ * restart are independent of the layout.
+ */
+template<typename T_ValueType>
+class FieldStorage<T_ValueType, StructOfArrays>
+{
+public:
+    typedef T_ValueType ValueType;
+    typedef typename ValueType::type ComponentType;
+    BOOST_STATIC_CONSTEXPR int numComponents = ValueType::dim;
+
+    typedef GridBuffer<ValueType, simDim> GridBufferType;
+    typedef DataBox<VectorMultiBox<ValueType, simDim> > DataBoxType;
+    typedef DataBox<PitchedBox<ValueType, simDim> > HostDataBoxType;
+
+    PMACC_CASSERT_MSG(FieldStorage_StructOfArrays_supports_up_to_three_components, numComponents <= 3);
+
+    FieldStorage(MappingDesc cellDescription) :
+    cellDescription(cellDescription),
+    planes(cellDescription.getGridLayout()),
+    interchange(NULL),
+    attributePitch(0)
+    {
+        if (numComponents > 1)
+        {
+            attributePitch = (char*) planes.getGridBuffer(ComponentNames::y).getDeviceBuffer().getDataBox().getPointer() -
+                (char*) planes.getGridBuffer(ComponentNames::x).getDeviceBuffer().getDataBox().getPointer();
+        }
+    }
+
+    ~FieldStorage()
+    {
+        __delete(interchange);
+    }
+
+    /** add an exchange to each component plane
+     *
+     * the component index is encoded above bit 10 of the tag to keep the
+     * messages of different components apart
+     */
+    void addExchange(uint32_t dataPlace, const Mask &receive, DataSpace<simDim> guardingCells, uint32_t communicationTag)
+    {
+        for (uint32_t i = 0; i < ComponentNames::Count; ++i)
+        {
+            planes.getGridBuffer(static_cast<typename ComponentNames::Names> (i)).addExchange(
+                dataPlace, receive, guardingCells, communicationTag + (i << 10));
+        }
+    }
+
+    EventTask asyncCommunication(EventTask serialEvent)
+    {
+        return planes.asyncCommunication(serialEvent);
+    }
+
+    void deviceToHost()
+    {
+        copyToInterchange();
+        getInterchange().deviceToHost();
+    }
+
+    void hostToDevice()
+    {
+        getInterchange().hostToDevice();
+        applyGridBuffer();
+    }
+
+    /** apply the device buffer of the array of structs copy to the planes
+     *
+     * Use this instead of hostToDevice() if the copy was already uploaded
+     * via getGridBuffer().hostToDevice().
+     */
+    void applyGridBuffer()
+    {
+        copyFromInterchange();
+    }
+
+    void reset()
+    {
+        for (uint32_t i = 0; i < ComponentNames::Count; ++i)
+        {
+            GridBuffer<ComponentType, simDim>& plane = planes.getGridBuffer(static_cast<typename ComponentNames::Names> (i));
+            plane.getHostBuffer().reset(true);
+            plane.getDeviceBuffer().reset(false);
+        }
+        if (interchange != NULL)
+            interchange->getHostBuffer().reset(true);
+    }
+
+    DataBoxType getDeviceDataBox()
+    {
+        DeviceBuffer<ComponentType, simDim>& firstPlane = planes.getGridBuffer(ComponentNames::x).getDeviceBuffer();
+        return DataBoxType(VectorMultiBox<ValueType, simDim > (firstPlane.getDataBox().getPointer(),
+                                                              DataSpace<simDim > (),
+                                                              firstPlane.getPhysicalMemorySize(),
+                                                              firstPlane.getCudaPitched().pitch,
+                                                              attributePitch));
+    }
+
+    /** host box of the array of structs copy, valid after deviceToHost() */
+    HostDataBoxType getHostDataBox()
+    {
+        return getInterchange().getHostBuffer().getDataBox();
+    }
+
+    /** array of structs copy of the field
+     *
+     * The device buffer is refreshed with the current field on each call,
+     * data written to the host buffer is applied with hostToDevice().
+     */
+    GridBufferType& getGridBuffer()
+    {
+        copyToInterchange();
+        return getInterchange();
+    }
+
+private:
+
+    struct ComponentNames
+    {
+        enum Names
+        {
+            x, y, z
+        };
+        BOOST_STATIC_CONSTEXPR uint32_t Count = numComponents;
+    };
+
+    GridBufferType& getInterchange()
+    {
+        if (interchange == NULL)
+            interchange = new GridBufferType(cellDescription.getGridLayout());
+        return *interchange;
+    }
+
+    void copyToInterchange()
+    {
+        copy(getInterchange().getDeviceBuffer().getDataBox(), getDeviceDataBox());
+    }
+
+    void copyFromInterchange()
+    {
+        copy(getDeviceDataBox(), getInterchange().getDeviceBuffer().getDataBox());
+    }
+
+    template<class T_DestBox, class T_SrcBox>
+    void copy(T_DestBox dest, T_SrcBox src)
+    {
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __picKernelArea_OPTI(kernelCopyField<SuperCellSize>)( cellDescription, CORE + BORDER + GUARD)
+                (SuperCellSize::toRT().toDim3())
+                (dest, src);
+        }
+        else
+        {
+            __picKernelArea(kernelCopyField<>)( cellDescription, CORE + BORDER + GUARD)
+                (SuperCellSize::toRT().toDim3())
+                (dest, src);
+        }
+    }
+
+    MappingDesc cellDescription;
+    MultiGridBuffer<ComponentType, simDim, ComponentNames> planes;
+    GridBufferType* interchange;
+    size_t attributePitch;
+};
+
+} // namespace fieldLayout
+} // namespace picongpu
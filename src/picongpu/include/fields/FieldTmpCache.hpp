@@ -0,0 +1,120 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "simulation_classTypes.hpp"
+
+#include "fields/FieldTmp.hpp"
+#include "dataManagement/ISimulationData.hpp"
+
+
+namespace picongpu
+{
+    using namespace PMacc;
+
+    /** Cache of derived fields (e.g. densities) computed in FieldTmp slots
+     *
+     * A derived field is identified by the species, the derived attribute
+     * (solver) and the time step. Output plugins requesting the same derived
+     * field in one step (e.g. HDF5 and ADIOS) share one particle-to-grid
+     * deposition. The number of slots is limited by a memory budget, the least
+     * recently used slot is recomputed if no slot is free.
+     *
+     * The first slot is the FieldTmp registered in the DataConnector.
+     * Code that writes arbitrary data to a FieldTmp must use getScratchField().
+     */
+    class FieldTmpCache : public ISimulationData
+    {
+    public:
+
+        /**
+         * @param cellDescription mapping of the local domain
+         * @param fieldTmp FieldTmp used as first slot (not owned by the cache)
+         * @param memoryBudget memory in byte for additional slots (host and device)
+         */
+        FieldTmpCache( MappingDesc cellDescription, FieldTmp& fieldTmp, size_t memoryBudget );
+
+        virtual ~FieldTmpCache( );
+
+        static std::string getName( );
+
+        SimulationDataId getUniqueId( );
+
+        void synchronize( );
+
+        void init( );
+
+        /** get a derived field of a species
+         *
+         * The field is computed in CORE + BORDER, the GUARD contributions are
+         * already added to the neighbors. The returned FieldTmp is valid until
+         * the next call to getDerivedField() or getScratchField().
+         *
+         * @tparam FrameSolver derived attribute solver, e.g. of FieldTmpSolvers
+         * @param species particle species
+         * @param currentStep current simulation time step
+         * @param toHost copy the field to the host buffer
+         */
+        template<class FrameSolver, class ParticlesClass>
+        FieldTmp& getDerivedField( ParticlesClass& species, uint32_t currentStep, bool toHost );
+
+        /** get a FieldTmp for arbitrary data
+         *
+         * the least recently used slot is removed from the cache
+         */
+        FieldTmp& getScratchField( );
+
+        /** remove all derived fields from the cache
+         *
+         * must be called if particles are changed within a time step,
+         * e.g. after a slide of the moving window or a soft restart
+         */
+        void invalidate( );
+
+        /** @return number of slots */
+        uint32_t getNumSlots( ) const;
+
+    private:
+
+        struct Slot
+        {
+            FieldTmp* field;
+            std::string key;
+            uint32_t currentStep;
+            bool isValid;
+            bool isOnHost;
+            uint64_t lastAccess;
+        };
+
+        /** get the least recently used slot and mark it invalid */
+        Slot& evict( );
+
+        MappingDesc cellDescription;
+        std::vector<Slot> slots;
+        uint64_t accessCounter;
+    };
+
+} // namespace picongpu
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "fields/FieldTmpCache.hpp"
+
+#include "dataManagement/DataConnector.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "debug/PIConGPUVerbose.hpp"
+
+#include <sstream>
+
+namespace picongpu
+{
+    using namespace PMacc;
+
+    FieldTmpCache::FieldTmpCache( MappingDesc cellDescription, FieldTmp& fieldTmp, size_t memoryBudget ) :
+    cellDescription( cellDescription ),
+    accessCounter( 0 )
+    {
+        Slot first;
+        first.field = &fieldTmp;
+        first.currentStep = 0;
+        first.isValid = false;
+        first.isOnHost = false;
+        first.lastAccess = 0;
+        slots.push_back( first );
+
+        /* each slot holds a host and a device buffer */
+        const size_t slotSize = 2 * sizeof( FieldTmp::ValueType ) *
+            cellDescription.getGridLayout( ).getDataSpace( ).productOfComponents( );
+        const size_t numAdditionalSlots = memoryBudget / slotSize;
+
+        for( size_t i = 0; i < numAdditionalSlots; ++i )
+        {
+            Slot slot( first );
+            slot.field = new FieldTmp( cellDescription );
+            slots.push_back( slot );
+        }
+
+        log<picLog::MEMORY > ("derived field cache: %1% FieldTmp slots of %2% MiB") %
+            slots.size( ) % ( slotSize / 1024 / 1024 );
+    }
+
+    FieldTmpCache::~FieldTmpCache( )
+    {
+        /* the first slot is not owned by the cache */
+        for( size_t i = 1; i < slots.size( ); ++i )
+            __delete( slots[i].field );
+    }
+
+    std::string
+    FieldTmpCache::getName( )
+    {
+        return "FieldTmpCache";
+    }
+
+    SimulationDataId FieldTmpCache::getUniqueId( )
+    {
+        return getName( );
+    }
+
+    void FieldTmpCache::synchronize( )
+    {
+    }
+
+    void FieldTmpCache::init( )
+    {
+        Environment<>::get( ).DataConnector( ).registerData( *this );
+    }
+
+    template<class FrameSolver, class ParticlesClass>
+    FieldTmp& FieldTmpCache::getDerivedField( ParticlesClass& species, uint32_t currentStep, bool toHost )
+    {
+        std::stringstream keyStream;
+        keyStream << ParticlesClass::FrameType::getName( ) << "_" << FrameSolver( ).getName( );
+        const std::string key = keyStream.str( );
+
+        for( size_t i = 0; i < slots.size( ); ++i )
+        {
+            Slot& slot = slots[i];
+            if( slot.isValid && slot.currentStep == currentStep && slot.key == key )
+            {
+                slot.lastAccess = ++accessCounter;
+                if( toHost && !slot.isOnHost )
+                {
+                    slot.field->getGridBuffer( ).deviceToHost( );
+                    slot.isOnHost = true;
+                }
+                log<picLog::SIMULATION_STATE > ("derived field %1% reused from cache") % key;
+                return *slot.field;
+            }
+        }
+
+        Slot& slot = evict( );
+
+        slot.field->getGridBuffer( ).getDeviceBuffer( ).setValue( FieldTmp::ValueType::create( 0.0 ) );
+        /*run algorithm*/
+        slot.field->computeValue < CORE + BORDER, FrameSolver > ( species, currentStep );
+
+        /* add results of all particles that are still in GUARD to next GPUs BORDER */
+        EventTask fieldTmpEvent = slot.field->asyncCommunication( __getTransactionEvent( ) );
+        __setTransactionEvent( fieldTmpEvent );
+
+        if( toHost )
+            slot.field->getGridBuffer( ).deviceToHost( );
+
+        slot.key = key;
+        slot.currentStep = currentStep;
+        slot.isValid = true;
+        slot.isOnHost = toHost;
+        return *slot.field;
+    }
+
+    FieldTmp& FieldTmpCache::getScratchField( )
+    {
+        return *evict( ).field;
+    }
+
+    void FieldTmpCache::invalidate( )
+    {
+        for( size_t i = 0; i < slots.size( ); ++i )
+            slots[i].isValid = false;
+    }
+
+    uint32_t FieldTmpCache::getNumSlots( ) const
+    {
+        return slots.size( );
+    }
+
+    FieldTmpCache::Slot& FieldTmpCache::evict( )
+    {
+        size_t lru = 0;
+        for( size_t i = 0; i < slots.size( ); ++i )
+        {
+            /* free slots first, then the least recently used one */
+            if( !slots[i].isValid )
+            {
+                lru = i;
+                break;
+            }
+            if( slots[i].lastAccess < slots[lru].lastAccess )
+                lru = i;
+        }
+
+        Slot& slot = slots[lru];
+        slot.isValid = false;
+        slot.isOnHost = false;
+        slot.lastAccess = ++accessCounter;
+        return slot;
+    }
+
+} // namespace picongpu
@@ -26,3 +26,4 @@
 #include "fields/FieldE.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/FieldTmpCache.hpp"
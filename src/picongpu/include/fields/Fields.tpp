@@ -26,3 +26,4 @@
 #include "fields/FieldE.tpp"
 #include "fields/FieldJ.tpp"
 #include "fields/FieldTmp.tpp"
+#include "fields/FieldTmpCache.tpp"
@@ -29,6 +29,7 @@
 #include <dataManagement/DataConnector.hpp>
 #include <fields/FieldB.hpp>
 #include <fields/FieldE.hpp>
+#include <fields/FieldLayout.def>
 #include "math/Vector.hpp"
 #include <cuSTL/algorithm/kernel/ForeachBlock.hpp>
 #include <lambda/Expression.hpp>
@@ -36,6 +37,8 @@
 #include <math/vector/TwistComponents.hpp>
 #include <math/vector/compile-time/TwistComponents.hpp>
 
+#include <boost/type_traits/is_same.hpp>
+
 namespace picongpu
 {
 namespace dirSplitting
@@ -67,6 +70,11 @@ struct ConditionCheck<DirSplitting, T_Dummy>
     PMACC_CASSERT_MSG(DirectionSplitting_use_cubic_cells____check_your_gridConfig_param_file,
                       SI::CELL_DEPTH_SI == SI::CELL_WIDTH_SI);
 #endif
+    /* the solver propagates in the array of structs buffer of the fields,
+     * with planes it would update only the host side copy
+     */
+    PMACC_CASSERT_MSG(DirectionSplitting_requires_fieldLayout_ArrayOfStructs____check_your_fieldSolver_param_file,
+                      (boost::is_same<EMFieldLayout, fieldLayout::ArrayOfStructs>::value));
 };
 
 class DirSplitting : private ConditionCheck<fieldSolver::FieldSolver>
@@ -24,6 +24,7 @@
 
 #include "None/NoSolver.hpp"
 #include "Yee/YeeSolver.hpp"
+#include "YeeFused/YeeFusedSolver.hpp"
 #if (SIMDIM==3)
 #include "Lehe/LeheSolver.hpp"
 //#include "DirSplitting/DirSplitting.hpp"
@@ -40,6 +40,7 @@
 #include <fields/FieldB.hpp>
 
 #include "fields/FieldManipulator.hpp"
+#include "fields/absorber/Pml.hpp"
 #include "fields/MaxwellSolver/Yee/YeeSolver.kernel"
 
 namespace picongpu
@@ -52,13 +53,14 @@ using namespace PMacc;
 template<class CurlE, class CurlB>
 class YeeSolver
 {
-private:
+protected:
     typedef MappingDesc::SuperCellSize SuperCellSize;
 
 
     FieldE* fieldE;
     FieldB* fieldB;
     MappingDesc m_cellDescription;
+    fieldAbsorber::Pml pml;
 
     template<uint32_t AREA>
     void updateE()
@@ -116,7 +118,7 @@ private:
 
 public:
 
-    YeeSolver(MappingDesc cellDescription) : m_cellDescription(cellDescription)
+    YeeSolver(MappingDesc cellDescription) : m_cellDescription(cellDescription), pml(cellDescription)
     {
         DataConnector &dc = Environment<>::get().DataConnector();
 
@@ -124,19 +126,24 @@ public:
         this->fieldB = &dc.getData<FieldB > (FieldB::getName(), true);
     }
 
-    void update_beforeCurrent(uint32_t)
+    void update_beforeCurrent(uint32_t currentStep)
     {
         updateBHalf < CORE+BORDER >();
+        if (fieldAbsorber::usePml)
+            pml.updateBHalf(currentStep, fieldB->getDeviceDataBox(), fieldE->getDeviceDataBox());
         EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
 
         updateE<CORE>();
         __setTransactionEvent(eRfieldB);
         updateE<BORDER>();
+        if (fieldAbsorber::usePml)
+            pml.updateE(currentStep, fieldE->getDeviceDataBox(), fieldB->getDeviceDataBox());
     }
 
     void update_afterCurrent(uint32_t currentStep)
     {
-        FieldManipulator::absorbBorder(currentStep,this->m_cellDescription, this->fieldE->getDeviceDataBox());
+        if (!fieldAbsorber::usePml)
+            FieldManipulator::absorbBorder(currentStep,this->m_cellDescription, this->fieldE->getDeviceDataBox());
         if (laserProfile::INIT_TIME > float_X(0.0))
             fieldE->laserManipulation(currentStep);
 
@@ -146,7 +153,10 @@ public:
         __setTransactionEvent(eRfieldE);
         updateBHalf < BORDER > ();
 
-        FieldManipulator::absorbBorder(currentStep,this->m_cellDescription, fieldB->getDeviceDataBox());
+        if (fieldAbsorber::usePml)
+            pml.updateBHalf(currentStep, fieldB->getDeviceDataBox(), fieldE->getDeviceDataBox());
+        else
+            FieldManipulator::absorbBorder(currentStep,this->m_cellDescription, fieldB->getDeviceDataBox());
 
         EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
         __setTransactionEvent(eRfieldB);
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+#include "YeeFusedSolver.def"
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+
+#include "fields/MaxwellSolver/Yee/YeeSolver.hpp"
+#include "mappings/kernel/WavefrontMapping.hpp"
+#include "fields/MaxwellSolver/YeeFused/YeeFusedSolver.kernel"
+
+#include <boost/type_traits/is_same.hpp>
+
+namespace picongpu
+{
+namespace yeeFusedSolver
+{
+using namespace PMacc;
+
+/** Yee solver which updates B and E in one sweep
+ *
+ * The half B update and the E update before the current deposition are
+ * fused into one kernel, so E and B are streamed only once through the
+ * memory hierarchy. Supercells are processed in diagonal wavefronts
+ * (WavefrontMapping) which allows to update both fields in place.
+ * The result is bit-identical to the YeeSolver.
+ *
+ * The wavefront order requires that CurlE only accesses upper and CurlB only
+ * lower neighbors (standard Yee stencil).
+ */
+template<class CurlE, class CurlB>
+class YeeFusedSolver : public yeeSolver::YeeSolver<CurlE, CurlB>
+{
+private:
+    typedef yeeSolver::YeeSolver<CurlE, CurlB> BaseType;
+    typedef MappingDesc::SuperCellSize SuperCellSize;
+
+    /** half B update on CORE+BORDER and E update on CORE */
+    void updateBHalfE()
+    {
+        /* wavefront order: B reads only upper, E only lower neighbors */
+        PMACC_CASSERT_MSG(YeeFusedSolver_CurlE_must_not_access_lower_neighbors,
+            (boost::is_same<typename CurlE::LowerMargin, typename PMacc::math::CT::make_Int<simDim, 0>::type>::value));
+        PMACC_CASSERT_MSG(YeeFusedSolver_CurlB_must_not_access_upper_neighbors,
+            (boost::is_same<typename CurlB::UpperMargin, typename PMacc::math::CT::make_Int<simDim, 0>::type>::value));
+
+        typedef SuperCellDescription<
+                SuperCellSize,
+                typename CurlE::LowerMargin,
+                typename CurlE::UpperMargin
+                > BlockAreaE;
+
+        typedef SuperCellDescription<
+                SuperCellSize,
+                typename CurlB::LowerMargin,
+                typename CurlB::UpperMargin
+                > BlockAreaB;
+
+        WavefrontMapping<CORE + BORDER, MappingDesc> mapper(this->m_cellDescription);
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        do
+        {
+            if(useElements)
+            {
+                __cudaKernel_OPTI(kernelUpdateBHalfE<BlockAreaE, BlockAreaB, CurlE, CurlB, SuperCellSize>)
+                    (mapper.getGridDim(), SuperCellSize::toRT().toDim3())
+                    (this->fieldE->getDeviceDataBox(), this->fieldB->getDeviceDataBox(), mapper);
+            }
+            else
+            {
+                __cudaKernel(kernelUpdateBHalfE<BlockAreaE, BlockAreaB, CurlE, CurlB>)
+                    (mapper.getGridDim(), SuperCellSize::toRT().toDim3())
+                    (this->fieldE->getDeviceDataBox(), this->fieldB->getDeviceDataBox(), mapper);
+            }
+        }
+        while (mapper.next());
+    }
+
+public:
+
+    YeeFusedSolver(MappingDesc cellDescription) : BaseType(cellDescription)
+    {
+    }
+
+    void update_beforeCurrent(uint32_t currentStep)
+    {
+        /* the PML corrects B before E is updated, which is not possible in one sweep */
+        if (fieldAbsorber::usePml)
+        {
+            BaseType::update_beforeCurrent(currentStep);
+            return;
+        }
+
+        updateBHalfE();
+        EventTask eRfieldB = this->fieldB->asyncCommunication(__getTransactionEvent());
+
+        __setTransactionEvent(eRfieldB);
+        this->template updateE<BORDER>();
+    }
+
+    static PMacc::traits::StringProperty getStringProperties()
+    {
+        PMacc::traits::StringProperty propList( "name", "YeeFused" );
+        return propList;
+    }
+};
+
+} // yeeFusedSolver
+
+} // picongpu
@@ -0,0 +1,336 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "simulation_classTypes.hpp"
+
+#include "memory/buffers/GridBuffer.hpp"
+#include "memory/dataTypes/Mask.hpp"
+#include "fields/FieldManipulator.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "fields/absorber/Pml.kernel"
+
+#include <cassert>
+
+namespace picongpu
+{
+namespace fieldAbsorber
+{
+using namespace PMacc;
+
+/** convolutional perfectly matched layer (CPML) at the open boundaries
+ *
+ * Corrects the Yee update of E and B in the ABSORBER_CELLS of each open
+ * boundary, see kernelPmlCorrection. The convolution psi of a layer is
+ * allocated on construction and only on devices at an open boundary (all
+ * devices for the boundaries in move direction of a sliding window). The
+ * memory is reserved before the particle heap is created, see
+ * getMemorySize().
+ *
+ * The differences of the correction are the Yee differences (CurlLeft for E,
+ * CurlRight for B), also if the solver uses an extended stencil (Lehe).
+ */
+class Pml
+{
+public:
+
+    Pml(MappingDesc cellDescription) : cellDescription(cellDescription), lastNumSlides(0)
+    {
+        for (uint32_t d = 0; d < simDim; ++d)
+            for (uint32_t side = 0; side < 2; ++side)
+            {
+                psiE[d][side] = NULL;
+                psiB[d][side] = NULL;
+            }
+
+        for (uint32_t i = 1; i < NumberOfExchanges<simDim>::value; ++i)
+        {
+            if (!isLayerRequired(i))
+                continue;
+
+            uint32_t axis, side;
+            getAxisAndSide(i, axis, side);
+            const DataSpace<simDim> layerSize(getLayerSize(cellDescription, axis, side));
+
+            psiE[axis][side] = new PsiBuffer(layerSize);
+            psiE[axis][side]->getDeviceBuffer().setValue(float3_X::create(0.0));
+            psiB[axis][side] = new PsiBuffer(layerSize);
+            psiB[axis][side]->getDeviceBuffer().setValue(float3_X::create(0.0));
+        }
+    }
+
+    virtual ~Pml()
+    {
+        for (uint32_t d = 0; d < simDim; ++d)
+            for (uint32_t side = 0; side < 2; ++side)
+            {
+                __delete(psiE[d][side]);
+                __delete(psiB[d][side]);
+            }
+    }
+
+    /** correct E after the E update in CORE+BORDER
+     *
+     * @param currentStep current simulation time step
+     * @param fieldE box of the electric field
+     * @param fieldB box of the magnetic field
+     */
+    template<class T_EBox, class T_BBox>
+    void updateE(uint32_t currentStep, T_EBox fieldE, T_BBox fieldB)
+    {
+        const float_X c2 = SPEED_OF_LIGHT * SPEED_OF_LIGHT;
+        update(currentStep, fieldE, fieldB, psiE, -1, float_X(1.0), c2 * DELTA_T);
+    }
+
+    /** correct B after a half B update in CORE+BORDER
+     *
+     * @param currentStep current simulation time step
+     * @param fieldB box of the magnetic field
+     * @param fieldE box of the electric field
+     */
+    template<class T_BBox, class T_EBox>
+    void updateBHalf(uint32_t currentStep, T_BBox fieldB, T_EBox fieldE)
+    {
+        update(currentStep, fieldB, fieldE, psiB, 1, float_X(0.5), float_X(-0.5) * DELTA_T);
+    }
+
+    /** device memory of all layers of this device in byte
+     *
+     * @param cellDescription mapping description of the local domain
+     */
+    static size_t getMemorySize(const MappingDesc& cellDescription)
+    {
+        size_t memorySize = 0;
+        for (uint32_t i = 1; i < NumberOfExchanges<simDim>::value; ++i)
+        {
+            if (!isLayerRequired(i))
+                continue;
+
+            uint32_t axis, side;
+            getAxisAndSide(i, axis, side);
+            /* psi of E and B */
+            memorySize += 2 * sizeof(float3_X) *
+                getLayerSize(cellDescription, axis, side).productOfComponents();
+        }
+        return memorySize;
+    }
+
+private:
+
+    typedef GridBuffer<float3_X, simDim> PsiBuffer;
+
+    /** axis and side (0: negative, 1: positive) of a plane exchange */
+    static void getAxisAndSide(uint32_t exchange, uint32_t& axis, uint32_t& side)
+    {
+        const DataSpace<simDim> relDir(Mask::getRelativeDirections<simDim>(exchange));
+        axis = 0;
+        for (uint32_t d = 0; d < simDim; ++d)
+            if (relDir[d] != 0)
+                axis = d;
+        side = relDir[axis] < 0 ? 0 : 1;
+    }
+
+    /** can the absorber of this plane exchange be active on this device
+     *
+     * With a sliding window the devices at the boundaries in move direction
+     * change with the slides.
+     */
+    static bool isLayerRequired(uint32_t exchange)
+    {
+        /* only for planes: left right top bottom back front */
+        if (FRONT % exchange != 0)
+            return false;
+
+        uint32_t axis, side;
+        getAxisAndSide(exchange, axis, side);
+        if (ABSORBER_CELLS[axis][side] == 0)
+            return false;
+
+        const MovingWindow& movingWindow = MovingWindow::getInstance();
+        if (movingWindow.isSlidingWindowActive() && axis == movingWindow.getMoveDirection())
+            return true;
+
+        return !Environment<simDim>::get().GridController().getCommunicationMask().isSet(exchange);
+    }
+
+    static DataSpace<simDim> getLayerSize(const MappingDesc& cellDescription, uint32_t axis, uint32_t side)
+    {
+        DataSpace<simDim> layerSize(cellDescription.getGridLayout().getDataSpaceWithoutGuarding());
+        layerSize[axis] = ABSORBER_CELLS[axis][side];
+        return layerSize;
+    }
+
+    template<class T_FieldBox, class T_SrcFieldBox>
+    void update(uint32_t currentStep, T_FieldBox field, T_SrcFieldBox srcField,
+                PsiBuffer* psi[simDim][2], int neighbor, float_X timeFactor, float_X updateFactor)
+    {
+        resetAfterSlide(currentStep);
+
+        const DataSpace<simDim> guardCells(SuperCellSize::toRT() * cellDescription.getGuardingSuperCells());
+        const DataSpace<simDim> localCells(cellDescription.getGridLayout().getDataSpaceWithoutGuarding());
+
+        for (uint32_t i = 1; i < NumberOfExchanges<simDim>::value; ++i)
+        {
+            /* only for planes: left right top bottom back front */
+            if (FRONT % i != 0 || !FieldManipulator::isAbsorberActive(currentStep, i))
+                continue;
+
+            uint32_t axis, side;
+            getAxisAndSide(i, axis, side);
+            const bool isNegativeSide = side == 0;
+            const int thickness = ABSORBER_CELLS[axis][side];
+
+            DataSpace<simDim> layerOffset(guardCells);
+            const DataSpace<simDim> layerSize(getLayerSize(cellDescription, axis, side));
+            if (!isNegativeSide)
+                layerOffset[axis] += localCells[axis] - thickness;
+
+            /* allocated in the constructor, see isLayerRequired() */
+            assert(psi[axis][side] != NULL);
+
+            const PmlProfile profile = getProfile(axis);
+            dim3 grid(ceil(double(layerSize.productOfComponents()) / 256.));
+
+            constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+            if(useElements)
+            {
+                __cudaKernel_OPTI(kernelPmlCorrection<256>)
+                    (grid, 256)
+                    (field, srcField, psi[axis][side]->getDeviceBuffer().getDataBox(),
+                     layerOffset, layerSize, axis, isNegativeSide, profile,
+                     neighbor, timeFactor, updateFactor);
+            }
+            else
+            {
+                __cudaKernel(kernelPmlCorrection<>)
+                    (grid, 256)
+                    (field, srcField, psi[axis][side]->getDeviceBuffer().getDataBox(),
+                     layerOffset, layerSize, axis, isNegativeSide, profile,
+                     neighbor, timeFactor, updateFactor);
+            }
+        }
+    }
+
+    /** coefficients of the layers perpendicular to axis */
+    static PmlProfile getProfile(uint32_t axis)
+    {
+        PmlProfile profile;
+        /* optimal sigma * DELTA_T / EPS0 = 0.8 * (order + 1) * c * DELTA_T / cell size */
+        profile.sigmaMax = float_X(
+            pml::SIGMA_OPT_RATIO * 0.8 * (pml::GRADING_ORDER + 1.0) *
+            float_64(SPEED_OF_LIGHT) * float_64(DELTA_T) / float_64(cellSize[axis]));
+        profile.kappaMax = float_X(pml::KAPPA_MAX);
+        profile.alphaMax = float_X(pml::NORMALIZED_ALPHA_MAX);
+        profile.order = float_X(pml::GRADING_ORDER);
+        return profile;
+    }
+
+    /** move the convolution with the fields after a slide
+     *
+     * The fields in the layers at the boundary in move direction are replaced
+     * by a slide, the old convolution does not belong to them.
+     * The layers of the other axes span the move direction:
+     * - incremental slides: the convolution is moved like the fields
+     *   (see FieldManipulator::slideField), the exposed cells are cleared
+     * - rotating devices: the fields of the device which became the last one
+     *   in move direction are reset, so is the convolution of all its layers
+     */
+    void resetAfterSlide(uint32_t currentStep)
+    {
+        MovingWindow& movingWindow = MovingWindow::getInstance();
+        const uint32_t numSlides = movingWindow.getSlideCounter(currentStep);
+        if (numSlides == lastNumSlides)
+            return;
+        const uint32_t newSlides = numSlides - lastNumSlides;
+        lastNumSlides = numSlides;
+
+        const uint32_t direction = movingWindow.getMoveDirection();
+        const bool isReset = !movingWindow.isIncrementalSlides() && movingWindow.isLastGPUInMoveDirection();
+
+        for (uint32_t d = 0; d < simDim; ++d)
+            for (uint32_t side = 0; side < 2; ++side)
+            {
+                if (d == direction || isReset)
+                {
+                    clearLayer(psiE[d][side]);
+                    clearLayer(psiB[d][side]);
+                }
+                else if (movingWindow.isIncrementalSlides())
+                {
+                    slideLayer(psiE[d][side], direction, newSlides);
+                    slideLayer(psiB[d][side], direction, newSlides);
+                }
+            }
+    }
+
+    static void clearLayer(PsiBuffer* psi)
+    {
+        if (psi != NULL)
+            psi->getDeviceBuffer().setValue(float3_X::create(0.0));
+    }
+
+    /** move the convolution of a layer by numSlides supercells against direction */
+    static void slideLayer(PsiBuffer* psi, uint32_t direction, uint32_t numSlides)
+    {
+        if (psi == NULL)
+            return;
+
+        const DataSpace<simDim> layerSize(psi->getGridLayout().getDataSpace());
+        const int64_t shiftCells = int64_t(SuperCellSize::toRT()[direction]) * int64_t(numSlides);
+        if (shiftCells >= layerSize[direction])
+        {
+            clearLayer(psi);
+            return;
+        }
+
+        DataSpace<simDim> columns(layerSize);
+        columns[direction] = 1;
+        dim3 grid(ceil(double(columns.productOfComponents()) / 256.));
+        /* the cells of the neighbor are not available, they are cleared */
+        const int clearBegin = layerSize[direction] - int(shiftCells);
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __cudaKernel_OPTI(kernelSlideField<256>)
+                (grid, 256)
+                (psi->getDeviceBuffer().getDataBox(), layerSize, direction, int(shiftCells), clearBegin,
+                 float3_X::create(0.0));
+        }
+        else
+        {
+            __cudaKernel(kernelSlideField<>)
+                (grid, 256)
+                (psi->getDeviceBuffer().getDataBox(), layerSize, direction, int(shiftCells), clearBegin,
+                 float3_X::create(0.0));
+        }
+    }
+
+    MappingDesc cellDescription;
+    PsiBuffer* psiE[simDim][2];
+    PsiBuffer* psiB[simDim][2];
+    uint32_t lastNumSlides;
+};
+
+} // namespace fieldAbsorber
+} // namespace picongpu
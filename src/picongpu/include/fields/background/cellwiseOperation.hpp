@@ -62,7 +62,10 @@ namespace cellwiseOperation
 
         const DataSpace<simDim> threadIndex( threadIdx );
 
-        opFunctor( field( blockCell + threadIndex ),
+        /* bind the reference to a named object, boxes with a non-trivial
+         * memory layout return a proxy object instead of a C++ reference */
+        typename FieldBox::RefValueType fieldValue = field( blockCell + threadIndex );
+        opFunctor( fieldValue,
                    valFunctor( blockCell + threadIndex + totalCellOffset,
                                currentStep )
                  );
@@ -104,8 +107,8 @@ namespace cellwiseOperation
             const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter( currentStep );
 
             /** Assumption: all GPUs have the same number of cells in
-             *              y direction for sliding window */
-            totalCellOffset.y() += numSlides * subGrid.getLocalDomain().size.y();
+             *              move direction for sliding window */
+            totalCellOffset += MovingWindow::getInstance().getSlideOffset( numSlides );
             /* the first block will start with less offset if started in the GUARD */
             if( T_Area & GUARD)
                 totalCellOffset -= m_cellDescription.getSuperCellSize() * m_cellDescription.getGuardingSuperCells();
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+
+
+namespace picongpu
+{
+namespace currentSolver
+{
+namespace detail
+{
+
+    /** add a value to the block local current cache
+     *
+     * @tparam T_isThreadSeq true if the accelerator runs only one thread per block
+     */
+    template<bool T_isThreadSeq>
+    struct AtomicAddCurrent
+    {
+        template<typename T_Acc, typename T_Type>
+        DINLINE void
+        operator()(const T_Acc& acc, T_Type* ptr, const T_Type value) const
+        {
+            atomicAdd(ptr, value, ::alpaka::hierarchy::Threads());
+        }
+    };
+
+    /* a single thread owns the block local cache, no concurrent access is possible */
+    template<>
+    struct AtomicAddCurrent<true>
+    {
+        template<typename T_Acc, typename T_Type>
+        DINLINE void
+        operator()(const T_Acc&, T_Type* ptr, const T_Type value) const
+        {
+            *ptr += value;
+        }
+    };
+
+} // namespace detail
+
+/** add current to the block local (shared) current cache
+ *
+ * On accelerators with one thread per block (e.g. the `__cudaKernel_OPTI`
+ * path on CPUs) all particles of a supercell are deposited sequentially
+ * by the same thread, therefore the value is added without an atomic operation.
+ *
+ * @param acc alpaka accelerator
+ * @param ptr pointer to a current component within the cache
+ * @param value value to add
+ */
+template<typename T_Acc, typename T_Type>
+DINLINE void
+atomicAddCurrent(const T_Acc& acc, T_Type* ptr, const T_Type value)
+{
+    detail::AtomicAddCurrent<
+        cupla::traits::IsThreadSeqAcc<T_Acc>::value
+    >()(acc, ptr, value);
+}
+
+} // namespace currentSolver
+} // namespace picongpu
@@ -27,6 +27,7 @@
 #include <cuSTL/cursor/compile-time/SafeCursor.hpp>
 #include "fields/currentDeposition/Esirkepov/Esirkepov.def"
 #include "fields/currentDeposition/Esirkepov/Line.hpp"
+#include "fields/currentDeposition/AtomicAddCurrent.hpp"
 
 namespace picongpu
 {
@@ -166,7 +167,7 @@ struct Esirkepov<T_ParticleShape, DIM3>
                     accumulated_J += -this->charge * (float_X(1.0) / float_X(CELL_VOLUME * DELTA_T)) * W * cellEdgeLength;
                     /* the branch divergence here still over-compensates for the fewer collisions in the (expensive) atomic adds */
                     if (accumulated_J != float_X(0.0))
-                        atomicAdd(&((*cursorJ(i, j, k)).z()), accumulated_J,::alpaka::hierarchy::Threads());
+                        atomicAddCurrent(acc, &((*cursorJ(i, j, k)).z()), accumulated_J);
                 }
             }
         }
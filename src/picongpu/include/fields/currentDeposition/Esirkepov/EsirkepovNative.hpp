@@ -29,6 +29,7 @@
 #include <cuSTL/cursor/compile-time/SafeCursor.hpp>
 
 #include "fields/currentDeposition/Esirkepov/Line.hpp"
+#include "fields/currentDeposition/AtomicAddCurrent.hpp"
 
 namespace picongpu
 {
@@ -125,7 +126,7 @@ struct EsirkepovNative
                     /* We multiply with `cellEdgeLength` due to the fact that the attribute for the
                      * in-cell particle `position` (and it's change in DELTA_T) is normalize to [0,1) */
                     accumulated_J += -this->charge * (float_X(1.0) / float_X(CELL_VOLUME * DELTA_T)) * W * cellEdgeLength;
-                    atomicAdd(&((*cursorJ(i, j, k)).z()), accumulated_J, ::alpaka::hierarchy::Threads());
+                    atomicAddCurrent(acc, &((*cursorJ(i, j, k)).z()), accumulated_J);
                 }
             }
         }
@@ -21,7 +21,7 @@
 
 #include "fields/currentDeposition/Esirkepov/Esirkepov.hpp"
 #include "fields/currentDeposition/Esirkepov/EsirkepovNative.hpp"
-//#include "fields/currentDeposition/ZigZag/ZigZag.hpp"
+#include "fields/currentDeposition/ZigZag/ZigZag.hpp"
 
 #if(SIMDIM==DIM3)
 #include "fields/currentDeposition/VillaBune/CurrentVillaBune.hpp"
@@ -36,6 +36,7 @@
 #include <boost/mpl/if.hpp>
 #include "compileTime/AllCombinations.hpp"
 #include "fields/currentDeposition/ZigZag/EvalAssignmentFunction.hpp"
+#include "fields/currentDeposition/AtomicAddCurrent.hpp"
 
 namespace picongpu
 {
@@ -98,9 +99,9 @@ template<typename T_GridPointVec, typename T_Shape, typename T_CurrentComponent>
 struct AssignChargeToCell
 {
 
-    template<typename T_Cursor>
-    HDINLINE void
-    operator()(T_Cursor& cursor, const floatD_X& pos, const float_X flux)
+    template<typename T_Cursor, typename T_Acc>
+    DINLINE void
+    operator()(const T_Acc& acc, T_Cursor& cursor, const floatD_X& pos, const float_X flux)
     {
         typedef T_GridPointVec GridPointVec;
         typedef T_Shape Shape;
@@ -124,7 +125,7 @@ struct AssignChargeToCell
         /* shift memory cursor to cell (grid point)*/
         PMACC_AUTO(cursorToValue, cursor(GridPointVec::toRT()));
         /* add current to component of the cell*/
-        atomicAdd(&((*cursorToValue)[currentComponent]), j);
+        atomicAddCurrent(acc, &((*cursorToValue)[currentComponent]), j);
     }
 };
 
@@ -172,9 +173,9 @@ struct ZigZag
     struct AssignOneDirection
     {
 
-        template<typename T_Cursor>
-        HDINLINE void
-        operator()(T_Cursor cursor, floatD_X pos, const float3_X& flux)
+        template<typename T_Cursor, typename T_Acc>
+        DINLINE void
+        operator()(const T_Acc& acc, T_Cursor cursor, floatD_X pos, const float3_X& flux)
         {
             typedef T_CurrentComponent CurrentComponent;
             const uint32_t dir = CurrentComponent::value;
@@ -214,21 +215,22 @@ struct ZigZag
             /* calculate the current for every cell (grid point)*/
             typedef typename AllCombinations<Size>::type CombiTypes;
             ForEach<CombiTypes, AssignChargeToCell<bmpl::_1, ParticleShape, CurrentComponent > > callAssignChargeToCell;
-            callAssignChargeToCell(forward(cursor), pos, flux[dir]);
+            callAssignChargeToCell(acc, forward(cursor), pos, flux[dir]);
         }
 
     };
 
     /** add current of a moving particle to the global current
      *
+     * @param acc alpaka accelerator
      * @param dataBoxJ DataBox with current field
      * @param pos1 current position of the particle
      * @param velocity velocity of the macro particle
      * @param charge charge of the macro particle
      * @param deltaTime dime difference of one simulation time step
      */
-    template<typename DataBoxJ, typename PosType, typename VelType, typename ChargeType >
-    DINLINE void operator()(DataBoxJ dataBoxJ,
+    template<typename DataBoxJ, typename PosType, typename VelType, typename ChargeType, typename T_Acc >
+    DINLINE void operator()(const T_Acc& acc, DataBoxJ dataBoxJ,
                             const PosType pos1,
                             const VelType velocity,
                             const ChargeType charge, const float_X deltaTime)
@@ -303,7 +305,7 @@ struct ZigZag
 
             /* calculate x,y,z component of the current*/
             ForEach<Components, AssignOneDirection<bmpl::_1> > callAssignOneDirection;
-            callAssignOneDirection(forward(cursorJ), inCellPos, flux);
+            callAssignOneDirection(acc, forward(cursorJ), inCellPos, flux);
         }
     }
 
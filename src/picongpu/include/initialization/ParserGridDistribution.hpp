@@ -98,6 +98,32 @@ public:
         return iter->first;
     }
 
+    /** Get the number of devices the distribution is given for
+     *
+     *  \return sum of all multipliers
+     */
+    uint32_t
+    getNumberOfDevices( ) const
+    {
+        uint32_t numDevices = 0;
+        for( value_type::const_iterator iter = parsedInput.begin(); iter != parsedInput.end(); ++iter )
+            numDevices += iter->second;
+        return numDevices;
+    }
+
+    /** Get the number of cells of all devices
+     *
+     *  \return global number of cells in this dimension
+     */
+    uint32_t
+    getTotalSize( ) const
+    {
+        uint32_t sumTotal = 0;
+        for( value_type::const_iterator iter = parsedInput.begin(); iter != parsedInput.end(); ++iter )
+            sumTotal += iter->first * iter->second;
+        return sumTotal;
+    }
+
 private:
     value_type parsedInput;
 
@@ -87,4 +87,27 @@ struct CreateInterpolationForPusher
     }
 };
 
+/** functor for a field value which is already interpolated to the particle
+ *
+ * Can replace InterpolationForPusher for pushers which evaluate the fields
+ * only at the position the particle had before the push.
+ */
+struct PrecomputedFieldForPusher
+{
+    HDINLINE
+    PrecomputedFieldForPusher( const float3_X& value ) : m_value( value )
+    {
+    }
+
+    template< typename T_PosType >
+    HDINLINE
+    float3_X operator()( const T_PosType& ) const
+    {
+        return m_value;
+    }
+
+private:
+    PMACC_ALIGN( m_value, const float3_X );
+};
+
 } // namespace picongpu
@@ -31,6 +31,7 @@
 #include "particles/manipulators/manipulators.def"
 
 #include "memory/dataTypes/Mask.hpp"
+#include "memory/buffers/DeviceBufferIntern.hpp"
 #include "mappings/simulation/GridController.hpp"
 #include "dataManagement/ISimulationData.hpp"
 
@@ -63,6 +64,14 @@ public:
 
     void update(uint32_t currentStep);
 
+    /** move the particles marked by the push to their new supercells
+     *
+     * Part of update(), called separately if the species is pushed together
+     * with other species (see PushAllSpecies).
+     * The active supercells must be up to date since the push.
+     */
+    void shiftPushedParticles();
+
     template<typename T_GasFunctor, typename T_PositionFunctor>
     void initGas(T_GasFunctor& gasFunctor, T_PositionFunctor& positionFunctor, const uint32_t currentStep);
 
@@ -75,6 +84,17 @@ public:
 
     SimulationDataId getUniqueId();
 
+    /** current of the last push of a sub-cycled species
+     *
+     * averaged over the sub-cycling steps, has the layout of FieldJ
+     *
+     * @return NULL if the species is pushed in each step or has no current solver
+     */
+    DeviceBuffer<FieldJ::ValueType, simDim>* getAveragedCurrent()
+    {
+        return averagedCurrent;
+    }
+
     /* sync device data to host
      *
      * ATTENTION: - in the current implementation only supercell meta data are copied!
@@ -130,6 +150,8 @@ private:
     FieldB *fieldB;
     FieldJ *fieldJcurrent;
     FieldTmp *fieldTmp;
+
+    DeviceBufferIntern<FieldJ::ValueType, simDim> *averagedCurrent;
 };
 
 namespace traits
@@ -34,18 +34,23 @@
 #include "fields/FieldE.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/FieldJ.kernel"
 
 #include "particles/memory/buffers/ParticlesBuffer.hpp"
 #include "ParticlesInit.kernel"
 #include "mappings/simulation/GridController.hpp"
 
 #include "simulationControl/MovingWindow.hpp"
+#include "simulationControl/ProfilePhase.hpp"
 
 #include "fields/numericalCellTypes/YeeCell.hpp"
 
 #include "traits/GetUniqueTypeId.hpp"
 #include "traits/Resolve.hpp"
 #include "particles/traits/GetMarginPusher.hpp"
+#include "particles/traits/GetSubCycling.hpp"
+#include "traits/GetMargin.hpp"
+#include "traits/HasFlag.hpp"
 
 #include <iostream>
 #include <cassert>
@@ -63,50 +68,70 @@ Particles<T_ParticleDescription>::Particles( GridLayout<simDim> gridLayout,
                                              SimulationDataId datasetID ) :
 ParticlesBase<T_ParticleDescription, MappingDesc>( cellDescription ),
 fieldB( NULL ), fieldE( NULL ), fieldJcurrent( NULL ), fieldTmp( NULL ), m_gridLayout(gridLayout),
-m_datasetID( datasetID )
+m_datasetID( datasetID ), averagedCurrent( NULL )
 {
     size_t sizeOfExchanges = 2 * 2 * ( BYTES_EXCHANGE_X + BYTES_EXCHANGE_Y + BYTES_EXCHANGE_Z ) + BYTES_EXCHANGE_X * 2 * 8;
 
 
     this->particlesBuffer = new BufferType( m_gridLayout.getDataSpace( ), m_gridLayout.getGuard( ) );
 
-    log<picLog::MEMORY > ( "size for all exchange = %1% MiB" ) % ( (float_64) sizeOfExchanges / 1024. / 1024. );
+    log<picLog::MEMORY > ( "initial size for all exchange = %1% MiB" ) % ( (float_64) sizeOfExchanges / 1024. / 1024. );
 
     const uint32_t commTag = PMacc::traits::GetUniqueTypeId<FrameType, uint32_t>::uid() + SPECIES_FIRSTTAG;
     log<picLog::MEMORY > ( "communication tag for species %1%: %2%" ) % FrameType::getName( ) % commTag;
 
     this->particlesBuffer->addExchange( Mask( LEFT ) + Mask( RIGHT ),
                                         BYTES_EXCHANGE_X,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     this->particlesBuffer->addExchange( Mask( TOP ) + Mask( BOTTOM ),
                                         BYTES_EXCHANGE_Y,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     //edges of the simulation area
     this->particlesBuffer->addExchange( Mask( RIGHT + TOP ) + Mask( LEFT + TOP ) +
                                         Mask( LEFT + BOTTOM ) + Mask( RIGHT + BOTTOM ), BYTES_EDGES,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
 
 #if(SIMDIM==DIM3)
     this->particlesBuffer->addExchange( Mask( FRONT ) + Mask( BACK ), BYTES_EXCHANGE_Z,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     //edges of the simulation area
     this->particlesBuffer->addExchange( Mask( FRONT + TOP ) + Mask( BACK + TOP ) +
                                         Mask( FRONT + BOTTOM ) + Mask( BACK + BOTTOM ),
                                         BYTES_EDGES,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     this->particlesBuffer->addExchange( Mask( FRONT + RIGHT ) + Mask( BACK + RIGHT ) +
                                         Mask( FRONT + LEFT ) + Mask( BACK + LEFT ),
                                         BYTES_EDGES,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     //corner of the simulation area
     this->particlesBuffer->addExchange( Mask( TOP + FRONT + RIGHT ) + Mask( TOP + BACK + RIGHT ) +
                                         Mask( BOTTOM + FRONT + RIGHT ) + Mask( BOTTOM + BACK + RIGHT ),
                                         BYTES_CORNER,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
     this->particlesBuffer->addExchange( Mask( TOP + FRONT + LEFT ) + Mask( TOP + BACK + LEFT ) +
                                         Mask( BOTTOM + FRONT + LEFT ) + Mask( BOTTOM + BACK + LEFT ),
                                         BYTES_CORNER,
-                                        commTag);
+                                        commTag,
+                                        BYTES_EXCHANGE_MAX);
+#endif
+
+#if (ENABLE_CURRENT == 1)
+    /* allocated before the particle heap, the current of a sub-cycled
+     * species is deposited only in its push steps */
+    if( HasFlag<FrameType, current<> >::type::value &&
+        traits::GetSubCycling<Particles>::type::getValue() != 1u )
+    {
+        averagedCurrent = new DeviceBufferIntern<FieldJ::ValueType, simDim>( m_gridLayout.getDataSpace( ) );
+        log<picLog::MEMORY > ( "averaged current of species %1%: %2% MiB" ) % FrameType::getName( ) %
+            ( (float_64) averagedCurrent->getDataSpace( ).productOfComponents( ) * sizeof( FieldJ::ValueType ) / 1024. / 1024. );
+    }
 #endif
 }
 
@@ -120,6 +145,7 @@ template< typename T_ParticleDescription>
 Particles<T_ParticleDescription>::~Particles( )
 {
     delete this->particlesBuffer;
+    __delete( averagedCurrent );
 }
 
 template< typename T_ParticleDescription>
@@ -151,18 +177,109 @@ void Particles<T_ParticleDescription>::init( FieldE &fieldE, FieldB &fieldB, Fie
     Environment<>::get( ).DataConnector( ).registerData( *this );
 }
 
-template<typename T_ParticleDescription>
-void Particles<T_ParticleDescription>::update(uint32_t )
+/** push all particles of a species and deposit their current in the same kernel
+ *
+ * Used if ENABLE_FUSED_PUSH_CURRENT is set, the current of the species is
+ * not calculated again after the particle communication.
+ *
+ * @tparam T_Species species type
+ * @tparam T_hasCurrentSolver false if the species has no current solver,
+ *         then nothing is done
+ */
+template<typename T_Species, bool T_hasCurrentSolver = HasFlag<typename T_Species::FrameType, current<> >::type::value>
+struct PushAndDepositCurrent
 {
-    typedef typename GetFlagType<FrameType,particlePusher<> >::type PusherAlias;
-    typedef typename PMacc::traits::Resolve<PusherAlias>::type ParticlePush;
+    /** launch the fused kernel for all stride classes of the active supercells
+     *
+     * @tparam T_BlockArea cached area of the fields E and B
+     * @tparam T_FrameSolver functor to push one particle
+     * @return true if the particles were pushed
+     */
+    template<typename T_BlockArea, typename T_FrameSolver>
+    static bool call(T_Species& species, FieldE& fieldE, FieldB& fieldB, FieldJ& fieldJ)
+    {
+        /* sub-cycled species deposit their averaged current each step (see
+         * ComputeSubCycledCurrent) and can not deposit during the push
+         */
+        if( traits::GetSubCycling<T_Species>::type::getValue() != 1u )
+            return false;
+
+        typedef typename T_Species::FrameType FrameType;
+        typedef typename PMacc::traits::Resolve<
+            typename GetFlagType<FrameType, current<> >::type
+        >::type ParticleCurrentSolver;
+
+        typedef ComputeCurrentPerFrame<ParticleCurrentSolver, Velocity, MappingDesc::SuperCellSize> CurrentSolver;
+
+        /* the particle can be one cell outside of the supercell when the current is deposited */
+        typedef typename PMacc::math::CT::make_Int<simDim, 1>::type OneCell;
+        typedef SuperCellDescription<
+            typename MappingDesc::SuperCellSize,
+            typename PMacc::math::CT::add<typename GetMargin<ParticleCurrentSolver>::LowerMargin, OneCell>::type,
+            typename PMacc::math::CT::add<typename GetMargin<ParticleCurrentSolver>::UpperMargin, OneCell>::type
+            > CurrentBlockArea;
+
+        dim3 block( MappingDesc::SuperCellSize::toRT().toDim3() );
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+
+        const uint32_t numStrideClasses = species.getActiveSuperCells( ).getNumStrideClasses( );
+        for( uint32_t strideClass = 0; strideClass < numStrideClasses; ++strideClass )
+        {
+            PMACC_AUTO( mapper, species.getActiveSuperCells( ).getStrideMapping( strideClass ) );
+            if( mapper.getSize( ) == 0 )
+                continue;
+
+            if(useElements)
+            {
+                using ElemSize = typename  MappingDesc::SuperCellSize;
+                __cudaKernel_OPTI( kernelMoveAndMarkAndDepositParticles<T_BlockArea, CurrentBlockArea, ElemSize>)( mapper.getGridDim( ), block )
+                    ( species.getDeviceParticlesBox( ),
+                      fieldE.getDeviceDataBox( ),
+                      fieldB.getDeviceDataBox( ),
+                      fieldJ.getDeviceDataBox( ),
+                      T_FrameSolver( ),
+                      CurrentSolver( DELTA_T ),
+                      mapper
+                      );
+            }
+            else
+            {
+                __cudaKernel( kernelMoveAndMarkAndDepositParticles<T_BlockArea, CurrentBlockArea>)( mapper.getGridDim( ), block )
+                    ( species.getDeviceParticlesBox( ),
+                      fieldE.getDeviceDataBox( ),
+                      fieldB.getDeviceDataBox( ),
+                      fieldJ.getDeviceDataBox( ),
+                      T_FrameSolver( ),
+                      CurrentSolver( DELTA_T ),
+                      mapper
+                      );
+            }
+        }
+        return true;
+    }
+};
+
+template<typename T_Species>
+struct PushAndDepositCurrent<T_Species, false>
+{
+    template<typename T_BlockArea, typename T_FrameSolver>
+    static bool call(T_Species&, FieldE&, FieldB&, FieldJ&)
+    {
+        return false;
+    }
+};
 
-    typedef typename PMacc::traits::Resolve<
-        typename GetFlagType<FrameType,interpolation<> >::type
-        >::type InterpolationScheme;
+template<typename T_ParticleDescription>
+void Particles<T_ParticleDescription>::update(uint32_t currentStep)
+{
+    /* a sub-cycled species is only pushed every N-th step, nothing is moved
+     * and therefore no shift is needed on the other steps
+     */
+    if( !traits::isPushStep<Particles>( currentStep ) )
+        return;
+    const float_X pushDeltaTime = traits::getPushDeltaTime<Particles>( );
 
-    typedef PushParticlePerFrame<ParticlePush, MappingDesc::SuperCellSize,
-        InterpolationScheme > FrameSolver;
+    typedef typename GetPushFrameSolver<Particles>::type FrameSolver;
 
     // adjust interpolation area in particle pusher to allow sub-sampling pushes
     typedef typename GetLowerMarginPusher<Particles>::type LowerMargin;
@@ -174,6 +291,24 @@ void Particles<T_ParticleDescription>::update(uint32_t )
         UpperMargin
         > BlockArea;
 
+    /* skip empty supercells, the pusher only marks particles therefore the
+     * list of supercells with particles is also valid for the shift
+     */
+    this->updateActiveSuperCells( );
+    if( this->getActiveSuperCells( ).getNumActive( ) == 0 )
+        return;
+
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_PUSH_CURRENT == 1)
+    if( PushAndDepositCurrent<Particles>::template call<BlockArea, FrameSolver>(
+            *this, *this->fieldE, *this->fieldB, *this->fieldJcurrent ) )
+    {
+        shiftPushedParticles( );
+        return;
+    }
+#endif
+
+    PMACC_AUTO( mapper, this->getActiveSuperCells( ).getMapping( ) );
+
     dim3 block( MappingDesc::SuperCellSize::toRT().toDim3() );
 
     constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
@@ -181,26 +316,37 @@ void Particles<T_ParticleDescription>::update(uint32_t )
     if(useElements)
     {
         using ElemSize = typename  MappingDesc::SuperCellSize;
-        __picKernelArea_OPTI( kernelMoveAndMarkParticles<BlockArea, ElemSize>)( this->cellDescription, CORE + BORDER )
-            (block)
+
+        /* one thread pushes a whole frame if the pusher has no margin */
+        typedef typename GetPushFrameSolver<Particles>::ElemType ElemFrameSolver;
+
+        __cudaKernel_OPTI( kernelMoveAndMarkParticles<BlockArea, ElemSize>)( mapper.getGridDim( ), block )
             ( this->getDeviceParticlesBox( ),
               this->fieldE->getDeviceDataBox( ),
               this->fieldB->getDeviceDataBox( ),
-              FrameSolver( )
+              ElemFrameSolver( pushDeltaTime ),
+              mapper
               );
     }
     else
     {
-        __picKernelArea( kernelMoveAndMarkParticles<BlockArea>)( this->cellDescription, CORE + BORDER )
-            (block)
+        __cudaKernel( kernelMoveAndMarkParticles<BlockArea>)( mapper.getGridDim( ), block )
             ( this->getDeviceParticlesBox( ),
               this->fieldE->getDeviceDataBox( ),
               this->fieldB->getDeviceDataBox( ),
-              FrameSolver( )
+              FrameSolver( pushDeltaTime ),
+              mapper
               );
     }
 
-    ParticlesBaseType::template shiftParticles < CORE + BORDER > ( );
+    shiftPushedParticles( );
+}
+
+template<typename T_ParticleDescription>
+void Particles<T_ParticleDescription>::shiftPushedParticles( )
+{
+    simulationControl::ProfilePhase phase( "shift" );
+    ParticlesBaseType::shiftActiveParticles( );
 }
 
 template< bool T_sequentialAcc>
@@ -236,9 +382,8 @@ void Particles<T_ParticleDescription>::initGas( T_GasFunctor& gasFunctor,
 
     const uint32_t numSlides = MovingWindow::getInstance( ).getSlideCounter( currentStep );
     const SubGrid<simDim>& subGrid = Environment<simDim>::get( ).SubGrid( );
-    DataSpace<simDim> localCells = subGrid.getLocalDomain( ).size;
     DataSpace<simDim> totalGpuCellOffset = subGrid.getLocalDomain( ).offset;
-    totalGpuCellOffset.y( ) += numSlides * localCells.y( );
+    totalGpuCellOffset += MovingWindow::getInstance( ).getSlideOffset( numSlides );
 
     dim3 block( MappingDesc::SuperCellSize::toRT( ).toDim3( ) );
 
@@ -246,7 +391,7 @@ void Particles<T_ParticleDescription>::initGas( T_GasFunctor& gasFunctor,
 
     using ElemSize = typename  MappingDesc::SuperCellSize;
     using Elems = typename bmpl::if_<bmpl::bool_<useElements>, ElemSize,  typename PMacc::math::CT::make_Int<simDim,1>::type::vector_type >::type;
-    AreaMapping<CORE + BORDER, MappingDesc> mapper(this->cellDescription);
+    PMACC_AUTO( mapper, MovingWindow::getInstance( ).getInitMapping( this->cellDescription ) );
 
     /// \todo because of the reason that the random number generator is fixed to an accelerator we need to do this hack
     using MyKernel = kernelFillGridWithParticles<Particles<T_ParticleDescription>, Elems >;
@@ -266,16 +411,17 @@ void Particles<T_ParticleDescription>::deviceDeriveFrom( Particles< T_SrcParticl
     dim3 block( cellsInSupercell );
 
     log<picLog::SIMULATION_STATE > ( "derive species %1%" ) % FrameType::getName( );
+    PMACC_AUTO( mapper, MovingWindow::getInstance( ).getInitMapping( this->cellDescription ) );
     constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
     if(useElements)
     {
-        __picKernelArea_OPTI( kernelDeriveParticles<cellsInSupercell>)( this->cellDescription, CORE + BORDER )
-            (block) ( this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor );
+        __cudaKernel_OPTI( kernelDeriveParticles<cellsInSupercell>)( mapper.getGridDim( ), block )
+            ( this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor, mapper );
     }
     else
     {
-        __picKernelArea( kernelDeriveParticles<>)( this->cellDescription, CORE + BORDER )
-            (block) ( this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor );
+        __cudaKernel( kernelDeriveParticles<>)( mapper.getGridDim( ), block )
+            ( this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor, mapper );
     }
     this->fillAllGaps( );
 }
@@ -287,21 +433,22 @@ void Particles<T_ParticleDescription>::manipulateAllParticles( uint32_t currentS
 
     dim3 block( MappingDesc::SuperCellSize::toRT( ).toDim3( ) );
 
+    PMACC_AUTO( mapper, MovingWindow::getInstance( ).getInitMapping( this->cellDescription ) );
     constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
     if(useElements)
     {
         using ElemSize = typename  MappingDesc::SuperCellSize;
-        __picKernelArea_OPTI( kernelManipulateAllParticles<ElemSize>)( this->cellDescription, CORE + BORDER )
-            (block)
+        __cudaKernel_OPTI( kernelManipulateAllParticles<ElemSize>)( mapper.getGridDim( ), block )
             ( this->particlesBuffer->getDeviceParticleBox( ),
-              functor );
+              functor,
+              mapper );
     }
     else
     {
-        __picKernelArea( kernelManipulateAllParticles<>)( this->cellDescription, CORE + BORDER )
-            (block)
+        __cudaKernel( kernelManipulateAllParticles<>)( mapper.getGridDim( ), block )
             ( this->particlesBuffer->getDeviceParticleBox( ),
-              functor );
+              functor,
+              mapper );
     }
 }
 
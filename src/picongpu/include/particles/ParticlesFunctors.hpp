@@ -29,17 +29,29 @@
 #include "math/MapTuple.hpp"
 #include <boost/mpl/plus.hpp>
 #include <boost/mpl/accumulate.hpp>
+#include <boost/mpl/size.hpp>
 
 
 #include "communication/AsyncCommunication.hpp"
+#include "simulationControl/ProfilePhase.hpp"
 #include "particles/traits/GetIonizer.hpp"
 #include "particles/traits/FilterByFlag.hpp"
+#include "particles/memory/buffers/MallocMCBuffer.hpp"
 
-#if 0
 #include "particles/traits/GetPhotonCreator.hpp"
+#include "particles/traits/GetMarginPusher.hpp"
+#include "particles/traits/GetSubCycling.hpp"
+#include "particles/Particles.kernel"
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "compileTime/conversion/SeqToMap.hpp"
+#include "compileTime/conversion/RemoveFromSeq.hpp"
+#include "compileTime/conversion/TypeToPointerPair.hpp"
+#include "mappings/kernel/AreaMapping.hpp"
+#include "dataManagement/DataConnector.hpp"
 #include "particles/synchrotronPhotons/SynchrotronFunctions.hpp"
 #include "particles/creation/creation.hpp"
-#endif
+#include "particles/merging/MomentumBinning.hpp"
 
 namespace picongpu
 {
@@ -95,12 +107,15 @@ struct CallCreateParticleBuffer
     {
 
         typedef typename SpeciesType::FrameType FrameType;
-#if (PMACC_CUDA_ENABLED == 1)
-        log<picLog::MEMORY >("mallocMC: free slots for species %3%: %1% a %2%") %
-            mallocMC::getAvailableSlots(sizeof (FrameType)) %
+
+        DataConnector &dc = Environment<>::get().DataConnector();
+        MallocMCBuffer& frameHeap = dc.getData<MallocMCBuffer> (MallocMCBuffer::getName(), true);
+        log<picLog::MEMORY >("frame heap: free slots for species %3%: %1% a %2%") %
+            frameHeap.getAvailableSlots(sizeof (FrameType)) %
             sizeof (FrameType) %
             FrameType::getName();
-#endif
+        dc.releaseData(MallocMCBuffer::getName());
+
         tuple[SpeciesName()]->createParticleBuffer();
     }
 };
@@ -136,6 +151,28 @@ struct CallReset
     }
 };
 
+/** move a species by one supercell against the move direction of the window
+ *
+ * The particles which left the local domain are send to the neighbors.
+ *
+ * @tparam T_SpeciesName name of particle species
+ */
+template<typename T_SpeciesName>
+struct SlideSpecies
+{
+    typedef T_SpeciesName SpeciesName;
+    typedef typename SpeciesName::type SpeciesType;
+
+    template<typename T_StorageTuple>
+    HINLINE void operator()(T_StorageTuple& tuple,
+                            const uint32_t direction,
+                            EventTask& commEvent) const
+    {
+        tuple[SpeciesName()]->slideSuperCells(direction);
+        commEvent += communication::asyncCommunication(*tuple[SpeciesName()], __getTransactionEvent());
+    }
+};
+
 /** push a species
  *
  * push is only triggered for species with a pusher
@@ -158,6 +195,7 @@ struct PushSpecies
                             ) const
     {
         PMACC_AUTO(speciesPtr, tuple[SpeciesName()]);
+        simulationControl::ProfilePhase phase(FrameType::getName());
 
         __startTransaction(eventInt);
         speciesPtr->update(currentStep);
@@ -168,7 +206,8 @@ struct PushSpecies
 
 /** Communicate a species
  *
- * communication is only triggered for species with a pusher
+ * communication is only triggered for species with a pusher and skipped in
+ * steps where a sub-cycled species is not pushed
  *
  * @tparam T_SpeciesName name of particle species that is checked
  */
@@ -182,17 +221,203 @@ struct CommunicateSpecies
     template<typename T_StorageTuple, typename T_EventList>
     HINLINE void operator()(
                             T_StorageTuple& tuple,
+                            const uint32_t currentStep,
                             T_EventList& updateEventList,
                             T_EventList& commEventList
                             ) const
     {
+        simulationControl::ProfilePhase phase(FrameType::getName() + "Exchange");
         EventTask updateEvent(*(updateEventList.begin()));
 
         updateEventList.pop_front();
+        if( !traits::isPushStep<SpeciesType>( currentStep ) )
+        {
+            /* no particle was moved */
+            commEventList.push_back( updateEvent );
+            return;
+        }
         commEventList.push_back( communication::asyncCommunication(*tuple[SpeciesName()], updateEvent) );
     }
 };
 
+/** create mpl pair <MakeIdentifier<Species>,ParticlesBoxType of the species>
+ *
+ * @tparam T_Species species type
+ */
+template<typename T_Species>
+struct TypeToParticlesBoxPair
+{
+    typedef bmpl::pair< typename MakeIdentifier<T_Species>::type, typename T_Species::ParticlesBoxType > type;
+};
+
+/** create mpl pair <MakeIdentifier<Species>,push frame solver of the species>
+ *
+ * @tparam T_Species species type
+ * @tparam T_useElements bmpl::true_ to select the frame solver for accelerators
+ *         with one thread per supercell (see GetPushFrameSolver)
+ */
+template<typename T_Species, typename T_useElements>
+struct TypeToPushFrameSolverPair
+{
+    typedef typename bmpl::if_<
+        T_useElements,
+        typename GetPushFrameSolver<T_Species>::ElemType,
+        typename GetPushFrameSolver<T_Species>::type
+    >::type FrameSolver;
+
+    typedef bmpl::pair< typename MakeIdentifier<T_Species>::type, FrameSolver > type;
+};
+
+/** copy the device particle box of a species into a math::MapTuple
+ *
+ * @tparam T_SpeciesName name of particle species
+ */
+template<typename T_SpeciesName>
+struct CopyDeviceParticlesBox
+{
+    typedef T_SpeciesName SpeciesName;
+
+    template<typename T_ParBoxes, typename T_StorageTuple>
+    HINLINE void operator()(T_ParBoxes& parBoxes, T_StorageTuple& tuple) const
+    {
+        parBoxes[SpeciesName()] = tuple[SpeciesName()]->getDeviceParticlesBox();
+    }
+};
+
+template<typename T_SpeciesName>
+struct CallUpdateActiveSuperCells
+{
+    typedef T_SpeciesName SpeciesName;
+
+    template<typename T_StorageTuple>
+    HINLINE void operator()(T_StorageTuple& tuple) const
+    {
+        tuple[SpeciesName()]->updateActiveSuperCells();
+    }
+};
+
+/** move the pushed particles of a species to their new supercells
+ *
+ * @tparam T_SpeciesName name of particle species
+ */
+template<typename T_SpeciesName>
+struct ShiftSpecies
+{
+    typedef T_SpeciesName SpeciesName;
+    typedef typename SpeciesName::type SpeciesType;
+    typedef typename SpeciesType::FrameType FrameType;
+
+    template<typename T_StorageTuple, typename T_EventList>
+    HINLINE void operator()(
+                            T_StorageTuple& tuple,
+                            const EventTask& pushEvent,
+                            T_EventList& updateEvent
+                            ) const
+    {
+        PMACC_AUTO(speciesPtr, tuple[SpeciesName()]);
+        simulationControl::ProfilePhase phase(FrameType::getName());
+
+        __startTransaction(pushEvent);
+        speciesPtr->shiftPushedParticles();
+        EventTask ev = __endTransaction();
+        updateEvent.push_back(ev);
+    }
+};
+
+/** push several species with one kernel
+ *
+ * Same as PushSpecies for each species, but the fields E and B are loaded
+ * only once per supercell (see kernelMoveAndMarkAllSpecies).
+ * The cached field area is the maximum of the pusher margins of all species.
+ *
+ * @tparam T_SpeciesSeq sequence with the species to push
+ */
+template<typename T_SpeciesSeq>
+struct PushSpeciesTogether
+{
+    template<typename T_StorageTuple, typename T_CellDescription, typename T_EventList>
+    HINLINE void operator()(
+                            T_StorageTuple& tuple,
+                            T_CellDescription* cellDesc,
+                            const EventTask& eventInt,
+                            T_EventList& updateEvent
+                            ) const
+    {
+        typedef typename PMacc::math::CT::make_Int<simDim, 0>::type NoMargin;
+
+        typedef typename bmpl::accumulate<
+            T_SpeciesSeq,
+            NoMargin,
+            PMacc::math::CT::max<bmpl::_1, GetLowerMarginPusher<bmpl::_2> >
+            >::type LowerMargin;
+
+        typedef typename bmpl::accumulate<
+            T_SpeciesSeq,
+            NoMargin,
+            PMacc::math::CT::max<bmpl::_1, GetUpperMarginPusher<bmpl::_2> >
+            >::type UpperMargin;
+
+        typedef SuperCellDescription<
+            typename MappingDesc::SuperCellSize,
+            LowerMargin,
+            UpperMargin
+            > BlockArea;
+
+        typedef typename SeqToMap<T_SpeciesSeq, TypeToParticlesBoxPair<bmpl::_1> >::type ParBoxesMap;
+        typedef typename SeqToMap<T_SpeciesSeq, TypeToPushFrameSolverPair<bmpl::_1, bmpl::false_> >::type FrameSolversMap;
+        typedef typename SeqToMap<T_SpeciesSeq, TypeToPushFrameSolverPair<bmpl::_1, bmpl::true_> >::type ElemFrameSolversMap;
+
+        PMacc::math::MapTuple<ParBoxesMap> parBoxes;
+
+        __startTransaction(eventInt);
+        {
+            simulationControl::ProfilePhase phase("pushAllSpecies");
+
+            ForEach<T_SpeciesSeq, CallUpdateActiveSuperCells<bmpl::_1>, MakeIdentifier<bmpl::_1> > updateActiveSuperCells;
+            updateActiveSuperCells(forward(tuple));
+            ForEach<T_SpeciesSeq, CopyDeviceParticlesBox<bmpl::_1>, MakeIdentifier<bmpl::_1> > copyParticlesBoxes;
+            copyParticlesBoxes(forward(parBoxes), forward(tuple));
+
+            DataConnector &dc = Environment<>::get().DataConnector();
+            FieldE& fieldE = dc.getData<FieldE > (FieldE::getName(), true);
+            FieldB& fieldB = dc.getData<FieldB > (FieldB::getName(), true);
+
+            AreaMapping<CORE + BORDER, MappingDesc> mapper(*cellDesc);
+            dim3 block( MappingDesc::SuperCellSize::toRT().toDim3() );
+
+            constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+            if(useElements)
+            {
+                using ElemSize = typename  MappingDesc::SuperCellSize;
+                __cudaKernel_OPTI( kernelMoveAndMarkAllSpecies<T_SpeciesSeq, BlockArea, ElemSize>)( mapper.getGridDim( ), block )
+                    ( parBoxes,
+                      fieldE.getDeviceDataBox( ),
+                      fieldB.getDeviceDataBox( ),
+                      PMacc::math::MapTuple<ElemFrameSolversMap>( ),
+                      mapper
+                      );
+            }
+            else
+            {
+                __cudaKernel( kernelMoveAndMarkAllSpecies<T_SpeciesSeq, BlockArea>)( mapper.getGridDim( ), block )
+                    ( parBoxes,
+                      fieldE.getDeviceDataBox( ),
+                      fieldB.getDeviceDataBox( ),
+                      PMacc::math::MapTuple<FrameSolversMap>( ),
+                      mapper
+                      );
+            }
+
+            dc.releaseData(FieldE::getName());
+            dc.releaseData(FieldB::getName());
+        }
+        EventTask pushEvent = __endTransaction();
+
+        ForEach<T_SpeciesSeq, ShiftSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > shiftSpecies;
+        shiftSpecies(forward(tuple), pushEvent, forward(updateEvent));
+    }
+};
+
 /** update momentum, move and communicate all species */
 struct PushAllSpecies
 {
@@ -200,14 +425,17 @@ struct PushAllSpecies
     /** push and communicate all species
      *
      * @tparam T_SpeciesStorage type of the speciesStorage
+     * @tparam T_CellDescription type of the cell description
      * @param speciesStorage struct with all species (e.g. `PMacc::math::MapTuple`)
+     * @param cellDesc cell description of the local domain
      * @param currentStep current simulation step
      * @param pushEvent[out] grouped event that marks the end of the species push
      * @param commEvent[out] grouped event that marks the end of the species communication
      */
-    template<typename T_SpeciesStorage>
+    template<typename T_SpeciesStorage, typename T_CellDescription>
     HINLINE void operator()(
                             T_SpeciesStorage& speciesStorage,
+                            T_CellDescription* cellDesc,
                             const uint32_t currentStep,
                             const EventTask& eventInt,
                             EventTask& pushEvent,
@@ -224,8 +452,37 @@ struct PushAllSpecies
             VectorAllSpecies,
             particlePusher<>
         >::type VectorSpeciesWithPusher;
-        ForEach<VectorSpeciesWithPusher, particles::PushSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > pushSpecies;
-        pushSpecies(forward(speciesStorage), currentStep, eventInt, forward(updateEventList));
+        /* species with a sub-cycling flag are pushed with their own time step
+         * and only in their push steps, all other species can share one kernel
+         */
+        typedef typename PMacc::particles::traits::FilterByFlag
+        <
+            VectorSpeciesWithPusher,
+            subCycling<>
+        >::type VectorSubCycledSpecies;
+        typedef typename RemoveFromSeq<
+            VectorSpeciesWithPusher,
+            VectorSubCycledSpecies
+        >::type VectorRegularSpecies;
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_PUSH_CURRENT == 1)
+        /* the fused push deposits the current of each species separately */
+        const bool pushTogether = false;
+#else
+        /* the common kernel pushes all species with DELTA_T */
+        const bool pushTogether = bmpl::size<VectorRegularSpecies>::type::value > 1;
+#endif
+        if (pushTogether)
+        {
+            PushSpeciesTogether<VectorRegularSpecies> pushSpecies;
+            pushSpecies(speciesStorage, cellDesc, eventInt, updateEventList);
+        }
+        else
+        {
+            ForEach<VectorRegularSpecies, particles::PushSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > pushSpecies;
+            pushSpecies(forward(speciesStorage), currentStep, eventInt, forward(updateEventList));
+        }
+        ForEach<VectorSubCycledSpecies, particles::PushSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > pushSubCycledSpecies;
+        pushSubCycledSpecies(forward(speciesStorage), currentStep, eventInt, forward(updateEventList));
 
         /* join all push events */
         for (typename EventList::iterator iter = updateEventList.begin();
@@ -235,9 +492,11 @@ struct PushAllSpecies
             pushEvent += *iter;
         }
 
-        /* call communication for all species */
-        ForEach<VectorSpeciesWithPusher, particles::CommunicateSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > communicateSpecies;
-        communicateSpecies(forward(speciesStorage), forward(updateEventList), forward(commEventList));
+        /* call communication for all species in the order of updateEventList */
+        ForEach<VectorRegularSpecies, particles::CommunicateSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > communicateSpecies;
+        communicateSpecies(forward(speciesStorage), currentStep, forward(updateEventList), forward(commEventList));
+        ForEach<VectorSubCycledSpecies, particles::CommunicateSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > communicateSubCycledSpecies;
+        communicateSubCycledSpecies(forward(speciesStorage), currentStep, forward(updateEventList), forward(commEventList));
 
         /* join all communication events */
         for (typename EventList::iterator iter = commEventList.begin();
@@ -249,7 +508,6 @@ struct PushAllSpecies
     }
 };
 
-#if 0
 /** \struct CallIonization
  *
  * \brief Tests if species can be ionized and calls the kernel to do that
@@ -295,35 +553,51 @@ struct CallIonization
             /* alias for pointer on destination species */
             PMACC_AUTO(electronsPtr,  tuple[typename MakeIdentifier<DestSpecies>::type()]);
 
-            /* 3-dim vector : number of threads to be started in every dimension */
-            dim3 block( MappingDesc::SuperCellSize::toRT().toDim3() );
-
-            /** kernelIonizeParticles
-             * \brief calls the ionization model and handles that electrons are created correctly
-             *        while cycling through the particle frames
-             *
-             * kernel call : instead of name<<<blocks, threads>>> (args, ...)
-             * "blocks" will be calculated from "this->cellDescription" and "CORE + BORDER"
-             * "threads" is calculated from the previously defined vector "block"
+            /* ionize the source species and create the electrons:
+             * the ionizer is called by the generic particle creation kernel
+             * which also fills the gaps in the electron frames
              */
-            __picKernelArea( particles::ionization::kernelIonizeParticles)( *cellDesc, CORE + BORDER )
-                (block)
-                ( srcSpeciesPtr->getDeviceParticlesBox( ),
-                  electronsPtr->getDeviceParticlesBox( ),
-                  SelectIonizer(currentStep)
-                );
-            /* fill the gaps in the created species' particle frames to ensure that only
-             * the last frame is not completely filled but every other before is full
-             */
-            electronsPtr->fillAllGaps();
-
+            creation::createParticlesFromSpecies(*srcSpeciesPtr, *electronsPtr, SelectIonizer(currentStep), cellDesc);
         }
     }
 
 }; // struct CallIonization
-#endif
 
-#if 0
+/** Merges the macro particles of a species
+ *
+ * \tparam T_SpeciesName name of particle species with the flag `particleMerger<>`
+ */
+template<typename T_SpeciesName>
+struct CallParticleMerger
+{
+    typedef T_SpeciesName SpeciesName;
+    typedef typename SpeciesName::type SpeciesType;
+    typedef typename SpeciesType::FrameType FrameType;
+    typedef typename PMacc::traits::Resolve<
+        typename GetFlagType<FrameType, particleMerger<> >::type
+    >::type SelectedMerger;
+
+    /** Functor implementation
+     *
+     * \tparam T_StorageStuple contains info about the particle species
+     * \tparam T_CellDescription contains the number of blocks and blocksize
+     *                           that is later passed to the kernel
+     * \param tuple An n-tuple containing the type-info of multiple particle species
+     * \param cellDesc points to logical block information like dimension and cell sizes
+     * \param currentStep The current time step
+     */
+    template<typename T_StorageTuple, typename T_CellDescription>
+    HINLINE void operator()(
+                            T_StorageTuple& tuple,
+                            T_CellDescription* cellDesc,
+                            const uint32_t currentStep
+                            ) const
+    {
+        PMACC_AUTO(speciesPtr, tuple[SpeciesName()]);
+        SelectedMerger::merge(*speciesPtr, cellDesc, currentStep);
+    }
+};
+
 /** Handles the synchrotron radiation emission of photons from electrons
  *
  * \tparam T_SpeciesName name of electron species
@@ -363,15 +637,14 @@ struct CallSynchrotronPhotons
         using namespace synchrotronPhotons;
         SelectedPhotonCreator photonCreator(
             synchrotronFunctions.getCursor(SynchrotronFunctions::first),
-            synchrotronFunctions.getCursor(SynchrotronFunctions::second));
+            synchrotronFunctions.getCursor(SynchrotronFunctions::second),
+            currentStep);
 
         creation::createParticlesFromSpecies(*electronSpeciesPtr, *photonSpeciesPtr, photonCreator, cellDesc);
     }
 
 }; // struct CallSynchrotronPhotons
 
-#endif
-
 } // namespace particles
 
 } // namespace picongpu
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "pmacc_types.hpp"
+
+#include "nvidia/rng/RNG.hpp"
+#include "nvidia/rng/methods/Philox.hpp"
+#include "nvidia/rng/distributions/UniformFromBits_float.hpp"
+#include "mpi/SeedPerRank.hpp"
+#include "traits/GetUniqueTypeId.hpp"
+
+namespace picongpu
+{
+namespace particles
+{
+namespace creation
+{
+
+    namespace nvrng = PMacc::nvidia::rng;
+
+    /** uniform random numbers in [0.0,1.0) for Monte Carlo particle creation
+     *
+     * The counter based generator is keyed with the seed and the linear index
+     * of the supercell, each cell of the supercell draws from an own stream.
+     * Therefore the generator needs neither an accelerator nor a stored state
+     * and can be created per worker element inside of a kernel.
+     *
+     * \tparam T_SpeciesType species which is the source of the creation process
+     * \tparam T_seed seed of the physical process \see seed.param
+     */
+    template<typename T_SpeciesType, uint32_t T_seed>
+    struct RandomNrForMonteCarlo
+    {
+        typedef T_SpeciesType SpeciesType;
+        typedef MappingDesc::SuperCellSize SuperCellSize;
+
+        HINLINE RandomNrForMonteCarlo(uint32_t currentStep)
+        {
+            typedef typename SpeciesType::FrameType FrameType;
+
+            GlobalSeed globalSeed;
+            mpi::SeedPerRank<simDim> seedPerRank;
+            /* creates global seed that is unique for
+             * the particle species and the creation process
+             */
+            seed = globalSeed() ^
+                   PMacc::traits::GetUniqueTypeId<FrameType, uint32_t>::uid() ^
+                   T_seed;
+            /* makes the seed unique for each MPI rank (GPU)
+             * and each time step
+             */
+            seed = seedPerRank(seed) ^ currentStep;
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            /* size of the local domain on the designated GPU in units of supercells */
+            localSuperCells = subGrid.getLocalDomain().size / SuperCellSize::toRT();
+        }
+
+        /** select the random number stream of a cell
+         *
+         * @param localCellIdx cell index in the local domain (without guarding supercells)
+         */
+        DINLINE void init(const DataSpace<simDim>& localCellIdx)
+        {
+            const DataSpace<simDim> superCellIdx = localCellIdx / SuperCellSize::toRT();
+            const uint32_t linearSuperCellIdx = DataSpaceOperations<simDim>::map(
+                localSuperCells,
+                superCellIdx);
+            const uint32_t linearCellInSuperCell = DataSpaceOperations<simDim>::template map<SuperCellSize>(
+                localCellIdx - superCellIdx * SuperCellSize::toRT());
+
+            rng = nvrng::create(
+                nvrng::methods::Philox(seed, linearSuperCellIdx, linearCellInSuperCell),
+                nvrng::distributions::UniformFromBits_float());
+        }
+
+        DINLINE float_X operator()()
+        {
+            return rng();
+        }
+
+        private:
+            typedef nvrng::RNG<
+                nvrng::methods::Philox,
+                nvrng::distributions::UniformFromBits_float
+            > RngType;
+
+            PMACC_ALIGN(rng, RngType);
+            PMACC_ALIGN(seed, uint32_t);
+            PMACC_ALIGN(localSuperCells, DataSpace<simDim>);
+    };
+
+} // namespace creation
+} // namespace particles
+} // namespace picongpu
@@ -22,8 +22,6 @@
 
 #include "particles/creation/creation.kernel"
 #include "simulation_defines.hpp"
-#include "cuSTL/algorithm/kernel/Foreach.hpp"
-#include "cuSTL/cursor/MultiIndexCursor.hpp"
 
 namespace picongpu
 {
@@ -34,14 +32,19 @@ namespace particles
 namespace creation
 {
 
-/** Calls the `createParticlesKernel` kernel to create new particles.
+/** Calls the `CreateParticlesKernel` kernel to create new particles.
  *
  * @param sourceSpecies species from which new particles are created
  * @param targetSpecies species of the created particles
  * @param particleCreator functor that defines the particle creation
  * @param cellDesc mapping description
  *
- * `particleCreator` must define: `init()`, `numNewParticles()` and `operator()()`
+ * `particleCreator` must define:
+ *   - `collectiveInit<T_numWorkers>(acc, blockCell, workerIdx)`: called by all threads
+ *     of a block, e.g. to cache fields in shared memory
+ *   - `init(localCellIdx)`: called once per cell on a copy of the creator,
+ *     e.g. to select the random number stream of the cell
+ *   - `numNewParticles(acc, sourceFrame, localIdx)` and `operator()(acc, source, target)`
  * \see `PhotonCreator.hpp` for a further description.
  */
 template<typename T_SourceSpecies, typename T_TargetSpecies, typename T_ParticleCreator, typename T_CellDescription>
@@ -50,25 +53,29 @@ void createParticlesFromSpecies(T_SourceSpecies& sourceSpecies,
                                 T_ParticleCreator particleCreator,
                                 T_CellDescription* cellDesc)
 {
-    typedef typename MappingDesc::SuperCellSize SuperCellSize;
-    const PMacc::math::Int<simDim> coreBorderGuardSuperCells = cellDesc->getGridSuperCells();
-    const uint32_t guardSuperCells = cellDesc->getGuardingSuperCells();
-    const PMacc::math::Int<simDim> coreBorderSuperCells = coreBorderGuardSuperCells - 2*guardSuperCells;
+    const int cellsInSupercell = PMacc::math::CT::volume<typename MappingDesc::SuperCellSize>::type::value;
 
-    /* Functor holding the actual generic particle creation kernel */
-    PMACC_AUTO(createParticlesKernel, make_CreateParticlesKernel(
-        sourceSpecies.getDeviceParticlesBox(),
-        targetSpecies.getDeviceParticlesBox(),
-        particleCreator,
-        guardSuperCells));
+    dim3 block( cellsInSupercell );
 
-    /* This zone represents the core+border area with guard offset in unit of cells */
-    const zone::SphericZone<simDim> zone(
-        static_cast<PMacc::math::Size_t<simDim> >(coreBorderSuperCells * SuperCellSize::toRT()),
-        guardSuperCells * SuperCellSize::toRT());
-
-    algorithm::kernel::Foreach<SuperCellSize> foreach;
-    foreach(zone, cursor::make_MultiIndexCursor<simDim>(), createParticlesKernel);
+    constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+    if(useElements)
+    {
+        __picKernelArea_OPTI( CreateParticlesKernel<cellsInSupercell>)( *cellDesc, CORE + BORDER )
+            (block)
+            ( sourceSpecies.getDeviceParticlesBox( ),
+              targetSpecies.getDeviceParticlesBox( ),
+              particleCreator
+            );
+    }
+    else
+    {
+        __picKernelArea( CreateParticlesKernel<>)( *cellDesc, CORE + BORDER )
+            (block)
+            ( sourceSpecies.getDeviceParticlesBox( ),
+              targetSpecies.getDeviceParticlesBox( ),
+              particleCreator
+            );
+    }
 
     /* Make sure to leave no gaps in newly created frames */
     targetSpecies.fillAllGaps();
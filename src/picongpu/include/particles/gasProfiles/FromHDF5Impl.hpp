@@ -53,9 +53,8 @@ struct FromHDF5Impl : public T_ParamClass
         PMACC_AUTO(window, MovingWindow::getInstance().getWindow(currentStep));
         loadHDF5(window);
         const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-        DataSpace<simDim> localCells = subGrid.getLocalDomain( ).size;
         DataSpace<simDim> totalGpuOffset = subGrid.getLocalDomain( ).offset;
-        totalGpuOffset.y( ) += numSlides * localCells.y( );
+        totalGpuOffset += MovingWindow::getInstance( ).getSlideOffset( numSlides );
     }
 
     /** Calculate the gas density from HDF5 file
@@ -74,7 +73,7 @@ private:
     {
         using namespace splash;
         DataConnector &dc = Environment<>::get().DataConnector();
-        FieldTmp& fieldTmp = dc.getData<FieldTmp > (FieldTmp::getName(), true);
+        FieldTmp& fieldTmp = dc.getData<FieldTmpCache > (FieldTmpCache::getName(), true).getScratchField();
         PMACC_AUTO(&fieldBuffer, fieldTmp.getGridBuffer());
 
         deviceDataBox = fieldBuffer.getDeviceBuffer().getDataBox();
@@ -101,8 +100,7 @@ private:
             pdc.open(ParamClass::filename, attr);
 
             /* set which part of the hdf5 file our MPI rank reads */
-            DataSpace<simDim> globalSlideOffset;
-            globalSlideOffset.y() = numSlides * localDomain.size.y();
+            const DataSpace<simDim> globalSlideOffset(MovingWindow::getInstance().getSlideOffset(numSlides));
 
             Dimensions domainOffset(0, 0, 0);
             for (uint32_t d = 0; d < simDim; ++d)
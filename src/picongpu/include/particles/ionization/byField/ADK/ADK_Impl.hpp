@@ -29,7 +29,10 @@
 
 #include "particles/ionization/byField/ADK/ADK.def"
 #include "particles/ionization/byField/ADK/AlgorithmADK.hpp"
-#include "particles/ionization/ionization.hpp"
+#include "particles/Particles.hpp"
+#include "mappings/threads/ThreadCollective.hpp"
+#include "nvidia/functors/Assign.hpp"
+#include "memory/boxes/CachedBox.hpp"
 
 #include "compileTime/conversion/TypeToPointerPair.hpp"
 #include "memory/boxes/DataBox.hpp"
@@ -113,18 +116,22 @@ namespace ionization
 
             }
 
-            /** Initialization function on device
+            /** Collective initialization function on device
              *
              * \brief Cache EM-fields on device
-             *         and initialize possible prerequisites for ionization, like e.g. random number generator.
              *
-             * This function will be called inline on the device which must happen BEFORE threads diverge
-             * during loop execution. The reason for this is the `__syncthreads()` call which is necessary after
-             * initializing the E-/B-field shared boxes in shared memory.
+             * Called by all threads of a block, the particle creation kernel
+             * synchronizes the threads afterwards.
+             *
+             * \tparam T_numWorkers number of threads in the block
+             *
+             * @param blockCell Offset of the cell from the origin of the local domain
+             *                  <b>including guarding supercells</b> in units of cells
+             * @param workerIdx Linear thread ID inside the block
              */
-            DINLINE void init(const DataSpace<simDim>& blockCell, const int& linearThreadIdx, const DataSpace<simDim>& localCellOffset)
+            template<int T_numWorkers, typename T_Acc>
+            DINLINE void collectiveInit(const T_Acc& acc, const DataSpace<simDim>& blockCell, const int workerIdx)
             {
-
                 /* caching of E and B fields */
                 cachedB = CachedBox::create < 0, ValueType_B > (acc, BlockArea());
                 cachedE = CachedBox::create < 1, ValueType_E > (acc, BlockArea());
@@ -133,7 +140,7 @@ namespace ionization
                 nvidia::functors::Assign assign;
                 /* copy fields from global to shared */
                 PMACC_AUTO(fieldBBlock, bBox.shift(blockCell));
-                ThreadCollective<BlockArea> collective(linearThreadIdx);
+                ThreadCollective<BlockArea, T_numWorkers> collective(workerIdx);
                 collective(
                           assign,
                           cachedB,
@@ -146,22 +153,32 @@ namespace ionization
                           cachedE,
                           fieldEBlock
                           );
+            }
 
-                /* initialize random number generator with the local cell index in the simulation*/
-                randomGen.init(localCellOffset);
-
-                /* wait for shared memory to be initialized */
-                __syncthreads();
+            /** Initialization function per cell on device
+             *
+             * \brief Initialize possible prerequisites for ionization, like e.g. random number generator.
+             *
+             * @param localCellIdx Offset of the cell from the origin of the local
+             *                     domain, i.e. from the @see BORDER
+             *                     <b>without guarding supercells</b>
+             */
+            DINLINE void init(const DataSpace<simDim>& localCellIdx)
+            {
+                /* initialize random number generator with the local cell index in the simulation */
+                randomGen.init(localCellIdx);
             }
 
-            /** Functor implementation
+            /** Ionize a particle and return the number of electrons to create
+             *
+             * Called for each particle of a frame of the ionized species.
              *
              * \param ionFrame reference to frame of the to-be-ionized particles
              * \param localIdx local (linear) index in super cell / frame
-             * \param newMacroElectrons reference to variable for each thread that stores the number
-             *        of macro electrons to be created during the current time step
+             * \return number of macro electrons to be created during the current time step
              */
-            DINLINE void operator()(FrameType& ionFrame, int localIdx, unsigned int& newMacroElectrons)
+            template<typename T_Acc>
+            DINLINE unsigned int numNewParticles(const T_Acc& acc, FrameType& ionFrame, int localIdx)
             {
                 /* alias for the single macro-particle */
                 PMACC_AUTO(particle,ionFrame[localIdx]);
@@ -190,8 +207,22 @@ namespace ionization
                      );
 
                 /* determine number of new macro electrons to be created */
-                newMacroElectrons = prevBoundElectrons - particle[boundElectrons_];
+                return prevBoundElectrons - particle[boundElectrons_];
+            }
 
+            /** Functor implementation: create one electron from the ion
+             *
+             * \tparam T_parentIon type of the particle which is ionized
+             * \tparam T_childElectron type of the electron that will be created
+             */
+            template<typename T_Acc, typename T_parentIon, typename T_childElectron>
+            DINLINE void operator()(const T_Acc& acc, T_parentIon& parentIon, T_childElectron& childElectron)
+            {
+                /* create an electron in the new electron frame:
+                 * - see particles/ionization/ionizationMethods.hpp
+                 */
+                WriteElectronIntoFrame writeElectron;
+                writeElectron(parentIon, childElectron);
             }
 
     };
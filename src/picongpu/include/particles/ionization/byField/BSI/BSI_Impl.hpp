@@ -31,12 +31,15 @@
 #include "particles/ionization/byField/BSI/AlgorithmBSIHydrogenLike.hpp"
 #include "particles/ionization/byField/BSI/AlgorithmBSIEffectiveZ.hpp"
 #include "particles/ionization/byField/BSI/AlgorithmBSIStarkShifted.hpp"
-#include "particles/ionization/ionization.hpp"
+#include "particles/Particles.hpp"
+#include "mappings/threads/ThreadCollective.hpp"
+#include "nvidia/functors/Assign.hpp"
+#include "memory/boxes/CachedBox.hpp"
 
 #include "compileTime/conversion/TypeToPointerPair.hpp"
 #include "memory/boxes/DataBox.hpp"
 
-#include "particles/ParticlesFunctors.hpp"
+#include "particles/ionization/ionizationMethods.hpp"
 
 namespace picongpu
 {
@@ -104,32 +107,29 @@ namespace ionization
 
             }
 
-            /** Initialization function on device
+            /** Collective initialization function on device
              *
              * \brief Cache EM-fields on device
-             *         and initialize possible prerequisites for ionization, like e.g. random number generator.
              *
-             * This function will be called inline on the device which must happen BEFORE threads diverge
-             * during loop execution. The reason for this is the `__syncthreads()` call which is necessary after
-             * initializing the E-/B-field shared boxes in shared memory.
+             * Called by all threads of a block, the particle creation kernel
+             * synchronizes the threads afterwards.
+             *
+             * \tparam T_numWorkers number of threads in the block
              *
              * @param blockCell Offset of the cell from the origin of the local domain
              *                  <b>including guarding supercells</b> in units of cells
-             * @param linearThreadIdx Linearized thread ID inside the block
-             * @param localCellOffset Offset of the cell from the origin of the local
-             *                        domain, i.e. from the @see BORDER
-             *                        <b>without guarding supercells</b>
+             * @param workerIdx Linear thread ID inside the block
              */
-            DINLINE void init(const DataSpace<simDim>& blockCell, const int& linearThreadIdx, const DataSpace<simDim>& localCellOffset)
+            template<int T_numWorkers, typename T_Acc>
+            DINLINE void collectiveInit(const T_Acc& acc, const DataSpace<simDim>& blockCell, const int workerIdx)
             {
-
                 /* caching of E field */
                 cachedE = CachedBox::create < 1, ValueType_E > (acc, BlockArea());
 
                 /* instance of nvidia assignment operator */
                 nvidia::functors::Assign assign;
 
-                ThreadCollective<BlockArea> collective(linearThreadIdx);
+                ThreadCollective<BlockArea, T_numWorkers> collective(workerIdx);
                 /* copy fields from global to shared */
                 PMACC_AUTO(fieldEBlock, eBox.shift(blockCell));
                 collective(
@@ -139,14 +139,29 @@ namespace ionization
                           );
             }
 
-            /** Functor implementation
+            /** Initialization function per cell on device
+             *
+             * \brief Initialize possible prerequisites for ionization, like e.g. random number generator.
+             *
+             * @param localCellIdx Offset of the cell from the origin of the local
+             *                     domain, i.e. from the @see BORDER
+             *                     <b>without guarding supercells</b>
+             */
+            DINLINE void init(const DataSpace<simDim>& localCellIdx)
+            {
+                /* no per cell state */
+            }
+
+            /** Ionize a particle and return the number of electrons to create
+             *
+             * Called for each particle of a frame of the ionized species.
              *
              * \param ionFrame reference to frame of the to-be-ionized particles
              * \param localIdx local (linear) index in super cell / frame
-             * \param newMacroElectrons reference to variable for each thread that stores the number
-             *        of macro electrons to be created during the current time step
+             * \return number of macro electrons to be created during the current time step
              */
-            DINLINE void operator()(FrameType& ionFrame, int localIdx, unsigned int& newMacroElectrons)
+            template<typename T_Acc>
+            DINLINE unsigned int numNewParticles(const T_Acc& acc, FrameType& ionFrame, int localIdx)
             {
                 /* alias for the single macro-particle */
                 PMACC_AUTO(particle,ionFrame[localIdx]);
@@ -160,20 +175,32 @@ namespace ionization
                 ValueType_E eField = Field2ParticleInterpolation()
                     (cachedE.shift(localCell).toCursor(), pos, fieldPosE());
 
-                /* define number of bound macro electrons before ionization */
-                float_X prevBoundElectrons = particle[boundElectrons_];
-
                 /* this is the point where actual ionization takes place */
                 IonizationAlgorithm ionizeAlgo;
                 /* determine number of new macro electrons to be created */
-                newMacroElectrons = ionizeAlgo(
+                const unsigned int newMacroElectrons = ionizeAlgo(
                                                 eField,
                                                 particle
                                               );
 
-                /* relocate this to writeElectronIntoFrame in ionizationMethods.hpp */
                 particle[boundElectrons_] -= float_X(newMacroElectrons);
 
+                return newMacroElectrons;
+            }
+
+            /** Functor implementation: create one electron from the ion
+             *
+             * \tparam T_parentIon type of the particle which is ionized
+             * \tparam T_childElectron type of the electron that will be created
+             */
+            template<typename T_Acc, typename T_parentIon, typename T_childElectron>
+            DINLINE void operator()(const T_Acc& acc, T_parentIon& parentIon, T_childElectron& childElectron)
+            {
+                /* create an electron in the new electron frame:
+                 * - see particles/ionization/ionizationMethods.hpp
+                 */
+                WriteElectronIntoFrame writeElectron;
+                writeElectron(parentIon, childElectron);
             }
 
     };
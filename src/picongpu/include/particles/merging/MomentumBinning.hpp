@@ -0,0 +1,123 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "particles/merging/MomentumBinning.def"
+#include "particles/merging/MomentumBinning.kernel"
+#include "traits/HasIdentifier.hpp"
+#include "traits/GetFlagType.hpp"
+#include "traits/Resolve.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/simulation/GridController.hpp"
+
+#include <boost/type_traits/is_same.hpp>
+#include <mpi.h>
+
+namespace picongpu
+{
+namespace particles
+{
+namespace merging
+{
+
+template<typename T_Param>
+struct MomentumBinning
+{
+    typedef T_Param Param;
+
+    /** merge the macro particles of a species
+     *
+     * Is called every time step, merges only every `Param::period` steps.
+     * The number of removed macro particles of all devices is logged with
+     * the log level PHYSICS.
+     * Must be called collectively by all MPI ranks.
+     *
+     * \param species species which is merged, the gaps in the frames are
+     *        filled afterwards
+     * \param cellDesc mapping description
+     * \param currentStep current simulation step
+     */
+    template<typename T_Species, typename T_CellDescription>
+    static void merge(T_Species& species, T_CellDescription* cellDesc, const uint32_t currentStep)
+    {
+        typedef typename T_Species::FrameType FrameType;
+
+        /* the charge of the merged particles must be the same */
+        PMACC_CASSERT_MSG(
+            Merging_of_species_with_bound_electrons_is_not_supported,
+            !HasIdentifier<FrameType, boundElectrons>::type::value
+        );
+
+        if (currentStep % Param::period != 0)
+            return;
+
+        /* photons carry a dummy mass */
+        typedef typename PMacc::traits::Resolve<
+            typename GetFlagType<FrameType, particlePusher<> >::type
+        >::type ParticlePush;
+        constexpr bool isMassless = boost::is_same<ParticlePush, particles::pusher::Photon>::value;
+
+        GridBuffer<uint64_cu, DIM1> numRemovedParticles(DataSpace<DIM1>(1));
+        numRemovedParticles.getDeviceBuffer().setValue(0);
+
+        const int cellsInSupercell = PMacc::math::CT::volume<typename MappingDesc::SuperCellSize>::type::value;
+        dim3 block( cellsInSupercell );
+
+        constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+        if(useElements)
+        {
+            __picKernelArea_OPTI( KernelMergeParticles<Param, isMassless, cellsInSupercell> )( *cellDesc, CORE + BORDER )
+                (block)
+                ( species.getDeviceParticlesBox( ),
+                  numRemovedParticles.getDeviceBuffer().getBasePointer( )
+                );
+        }
+        else
+        {
+            __picKernelArea( KernelMergeParticles<Param, isMassless> )( *cellDesc, CORE + BORDER )
+                (block)
+                ( species.getDeviceParticlesBox( ),
+                  numRemovedParticles.getDeviceBuffer().getBasePointer( )
+                );
+        }
+
+        species.fillAllGaps();
+
+        numRemovedParticles.deviceToHost();
+        uint64_t localRemoved = numRemovedParticles.getHostBuffer().getDataBox()[0];
+        uint64_t globalRemoved = 0;
+
+        GridController<simDim>& gc = Environment<simDim>::get().GridController();
+        MPI_CHECK(MPI_Reduce(
+            &localRemoved, &globalRemoved, 1, MPI_UINT64_T, MPI_SUM, 0,
+            gc.getCommunicator().getMPIComm()
+        ));
+        if (gc.getGlobalRank() == 0)
+            log<picLog::PHYSICS >("merging %1%: removed %2% macro particles") %
+                FrameType::getName() % globalRemoved;
+    }
+};
+
+} // namespace merging
+} // namespace particles
+} // namespace picongpu
@@ -43,6 +43,13 @@ namespace picongpu
             typedef typename PMacc::math::CT::make_Int<simDim,0>::type LowerMargin;
             typedef typename PMacc::math::CT::make_Int<simDim,0>::type UpperMargin;
 
+            /** @param deltaTime time step of one push, longer than DELTA_T if the
+             *                   species is sub-cycled
+             */
+            HDINLINE Push(const float_X deltaTime = DELTA_T) : m_deltaTime(deltaTime)
+            {
+            }
+
             enum coords
             {
                 x = 0,
@@ -80,7 +87,7 @@ namespace picongpu
                 Gamma gammaCalc;
                 Velocity velocityCalc;
                 const float_X epsilon = 1.0e-6;
-                const float_X deltaT = DELTA_T;
+                const float_X deltaT = m_deltaTime;
 
                 //const float3_X velocity_atMinusHalf = velocity(mom, mass);
                 const float_X gamma = gammaCalc( mom, mass );
@@ -196,6 +203,9 @@ namespace picongpu
                 propList["param"] = "semi analytical, Axel Huebl (2011)";
                 return propList;
             }
+
+        private:
+            PMACC_ALIGN(m_deltaTime, const float_X);
         };
     } //namespace
 }
@@ -38,6 +38,13 @@ struct Push
     typedef typename PMacc::math::CT::make_Int<simDim,0>::type LowerMargin;
     typedef typename PMacc::math::CT::make_Int<simDim,0>::type UpperMargin;
 
+    /** @param deltaTime time step of one push, longer than DELTA_T if the
+     *                   species is sub-cycled
+     */
+    HDINLINE Push(const float_X deltaTime = DELTA_T) : m_deltaTime(deltaTime)
+    {
+    }
+
     template<typename T_FunctorFieldE, typename T_FunctorFieldB, typename T_Pos, typename T_Mom, typename T_Mass,
              typename T_Charge, typename T_Weighting>
          DINLINE void operator()(
@@ -56,7 +63,7 @@ struct Push
 
         const float_X QoM = charge / mass;
 
-        const float_X deltaT = DELTA_T;
+        const float_X deltaT = m_deltaTime;
 
         const MomType mom_minus = mom + float_X(0.5) * charge * eField * deltaT;
 
@@ -86,6 +93,9 @@ struct Push
         PMacc::traits::StringProperty propList( "name", "Boris" );
         return propList;
     }
+
+private:
+    PMACC_ALIGN(m_deltaTime, const float_X);
 };
 } //namespace particlePusherBoris
 } //namepsace  picongpu
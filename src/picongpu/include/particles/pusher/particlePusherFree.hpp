@@ -37,6 +37,13 @@ namespace picongpu
             typedef typename PMacc::math::CT::make_Int<simDim,0>::type LowerMargin;
             typedef typename PMacc::math::CT::make_Int<simDim,0>::type UpperMargin;
 
+            /** @param deltaTime time step of one push, longer than DELTA_T if the
+             *                   species is sub-cycled
+             */
+            HDINLINE Push(const float_X deltaTime = DELTA_T) : m_deltaTime(deltaTime)
+            {
+            }
+
             template<typename T_FunctorFieldE, typename T_FunctorFieldB, typename T_Pos, typename T_Mom, typename T_Mass,
                      typename T_Charge, typename T_Weighting>
                     DINLINE void operator()(
@@ -56,7 +63,7 @@ namespace picongpu
 
                 for(uint32_t d=0;d<simDim;++d)
                 {
-                    pos[d] += (vel[d] * DELTA_T) / cellSize[d];
+                    pos[d] += (vel[d] * m_deltaTime) / cellSize[d];
                 }
             }
 
@@ -66,6 +73,9 @@ namespace picongpu
                 propList["param"] = "free streaming";
                 return propList;
             }
+
+        private:
+            PMACC_ALIGN(m_deltaTime, const float_X);
         };
     } //namespace
 }
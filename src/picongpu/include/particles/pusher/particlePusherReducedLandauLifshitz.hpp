@@ -51,6 +51,13 @@ struct Push
   typedef typename PMacc::math::CT::make_Int<simDim,1>::type LowerMargin;
   typedef typename PMacc::math::CT::make_Int<simDim,1>::type UpperMargin;
 
+  /** @param deltaTime time step of one push, longer than DELTA_T if the
+   *                   species is sub-cycled
+   */
+  HDINLINE Push(const float_X deltaTime = DELTA_T) : m_deltaTime(deltaTime)
+  {
+  }
+
   template<typename T_FunctorFieldB, typename T_FunctorFieldE, typename T_Pos, typename T_Mom,
            typename T_Mass, typename T_Charge, typename T_Weighting >
   DINLINE void operator()(
@@ -70,7 +77,7 @@ struct Push
     typedef T_Charge TypeCharge;
     typedef T_Weighting TypeWeighting;
 
-    const float_X deltaT = DELTA_T;
+    const float_X deltaT = m_deltaTime;
     const uint32_t dimMomentum = GetNComponents<TypeMomentum>::value;
     // the transver data type adjust to 3D3V, 2D3V, 2D2V, ...
     typedef PMacc::math::Vector< picongpu::float_X, simDim + dimMomentum > VariableType;
@@ -196,6 +203,9 @@ struct Push
       return propList;
   }
 
+private:
+  PMACC_ALIGN(m_deltaTime, const float_X);
+
 };
 } //namespace particlePusherReducedLandauLifshitz
 } //namespace picongpu
@@ -38,6 +38,13 @@ struct Push
     typedef typename PMacc::math::CT::make_Int<simDim,0>::type LowerMargin;
     typedef typename PMacc::math::CT::make_Int<simDim,0>::type UpperMargin;
 
+    /** @param deltaTime time step of one push, longer than DELTA_T if the
+     *                   species is sub-cycled
+     */
+    HDINLINE Push(const float_X deltaTime = DELTA_T) : m_deltaTime(deltaTime)
+    {
+    }
+
     template<typename T_FunctorFieldE, typename T_FunctorFieldB, typename T_Pos, typename T_Mom, typename T_Mass,
              typename T_Charge, typename T_Weighting >
         DINLINE void operator()(
@@ -60,7 +67,7 @@ struct Push
      Here the real (PIConGPU) momentum (p) is used, not the momentum from the Vay paper (u)
      p = m_0 * u
          */
-        const float_X deltaT = DELTA_T;
+        const float_X deltaT = m_deltaTime;
         const float_X factor = 0.5 * charge * deltaT;
         Gamma gamma;
         Velocity velocity;
@@ -93,7 +100,7 @@ struct Push
 
         for(uint32_t d=0;d<simDim;++d)
         {
-            pos[d] += (vel[d] * DELTA_T) / cellSize[d];
+            pos[d] += (vel[d] * deltaT) / cellSize[d];
         }
     }
 
@@ -102,6 +109,9 @@ struct Push
         PMacc::traits::StringProperty propList( "name", "Vay" );
         return propList;
     }
+
+private:
+    PMACC_ALIGN(m_deltaTime, const float_X);
 };
 } //namespace particlePusherVay
 } //namespace picongpu
@@ -127,7 +127,7 @@ struct RandomImpl
         const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
         localCells = subGrid.getLocalDomain().size;
         totalGpuOffset = subGrid.getLocalDomain( ).offset;
-        totalGpuOffset.y( ) += numSlides * localCells.y( );
+        totalGpuOffset += MovingWindow::getInstance( ).getSlideOffset( numSlides );
     }
 
     template<typename T_Acc>
@@ -33,9 +33,10 @@
 #include "particles/operations/Deselect.hpp"
 #include "particles/traits/ResolveAliasFromSpecies.hpp"
 
-#include "random/methods/XorMin.hpp"
-#include "random/distributions/Uniform.hpp"
-#include "random/RNGProvider.hpp"
+#include "particles/creation/RandomNrForMonteCarlo.hpp"
+#include "mappings/threads/ThreadCollective.hpp"
+#include "nvidia/functors/Assign.hpp"
+#include "memory/boxes/CachedBox.hpp"
 
 #include "traits/Resolve.hpp"
 #include "mappings/kernel/AreaMapping.hpp"
@@ -112,20 +113,22 @@ private:
     PMACC_ALIGN(photon_mom, float3_X);
 
     /* random number generator */
-    typedef PMacc::random::RNGProvider<simDim, PMacc::random::methods::XorMin> RNGFactory;
-    typedef PMacc::random::distributions::Uniform<float> Distribution;
-    typedef typename RNGFactory::GetRandomType<Distribution>::type RandomGen;
+    typedef particles::creation::RandomNrForMonteCarlo<
+        ElectronSpecies,
+        SYNCHROTRON_PHOTONS_SEED
+    > RandomGen;
     RandomGen randomGen;
 
 public:
     /* host constructor initializing member : random number generator */
     PhotonCreator(
         const SynchrotronFunctions::SyncFuncCursor& curF_1,
-        const SynchrotronFunctions::SyncFuncCursor& curF_2)
+        const SynchrotronFunctions::SyncFuncCursor& curF_2,
+        const uint32_t currentStep)
             : curF_1(curF_1),
               curF_2(curF_2),
               photon_mom(float3_X::create(0)),
-              randomGen(RNGFactory::createRandom<Distribution>())
+              randomGen(currentStep)
     {
         DataConnector &dc = Environment<>::get().DataConnector();
         /* initialize pointers on host-side E-(B-)field databoxes */
@@ -136,26 +139,31 @@ public:
         bBox = fieldB->getDeviceDataBox();
     }
 
-    /** Initialization function on device
+    /** Collective initialization function on device
      *
      * \brief Cache EM-fields on device
-     *         and initialize possible prerequisites for ionization, like e.g. random number generator.
      *
-     * This function will be called inline on the device which must happen BEFORE threads diverge
-     * during loop execution. The reason for this is the `__syncthreads()` call which is necessary after
-     * initializing the E-/B-field shared boxes in shared memory.
+     * Called by all threads of a block, the particle creation kernel
+     * synchronizes the threads afterwards.
+     *
+     * \tparam T_numWorkers number of threads in the block
+     *
+     * @param blockCell Offset of the cell from the origin of the local domain
+     *                  <b>including guarding supercells</b> in units of cells
+     * @param workerIdx Linear thread ID inside the block
      */
-    DINLINE void init(const DataSpace<simDim>& blockCell, const int& linearThreadIdx, const DataSpace<simDim>& localCellOffset)
+    template<int T_numWorkers, typename T_Acc>
+    DINLINE void collectiveInit(const T_Acc& acc, const DataSpace<simDim>& blockCell, const int workerIdx)
     {
         /* caching of E and B fields */
-        cachedB = CachedBox::create < 0, ValueType_B > (BlockArea());
-        cachedE = CachedBox::create < 1, ValueType_E > (BlockArea());
+        cachedB = CachedBox::create < 0, ValueType_B > (acc, BlockArea());
+        cachedE = CachedBox::create < 1, ValueType_E > (acc, BlockArea());
 
         /* instance of nvidia assignment operator */
         nvidia::functors::Assign assign;
         /* copy fields from global to shared */
         PMACC_AUTO(fieldBBlock, bBox.shift(blockCell));
-        ThreadCollective<BlockArea> collective(linearThreadIdx);
+        ThreadCollective<BlockArea, T_numWorkers> collective(workerIdx);
         collective(
                   assign,
                   cachedB,
@@ -168,12 +176,18 @@ public:
                   cachedE,
                   fieldEBlock
                   );
+    }
 
-        /* wait for shared memory to be initialized */
-        __syncthreads();
-
-        /* initialize random number generator with the local cell index in the simulation */
-        this->randomGen.init(localCellOffset);
+    /** Initialization function per cell on device
+     *
+     * \brief Initialize the random number generator with the local cell index in the simulation
+     *
+     * @param localCellIdx Offset of the cell from the origin of the local
+     *                     domain <b>without guarding supercells</b>
+     */
+    DINLINE void init(const DataSpace<simDim>& localCellIdx)
+    {
+        this->randomGen.init(localCellIdx);
     }
 
     /** Get the photon emission probability
@@ -240,7 +254,8 @@ public:
      * @param localIdx Index of the source particle within frame
      * @return number of particle to be created from each source particle
      */
-    DINLINE unsigned int numNewParticles(FrameType& sourceFrame, int localIdx)
+    template<typename T_Acc>
+    DINLINE unsigned int numNewParticles(const T_Acc& acc, FrameType& sourceFrame, int localIdx)
     {
         using namespace PMacc::algorithms;
 
@@ -321,8 +336,8 @@ public:
      * \tparam Electron type of electron which creates the photon
      * \tparam Photon type of photon that is created
      */
-    template<typename Electron, typename Photon>
-    DINLINE void operator()(Electron& electron, Photon& photon) const
+    template<typename T_Acc, typename Electron, typename Photon>
+    DINLINE void operator()(const T_Acc& acc, Electron& electron, Photon& photon) const
     {
         namespace parOp = PMacc::particles::operations;
         PMACC_AUTO(destPhoton,
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "traits/GetFlagType.hpp"
+#include "traits/Resolve.hpp"
+
+#include <boost/mpl/if.hpp>
+
+namespace picongpu
+{
+namespace traits
+{
+
+namespace detail
+{
+    value_identifier(uint32_t, DefaultSubCycling, 1u);
+} //namespace detail
+
+
+/** get the sub-cycling factor of a species
+ *
+ * A species with the factor N is pushed only every N-th time step with the
+ * time step N * DELTA_T. The factor is set to 1 (push each step) if no
+ * alias `subCycling<>` is defined.
+ *
+ * @treturn ::type `value_identifier` with the sub-cycling factor
+ */
+template<typename T_Species>
+struct GetSubCycling
+{
+    typedef typename T_Species::FrameType FrameType;
+    typedef typename HasFlag<FrameType, subCycling<> >::type hasSubCycling;
+    typedef typename PMacc::traits::Resolve<
+        typename GetFlagType<
+            FrameType, subCycling<>
+        >::type
+    >::type SubCyclingOfSpecies;
+
+    typedef typename bmpl::if_<
+         hasSubCycling,
+        SubCyclingOfSpecies,
+        detail::DefaultSubCycling
+    >::type type;
+};
+
+/** true if the species is pushed in the given time step
+ *
+ * @tparam T_Species species type
+ * @param currentStep current simulation step
+ */
+template<typename T_Species>
+HINLINE bool isPushStep(const uint32_t currentStep)
+{
+    return currentStep % GetSubCycling<T_Species>::type::getValue() == 0u;
+}
+
+/** time step of one push of a species
+ *
+ * @tparam T_Species species type
+ * @return DELTA_T times the sub-cycling factor
+ */
+template<typename T_Species>
+HDINLINE float_X getPushDeltaTime()
+{
+    return DELTA_T * float_X(GetSubCycling<T_Species>::type::getValue());
+}
+
+} //namespace traits
+
+}// namespace picongpu
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
 
 #include "pmacc_types.hpp"
 #include "simulation_defines.hpp"
@@ -213,6 +214,8 @@ private:
     std::string filename;
 
     float_64 * binReduced;
+    /* host copy of the local histogram, read by notifyConcurrent() */
+    float_64 * binLocal;
 
     uint32_t notifyPeriod;
     int numBins;
@@ -241,6 +244,8 @@ public:
     filename(analyzerPrefix + ".dat"),
     particles(NULL),
     gBins(NULL),
+    binReduced(NULL),
+    binLocal(NULL),
     cellDescription(NULL),
     notifyPeriod(0),
     writeToFile(false),
@@ -262,6 +267,19 @@ public:
         calBinEnergyParticles < CORE + BORDER > (currentStep);
     }
 
+    bool isConcurrentNotify() const
+    {
+        return true;
+    }
+
+    /* reduce and write the histogram copied to binLocal in notify(),
+     * does not use the event system
+     */
+    void notifyConcurrent(uint32_t currentStep)
+    {
+        writeBinEnergyParticles(currentStep);
+    }
+
     void pluginRegisterHelp(po::options_description& desc)
     {
         desc.add_options()
@@ -336,9 +354,11 @@ private:
             /* create an array of float_64 on gpu und host */
             gBins = new GridBuffer<float_64, DIM1 > (DataSpace<DIM1 > (realNumBins));
             binReduced = new float_64[realNumBins];
+            binLocal = new float_64[realNumBins];
             for (int i = 0; i < realNumBins; ++i)
             {
                 binReduced[i] = 0.0;
+                binLocal[i] = 0.0;
             }
 
             writeToFile = reduce.hasResult(mpi::reduceMethods::Reduce());
@@ -364,6 +384,7 @@ private:
 
             __delete(gBins);
             __deleteArray(binReduced);
+            __deleteArray(binLocal);
         }
     }
 
@@ -417,10 +438,20 @@ private:
              maxEnergy, maximumSlopeToDetectorX, maximumSlopeToDetectorZ);
 
         gBins->deviceToHost();
+        __getTransactionEvent().waitForFinished();
 
+        /* the host buffer belongs to the event system, the concurrent
+         * notification reads a plain copy
+         */
+        const float_64* hostBins = gBins->getHostBuffer().getBasePointer();
+        std::copy(hostBins, hostBins + realNumBins, binLocal);
+    }
+
+    void writeBinEnergyParticles(uint32_t currentStep)
+    {
         reduce(nvidia::functors::Add(),
                binReduced,
-               gBins->getHostBuffer().getBasePointer(),
+               binLocal,
                realNumBins, mpi::reduceMethods::Reduce());
 
 
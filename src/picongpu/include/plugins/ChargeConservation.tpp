@@ -26,6 +26,7 @@
 #include "cuSTL/container/PseudoBuffer.hpp"
 #include "dataManagement/DataConnector.hpp"
 #include "fields/FieldJ.hpp"
+#include "fields/FieldTmpCache.hpp"
 #include "math/Vector.hpp"
 #include "cuSTL/algorithm/mpi/Gather.hpp"
 #include "cuSTL/container/DeviceBuffer.hpp"
@@ -187,8 +188,8 @@ void ChargeConservation::notify(uint32_t currentStep)
 
     DataConnector &dc = Environment<>::get().DataConnector();
 
-    /* load FieldTmp without copy data to host */
-    FieldTmp* fieldTmp = &(dc.getData<FieldTmp > (FieldTmp::getName(), true));
+    /* load a FieldTmp of the derived field cache without copy data to host */
+    FieldTmp* fieldTmp = &(dc.getData<FieldTmpCache > (FieldTmpCache::getName(), true).getScratchField());
     /* reset density values to zero */
     fieldTmp->getGridBuffer().getDeviceBuffer().setValue(FieldTmp::ValueType(0.0));
 
@@ -269,7 +269,8 @@ private:
             }
 
             const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
-            size_t physicelYCellOffset = numSlides * yLocalSize + window.globalDimensions.offset.y();
+            size_t physicelYCellOffset = MovingWindow::getInstance().getSlideOffset(numSlides).y() +
+                window.globalDimensions.offset.y();
             writeFile(currentStep,
                       maxAll + window.globalDimensions.offset.y(),
                       window.globalDimensions.size.y(),
@@ -122,9 +122,10 @@ namespace picongpu
             splash::Dimensions globalPhaseSpace_offset( 0, 0, 0 );
             int globalMovingWindowOffset = 0;
             int globalMovingWindowSize   = rGlobalSize;
-            if( axis_element.space == AxisDescription::y ) /* spatial axis == y */
+            if( axis_element.space == MovingWindow::getInstance( ).getMoveDirection( ) ) /* spatial axis == move direction */
             {
-                globalPhaseSpace_offset.set( 0, numSlides * rLocalSize, 0 );
+                const DataSpace<simDim> slideOffset( MovingWindow::getInstance( ).getSlideOffset( numSlides ) );
+                globalPhaseSpace_offset.set( 0, slideOffset[axis_element.space], 0 );
                 Window window = MovingWindow::getInstance( ).getWindow( currentStep );
                 globalMovingWindowOffset = window.globalDimensions.offset[axis_element.space];
                 globalMovingWindowSize = window.globalDimensions.size[axis_element.space];
@@ -267,11 +267,10 @@ private:
              gParticle->getDeviceBuffer().getBasePointer());
         gParticle->deviceToHost();
 
-        DataSpace<simDim> localSize(cellDescription->getGridLayout().getDataSpaceWithoutGuarding());
         const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
 
         DataSpace<simDim> gpuPhyCellOffset(Environment<simDim>::get().SubGrid().getLocalDomain().offset);
-        gpuPhyCellOffset.y() += (localSize.y() * numSlides);
+        gpuPhyCellOffset += MovingWindow::getInstance().getSlideOffset(numSlides);
 
         gParticle->getHostBuffer().getDataBox()[0].globalCellOffset += gpuPhyCellOffset;
 
@@ -43,6 +43,7 @@
 #include "fields/FieldE.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/FieldTmpCache.hpp"
 #include "particles/operations/CountParticles.hpp"
 
 #include "dataManagement/DataConnector.hpp"
@@ -231,19 +232,14 @@ private:
 
             /*## update field ##*/
 
-            /*load FieldTmp without copy data to host*/
-            FieldTmp* fieldTmp = &(dc.getData<FieldTmp > (FieldTmp::getName(), true));
+            /*load derived field cache without copy data to host*/
+            FieldTmpCache& fieldTmpCache = dc.getData<FieldTmpCache > (FieldTmpCache::getName(), true);
             /*load particle without copy particle data to host*/
             Species* speciesTmp = &(dc.getData<Species >(Species::FrameType::getName(), true));
 
-            fieldTmp->getGridBuffer().getDeviceBuffer().setValue(ValueType::create(0.0));
-            /*run algorithm*/
-            fieldTmp->computeValue < CORE + BORDER, Solver > (*speciesTmp, params->currentStep);
-
-            EventTask fieldTmpEvent = fieldTmp->asyncCommunication(__getTransactionEvent());
-            __setTransactionEvent(fieldTmpEvent);
-            /* copy data to host that we can write same to disk*/
-            fieldTmp->getGridBuffer().deviceToHost();
+            /*run algorithm (or reuse the result of this step) and copy data to host
+             *that we can write same to disk*/
+            FieldTmp* fieldTmp = &(fieldTmpCache.getDerivedField<Solver>(*speciesTmp, params->currentStep, true));
             dc.releaseData(Species::FrameType::getName());
             /*## finish update field ##*/
 
@@ -259,7 +255,7 @@ private:
                        getName(),
                        fieldTmp->getHostDataBox().getPointer());
 
-            dc.releaseData(FieldTmp::getName());
+            dc.releaseData(FieldTmpCache::getName());
 
         }
 
@@ -363,10 +359,8 @@ private:
          * and origin at current time step
          * ATTENTION: splash offset are globalSlideOffset + picongpu offsets
          */
-        DataSpace<simDim> globalSlideOffset;
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
         const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(params->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const DataSpace<simDim> globalSlideOffset(MovingWindow::getInstance().getSlideOffset(numSlides));
 
         std::vector<float_64> gridGlobalOffset(simDim, 0.0);
         for( uint32_t d = 0; d < simDim; ++d )
@@ -690,9 +684,11 @@ public:
         log<picLog::INPUT_OUTPUT > ("ADIOS: Setting slide count for moving window to %1%") % slides;
         MovingWindow::getInstance().setSlideCounter(slides, restartStep);
 
-        /* re-distribute the local offsets in y-direction */
+        /* re-distribute the local offsets in move direction
+         * (incremental slides do not rotate the gpus) */
         GridController<simDim> &gc = Environment<simDim>::get().GridController();
-        if( MovingWindow::getInstance().isSlidingWindowActive() )
+        if( MovingWindow::getInstance().isSlidingWindowActive() &&
+            !MovingWindow::getInstance().isIncrementalSlides() )
             gc.setStateAfterSlides(slides);
 
         /* set window for restart, complete global domain */
@@ -956,10 +952,10 @@ private:
         ThreadParams *threadParams = (ThreadParams*) (p_args);
         threadParams->adiosGroupSize = 0;
 
-        /* y direction can be negative for first gpu */
+        /* move direction can be negative for first gpu */
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
         DataSpace<simDim> particleOffset(localDomain.offset);
-        particleOffset.y() -= threadParams->window.globalDimensions.offset.y();
+        particleOffset -= threadParams->window.globalDimensions.offset;
 
         /* create adios group for fields without statistics */
         ADIOS_CMD(adios_declare_group(&(threadParams->adiosGroupHandle),
@@ -976,13 +972,10 @@ private:
         /* write created variable values */
         for (uint32_t d = 0; d < simDim; ++d)
         {
-            /* dimension 1 is y and is the direction of the moving window (if any) */
-            if (1 == d)
-            {
-                uint64_t offset = std::max(0, localDomain.offset.y() -
-                                              threadParams->window.globalDimensions.offset.y());
-                threadParams->fieldsOffsetDims[d] = offset;
-            }
+            /* the window offset is only non-zero in the direction of the moving window (if any) */
+            uint64_t offset = std::max(0, localDomain.offset[d] -
+                                          threadParams->window.globalDimensions.offset[d]);
+            threadParams->fieldsOffsetDims[d] = offset;
 
             threadParams->fieldsSizeDims[d] = threadParams->window.localDimensions.size[d];
             threadParams->fieldsGlobalSizeDims[d] = threadParams->window.globalDimensions.size[d];
@@ -174,6 +174,9 @@ public:
                 (uint32_t)FieldType::numComponents,
                 FieldType::getName(),
                 tp);
+        /* loadField already uploaded the grid buffer, fields which are not
+         * stored in its layout copy it on the device */
+        field->applyGridBuffer();
 
         dc.releaseData(FieldType::getName());
 #endif
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <pthread.h>
+#include <atomic>
 #include <sstream>
 #include <string>
 #include <list>
@@ -41,6 +42,7 @@
 #include "fields/FieldE.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/FieldTmpCache.hpp"
 #include "particles/particleFilter/FilterFactory.hpp"
 #include "particles/particleFilter/PositionFilter.hpp"
 #include "particles/operations/CountParticles.hpp"
@@ -101,7 +103,12 @@ public:
     outputDirectory("h5"),
     checkpointFilename("checkpoint"),
     restartFilename(""), /* set to checkpointFilename by default */
-    notifyPeriod(0)
+    notifyPeriod(0),
+    checkpointAsync(false),
+    checkpointComm(MPI_COMM_NULL),
+    checkpointWriterActive(false),
+    checkpointWriterDone(false),
+    checkpointWriterFailed(false)
     {
         Environment<>::get().PluginConnector().registerPlugin(this);
     }
@@ -128,7 +135,12 @@ public:
              * frame overflow in our memory manager if we process all particles in one kernel.
              **/
             ("hdf5.restart-chunkSize", po::value<uint32_t > (&restartChunkSize)->default_value(1000000),
-             "Number of particles processed in one kernel call during restart to prevent frame count blowup");
+             "Number of particles processed in one kernel call during restart to prevent frame count blowup")
+            /* only the particles of two batches are hold in host memory
+             * while dumping a species, one is copied while the other is
+             * written */
+            ("hdf5.particle-batch", po::value<uint32_t > (&particleBatchSize)->default_value(4),
+             "Number of supercells in the last dimension whose particles are copied to the host and written at once");
     }
 
     std::string pluginGetName() const
@@ -141,6 +153,7 @@ public:
 
         this->cellDescription = cellDescription;
         mThreadParams.cellDescription = this->cellDescription;
+        mCheckpointParams.cellDescription = this->cellDescription;
     }
 
     void notify(uint32_t currentStep)
@@ -159,11 +172,29 @@ public:
 #endif
     }
 
+    bool isCheckpointPending()
+    {
+        return checkpointWriterActive && !checkpointWriterDone;
+    }
+
+    bool waitForCheckpoint()
+    {
+        if (!checkpointWriterActive)
+            return true;
+
+        pthread_join(checkpointWriter, NULL);
+        checkpointWriterActive = false;
+
+        return !checkpointWriterFailed;
+    }
+
     void restart(uint32_t restartStep, const std::string restartDirectory)
     {
 #if(ENABLE_ADIOS == 1)
         log<picLog::INPUT_OUTPUT > ("HDF5: Restart skipped since ADIOS is enabled.");
 #else
+        waitForCheckpoint();
+
         const uint32_t maxOpenFilesPerNode = 4;
         GridController<simDim> &gc = Environment<simDim>::get().GridController();
         mThreadParams.dataCollector = new ParallelDomainCollector(
@@ -206,8 +237,10 @@ public:
         log<picLog::INPUT_OUTPUT > ("HDF5 setting slide count for moving window to %1%") % slides;
         MovingWindow::getInstance().setSlideCounter(slides, restartStep);
 
-        /* re-distribute the local offsets in y-direction */
-        if( MovingWindow::getInstance().isSlidingWindowActive() )
+        /* re-distribute the local offsets in move direction
+         * (incremental slides do not rotate the gpus) */
+        if( MovingWindow::getInstance().isSlidingWindowActive() &&
+            !MovingWindow::getInstance().isIncrementalSlides() )
             gc.setStateAfterSlides(slides);
 
         /* set window for restart, complete global domain */
@@ -249,26 +282,31 @@ public:
 
 private:
 
-    void closeH5File()
+    static void closeH5File(ThreadParams& params)
     {
-        if (mThreadParams.dataCollector != NULL)
+        if (params.dataCollector != NULL)
         {
             log<picLog::INPUT_OUTPUT > ("HDF5 close DataCollector");
-            mThreadParams.dataCollector->close();
+            params.dataCollector->close();
         }
     }
 
-    void openH5File(const std::string h5Filename)
+    /**
+     * @param params thread params owning the data collector
+     * @param h5Filename file to create
+     * @param comm communicator for the collective file access
+     */
+    void openH5File(ThreadParams& params, const std::string h5Filename, MPI_Comm comm)
     {
         const uint32_t maxOpenFilesPerNode = 4;
-        if (mThreadParams.dataCollector == NULL)
+        if (params.dataCollector == NULL)
         {
             GridController<simDim> &gc = Environment<simDim>::get().GridController();
-            mThreadParams.dataCollector = new ParallelDomainCollector(
-                                                                      gc.getCommunicator().getMPIComm(),
-                                                                      gc.getCommunicator().getMPIInfo(),
-                                                                      splashMpiSize,
-                                                                      maxOpenFilesPerNode);
+            params.dataCollector = new ParallelDomainCollector(
+                                                               comm,
+                                                               gc.getCommunicator().getMPIInfo(),
+                                                               splashMpiSize,
+                                                               maxOpenFilesPerNode);
         }
         // set attributes for datacollector files
         DataCollector::FileCreationAttr attr;
@@ -281,7 +319,7 @@ private:
         try
         {
             log<picLog::INPUT_OUTPUT > ("HDF5 open DataCollector with file: %1%") % h5Filename;
-            mThreadParams.dataCollector->open(h5Filename.c_str(), attr);
+            params.dataCollector->open(h5Filename.c_str(), attr);
         }
         catch (const DCException& e)
         {
@@ -298,10 +336,22 @@ private:
      */
     void notificationReceived(uint32_t currentStep, bool isCheckpoint)
     {
+        /* HDF5 calls must not overlap with the background writer of the
+         * previous checkpoint */
+        waitForCheckpoint();
+
+        /* asynchronous checkpoints use their own data collector, its
+         * collective calls are executed by the background writer */
+        const bool isAsync = isCheckpoint && checkpointAsync;
+        ThreadParams& params = isAsync ? mCheckpointParams : mThreadParams;
+
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        mThreadParams.isCheckpoint = isCheckpoint;
-        mThreadParams.currentStep = currentStep;
-        mThreadParams.cellDescription = this->cellDescription;
+        params.isCheckpoint = isCheckpoint;
+        params.currentStep = currentStep;
+        params.cellDescription = this->cellDescription;
+        params.numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+        params.globalSlideOffset = MovingWindow::getInstance().getSlideOffset(params.numSlides);
+        params.localDomain = localDomain;
 
         __getTransactionEvent().waitForFinished();
 
@@ -315,32 +365,80 @@ private:
 
         /* if file name is relative, prepend with common directory */
         if( boost::filesystem::path(h5Filename).has_root_path() )
-            mThreadParams.h5Filename = h5Filename;
+            params.h5Filename = h5Filename;
         else
-            mThreadParams.h5Filename = h5Filedir + "/" + h5Filename;
+            params.h5Filename = h5Filedir + "/" + h5Filename;
 
         /* window selection */
         if( isCheckpoint )
-            mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(currentStep);
+            params.window = MovingWindow::getInstance().getDomainAsWindow(currentStep);
         else
-            mThreadParams.window = MovingWindow::getInstance().getWindow(currentStep);
+            params.window = MovingWindow::getInstance().getWindow(currentStep);
 
         for (uint32_t i = 0; i < simDim; ++i)
         {
-            mThreadParams.localWindowToDomainOffset[i] = 0;
-            if (mThreadParams.window.globalDimensions.offset[i] > localDomain.offset[i])
+            params.localWindowToDomainOffset[i] = 0;
+            if (params.window.globalDimensions.offset[i] > localDomain.offset[i])
             {
-                mThreadParams.localWindowToDomainOffset[i] =
-                    mThreadParams.window.globalDimensions.offset[i] -
+                params.localWindowToDomainOffset[i] =
+                    params.window.globalDimensions.offset[i] -
                     localDomain.offset[i];
             }
         }
 
-        openH5File(mThreadParams.h5Filename);
+        if (!isAsync)
+        {
+            openH5File(params, params.h5Filename,
+                       Environment<simDim>::get().GridController().getCommunicator().getMPIComm());
+
+            writeHDF5((void*) &params);
+
+            closeH5File(params);
+            return;
+        }
+
+        openH5File(params, params.h5Filename, checkpointComm);
 
-        writeHDF5((void*) &mThreadParams);
+        /* stage all data on the host, the writes are only queued */
+        params.deferredWrites = &deferredWrites;
+        writeHDF5((void*) &params);
+        params.deferredWrites = NULL;
 
-        closeH5File();
+        checkpointWriterDone = false;
+        checkpointWriterFailed = false;
+        if (pthread_create(&checkpointWriter, NULL, writeDeferred, (void*) this) != 0)
+            throw std::runtime_error("HDF5 failed to start the checkpoint writer thread");
+        checkpointWriterActive = true;
+    }
+
+    /**
+     * Executes all deferred writes of a checkpoint and closes the file.
+     *
+     * Runs as background thread, concurrently to the simulation.
+     */
+    static void *writeDeferred(void *p_args)
+    {
+        HDF5Writer *writer = (HDF5Writer*) (p_args);
+
+        try
+        {
+            while (!writer->deferredWrites.empty())
+            {
+                writer->deferredWrites.front()();
+                /* release the staged data as soon as it is written */
+                writer->deferredWrites.pop_front();
+            }
+            closeH5File(writer->mCheckpointParams);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            writer->deferredWrites.clear();
+            writer->checkpointWriterFailed = true;
+        }
+
+        writer->checkpointWriterDone = true;
+        return NULL;
     }
 
     void pluginLoad()
@@ -378,25 +476,52 @@ private:
             restartFilename = checkpointFilename;
         }
 
+        mThreadParams.particleBatchSize = particleBatchSize;
+        mCheckpointParams.particleBatchSize = particleBatchSize;
+
+        checkpointAsync = Environment<>::get().SimulationDescription().isCheckpointAsync();
+        if (checkpointAsync)
+        {
+            /* the background writer calls MPI concurrently to the simulation */
+            int threadLevel;
+            MPI_CHECK(MPI_Query_thread(&threadLevel));
+            if (threadLevel < MPI_THREAD_MULTIPLE)
+            {
+                log<picLog::INPUT_OUTPUT > ("HDF5: MPI_THREAD_MULTIPLE is not supported, checkpoints are written synchronously.");
+                checkpointAsync = false;
+            }
+            else
+                MPI_CHECK(MPI_Comm_dup(gc.getCommunicator().getMPIComm(), &checkpointComm));
+        }
+
         loaded = true;
     }
 
     void pluginUnload()
     {
+        waitForCheckpoint();
+
         if (mThreadParams.dataCollector)
             mThreadParams.dataCollector->finalize();
 
         __delete(mThreadParams.dataCollector);
+
+        if (mCheckpointParams.dataCollector)
+            mCheckpointParams.dataCollector->finalize();
+
+        __delete(mCheckpointParams.dataCollector);
+
+        if (checkpointComm != MPI_COMM_NULL)
+            MPI_CHECK(MPI_Comm_free(&checkpointComm));
     }
 
     static void *writeHDF5(void *p_args)
     {
         ThreadParams *threadParams = (ThreadParams*) (p_args);
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
 
-        /* y direction can be negative for first gpu*/
-        DataSpace<simDim> particleOffset(localDomain.offset);
-        particleOffset.y() -= threadParams->window.globalDimensions.offset.y();
+        /* move direction can be negative for first gpu*/
+        DataSpace<simDim> particleOffset(threadParams->localDomain.offset);
+        particleOffset -= threadParams->window.globalDimensions.offset;
 
         /* write all fields */
         log<picLog::INPUT_OUTPUT > ("HDF5: (begin) writing fields.");
@@ -430,21 +555,28 @@ private:
         PMACC_AUTO(idProviderState, IdProvider<simDim>::getState());
         log<picLog::INPUT_OUTPUT>("HDF5: Writing IdProvider state (StartId: %1%, NextId: %2%, maxNumProc: %3%)")
                 % idProviderState.startId % idProviderState.nextId % idProviderState.maxNumProc;
-        WriteNDScalars<uint64_t, uint64_t>()(*threadParams,
-                "picongpu/idProvider/startId", idProviderState.startId,
-                "maxNumProc", idProviderState.maxNumProc);
-        WriteNDScalars<uint64_t>()(*threadParams,
-                "picongpu/idProvider/nextId", idProviderState.nextId);
 
-        // write global meta attributes
-        WriteMeta writeMetaAttributes;
-        writeMetaAttributes(threadParams);
+        ThreadParams params(*threadParams);
+        threadParams->submit([=]() mutable {
+            WriteNDScalars<uint64_t, uint64_t>()(params,
+                    "picongpu/idProvider/startId", idProviderState.startId,
+                    "maxNumProc", idProviderState.maxNumProc);
+            WriteNDScalars<uint64_t>()(params,
+                    "picongpu/idProvider/nextId", idProviderState.nextId);
+
+            // write global meta attributes
+            WriteMeta writeMetaAttributes;
+            writeMetaAttributes(&params);
+        });
 
         return NULL;
     }
 
     ThreadParams mThreadParams;
 
+    /** thread params of the checkpoint written in the background */
+    ThreadParams mCheckpointParams;
+
     MappingDesc *cellDescription;
 
     uint32_t notifyPeriod;
@@ -456,12 +588,25 @@ private:
     std::string checkpointDirectory;
 
     uint32_t restartChunkSize;
+    uint32_t particleBatchSize;
 
     DataSpace<simDim> mpi_pos;
     DataSpace<simDim> mpi_size;
 
     Dimensions splashMpiPos;
     Dimensions splashMpiSize;
+
+    /** write checkpoints in the background */
+    bool checkpointAsync;
+    /** communicator of the checkpoint data collector */
+    MPI_Comm checkpointComm;
+    /** writes queued while staging a checkpoint */
+    std::list<ThreadParams::WriteOperation> deferredWrites;
+
+    pthread_t checkpointWriter;
+    bool checkpointWriterActive;
+    std::atomic<bool> checkpointWriterDone;
+    std::atomic<bool> checkpointWriterFailed;
 };
 
 } //namespace hdf5
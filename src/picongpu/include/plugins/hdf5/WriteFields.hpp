@@ -169,19 +169,14 @@ private:
 
         /*## update field ##*/
 
-        /*load FieldTmp without copy data to host*/
-        FieldTmp* fieldTmp = &(dc.getData<FieldTmp > (FieldTmp::getName(), true));
+        /*load derived field cache without copy data to host*/
+        FieldTmpCache& fieldTmpCache = dc.getData<FieldTmpCache > (FieldTmpCache::getName(), true);
         /*load particle without copy particle data to host*/
         Species* speciesTmp = &(dc.getData<Species >(Species::FrameType::getName(), true));
 
-        fieldTmp->getGridBuffer().getDeviceBuffer().setValue(ValueType::create(0.0));
-        /*run algorithm*/
-        fieldTmp->computeValue < CORE + BORDER, Solver > (*speciesTmp, params->currentStep);
-
-        EventTask fieldTmpEvent = fieldTmp->asyncCommunication(__getTransactionEvent());
-        __setTransactionEvent(fieldTmpEvent);
-        /* copy data to host that we can write same to disk*/
-        fieldTmp->getGridBuffer().deviceToHost();
+        /*run algorithm (or reuse the result of this step) and copy data to host
+         *that we can write same to disk*/
+        FieldTmp* fieldTmp = &(fieldTmpCache.getDerivedField<Solver>(*speciesTmp, params->currentStep, true));
         dc.releaseData(Species::FrameType::getName());
         /*## finish update field ##*/
 
@@ -210,7 +205,7 @@ private:
                           fieldTmp->getHostDataBox(),
                           ValueType());
 
-        dc.releaseData(FieldTmp::getName());
+        dc.releaseData(FieldTmpCache::getName());
 
     }
 
@@ -229,9 +229,7 @@ using namespace PMacc;
                 "chargeCorrection", chargeCorrection.c_str() );
 
             /* write number of slides */
-            const uint32_t slides = MovingWindow::getInstance().getSlideCounter(
-                threadParams->currentStep
-            );
+            const uint32_t slides = threadParams->numSlides;
 
             dc->writeAttribute( threadParams->currentStep,
                                 ctUInt32, NULL, "sim_slides", &slides );
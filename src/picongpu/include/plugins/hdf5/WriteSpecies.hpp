@@ -44,6 +44,8 @@
 #include "plugins/output/WriteSpeciesCommon.hpp"
 #include "plugins/kernel/CopySpecies.kernel"
 #include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/kernel/SliceMapping.hpp"
+#include "particles/operations/CountParticles.hpp"
 
 #include "plugins/hdf5/writer/ParticleAttribute.hpp"
 #include "compileTime/conversion/RemoveFromSeq.hpp"
@@ -51,6 +53,9 @@
 #include "particles/traits/GetSpeciesFlagName.hpp"
 
 #include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
 
 namespace picongpu
 {
@@ -106,86 +111,67 @@ public:
         /* load particle without copy particle data to host */
         ThisSpecies* speciesTmp = &(dc.getData<ThisSpecies >(ThisSpecies::FrameType::getName(), true));
 
-        /* count number of particles for this species on the device */
-        uint64_t numParticles = 0;
+        /* select the particles within the window, the same filter is used
+         * for counting and copying */
+        typedef bmpl::vector< typename GetPositionFilter<simDim>::type > usedFilters;
+        typedef typename FilterFactory<usedFilters>::FilterType MyParticleFilter;
+        MyParticleFilter filter;
+        filter.setStatus(true);
+        filter.setWindowPosition(params->localWindowToDomainOffset,
+                                 params->window.localDimensions.size);
+
+        /* particles are copied to the host and written in batches of
+         * supercell slices, only two batches are hold in host memory
+         *
+         * deferred writes need all particles at once, therefore the batch
+         * covers the full local domain
+         */
+        typedef SliceMapping<CORE + BORDER, MappingDesc> BatchMapping;
+        const int superCellsPerBatch = params->deferredWrites == NULL ?
+            int(params->particleBatchSize) :
+            params->cellDescription->getGridSuperCells()[simDim - 1];
+        BatchMapping mapper(*(params->cellDescription), superCellsPerBatch);
 
         log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) count particles: %1%") % Hdf5FrameType::getName();
         /* at this point we cast to uint64_t, before we assume that per GPU
          * less then 1e9 (int range) particles will be counted
          */
-        numParticles = uint64_t( PMacc::CountParticles::countOnDevice< CORE + BORDER >(
-            *speciesTmp,
-            *(params->cellDescription),
-            params->localWindowToDomainOffset,
-            params->window.localDimensions.size
-        ));
-
-
+        std::vector<uint64_t> batchSizes;
+        {
+            BatchMapping countMapper(mapper);
+            do
+            {
+                batchSizes.push_back(uint64_t( PMacc::CountParticles::countInMapping(
+                    *speciesTmp,
+                    countMapper,
+                    filter
+                )));
+            }
+            while (countMapper.next());
+        }
+        const uint64_t numParticles = std::accumulate(batchSizes.begin(), batchSizes.end(), uint64_t(0));
+        const uint64_t maxBatchSize = *std::max_element(batchSizes.begin(), batchSizes.end());
         log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) count particles: %1% = %2%") % Hdf5FrameType::getName() % numParticles;
-        Hdf5FrameType hostFrame;
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) malloc mapped memory: %1%") % Hdf5FrameType::getName();
-        /*malloc mapped memory*/
-        ForEach<typename Hdf5FrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
-        mallocMem(forward(hostFrame), numParticles);
-        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) malloc mapped memory: %1%") % Hdf5FrameType::getName();
 
-        if (numParticles != 0)
+        /* double buffering: batch n is written while batch n+1 is copied */
+        const uint32_t numBuffers = batchSizes.size() > 1 ? 2 : 1;
+        Hdf5FrameType hostFrames[2];
+        Hdf5FrameType deviceFrames[2];
+        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) malloc mapped memory: %1%") % Hdf5FrameType::getName();
+        for (uint32_t i = 0; i < numBuffers; ++i)
         {
+            /*malloc mapped memory*/
+            ForEach<typename Hdf5FrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+            mallocMem(forward(hostFrames[i]), maxBatchSize);
 
-            log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) get mapped memory device pointer: %1%") % Hdf5FrameType::getName();
-            /*load device pointer of mapped memory*/
-            Hdf5FrameType deviceFrame;
-            ForEach<typename Hdf5FrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
-            getDevicePtr(forward(deviceFrame), forward(hostFrame));
-            log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) get mapped memory device pointer: %1%") % Hdf5FrameType::getName();
-
-            log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) copy particle to host: %1%") % Hdf5FrameType::getName();
-            typedef bmpl::vector< typename GetPositionFilter<simDim>::type > usedFilters;
-            typedef typename FilterFactory<usedFilters>::FilterType MyParticleFilter;
-            MyParticleFilter filter;
-            /* activate filter pipeline if moving window is activated */
-            filter.setStatus(MovingWindow::getInstance().isSlidingWindowActive());
-            filter.setWindowPosition(params->localWindowToDomainOffset,
-                                     params->window.localDimensions.size);
-
-            dim3 block(PMacc::math::CT::volume<SuperCellSize>::type::value);
-
-            /* int: assume < 2e9 particles per GPU */
-            GridBuffer<int, DIM1> counterBuffer(DataSpace<DIM1>(1));
-            AreaMapping < CORE + BORDER, MappingDesc > mapper(*(params->cellDescription));
-
-            constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
-            if(useElements)
+            if (maxBatchSize != 0)
             {
-                const int cellsInSupercell = PMacc::math::CT::volume<SuperCellSize>::type::value;
-                __cudaKernel_OPTI(copySpecies<cellsInSupercell>)
-                    (mapper.getGridDim(), block)
-                    (counterBuffer.getDeviceBuffer().getPointer(),
-                     deviceFrame, speciesTmp->getDeviceParticlesBox(),
-                     filter,
-                     particleOffset, /*relative to data domain (not to physical domain)*/
-                     mapper
-                     );
+                /*load device pointer of mapped memory*/
+                ForEach<typename Hdf5FrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
+                getDevicePtr(forward(deviceFrames[i]), forward(hostFrames[i]));
             }
-            else
-            {
-                __cudaKernel(copySpecies<>)
-                    (mapper.getGridDim(), block)
-                    (counterBuffer.getDeviceBuffer().getPointer(),
-                     deviceFrame, speciesTmp->getDeviceParticlesBox(),
-                     filter,
-                     particleOffset, /*relative to data domain (not to physical domain)*/
-                     mapper
-                     );
-            }
-
-            counterBuffer.deviceToHost();
-            log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) copy particle to host: %1%") % Hdf5FrameType::getName();
-            __getTransactionEvent().waitForFinished();
-            log<picLog::INPUT_OUTPUT > ("HDF5:  all events are finished: %1%") % Hdf5FrameType::getName();
-
-            assert((uint64_t) counterBuffer.getHostBuffer().getDataBox()[0] == numParticles);
         }
+        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) malloc mapped memory: %1%") % Hdf5FrameType::getName();
 
         /* We rather do an allgather at this point then letting libSplash
          * do an allgather during write to find out the global number of
@@ -193,8 +179,6 @@ public:
          */
         log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) collect particle sizes for %1%") % Hdf5FrameType::getName();
 
-        ColTypeUInt64 ctUInt64;
-        ColTypeDouble ctDouble;
         GridController<simDim>& gc = Environment<simDim>::get().GridController();
 
         const uint64_t numRanks( gc.getGlobalSize() );
@@ -234,209 +218,295 @@ public:
             if( particleCounts.at(2 * r + 1) < myParticlePatch[ 1 ] )
                 numParticlesOffset += particleCounts.at(2 * r);
         }
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (end) collect particle sizes for %1%") % Hdf5FrameType::getName();
 
-        /* dump non-constant particle records to hdf5 file */
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) write particle records for %1%") % Hdf5FrameType::getName();
+        /* batches are written collectively, ranks with less batches write
+         * empty batches */
+        uint64_t numBatches = batchSizes.size();
+        MPI_CHECK(MPI_Allreduce(
+            MPI_IN_PLACE, &numBatches, 1, MPI_UINT64_T, MPI_MAX,
+            gc.getCommunicator().getMPIComm()
+        ));
+        log<picLog::INPUT_OUTPUT > ("HDF5:  (end) collect particle sizes for %1%") % Hdf5FrameType::getName();
 
         const std::string speciesPath( std::string("particles/") + FrameType::getName() );
+        ThreadParams threadParams(*params);
 
-        ForEach<typename Hdf5FrameType::ValueTypeSeq, hdf5::ParticleAttribute<bmpl::_1> > writeToHdf5;
-        writeToHdf5(
-            params,
-            forward(hostFrame),
-            speciesPath,
-            numParticles,
-            numParticlesOffset,
-            numParticlesGlobal
-        );
-
-        /* write constant particle records to hdf5 file */
-        const float_64 charge( frame::getCharge<FrameType>() );
-        std::vector<float_64> chargeUnitDimension( NUnitDimension, 0.0 );
-        chargeUnitDimension.at(SIBaseUnits::time) = 1.0;
-        chargeUnitDimension.at(SIBaseUnits::electricCurrent) = 1.0;
-
-        writeConstantRecord(
-            params,
-            speciesPath + std::string("/charge"),
-            numParticlesGlobal,
-            charge,
-            UNIT_CHARGE,
-            chargeUnitDimension
-        );
-
-        const float_64 mass( frame::getMass<FrameType>() );
-        std::vector<float_64> massUnitDimension( NUnitDimension, 0.0 );
-        massUnitDimension.at(SIBaseUnits::mass) = 1.0;
-
-        writeConstantRecord(
-            params,
-            speciesPath + std::string("/mass"),
-            numParticlesGlobal,
-            mass,
-            UNIT_MASS,
-            massUnitDimension
-        );
-
-        /* openPMD ED-PIC: write additional attributes */
-        const float_64 particleShape( GetShape<T_Species>::type::support - 1 );
-        params->dataCollector->writeAttribute( params->currentStep,
-                            ctDouble,
-                            speciesPath.c_str(),
-                            "particleShape",
-                            &particleShape );
-
-        traits::GetSpeciesFlagName<T_Species, current<> > currentDepositionName;
-        const std::string currentDeposition( currentDepositionName() );
-        ColTypeString ctCurrentDeposition( currentDeposition.length() );
-        params->dataCollector->writeAttribute( params->currentStep,
-                            ctCurrentDeposition,
-                            speciesPath.c_str(),
-                            "currentDeposition",
-                            currentDeposition.c_str() );
-
-        traits::GetSpeciesFlagName<T_Species, particlePusher<> > particlePushName;
-        const std::string particlePush( particlePushName() );
-        ColTypeString ctParticlePush( particlePush.length() );
-        params->dataCollector->writeAttribute( params->currentStep,
-                            ctParticlePush,
-                            speciesPath.c_str(),
-                            "particlePush",
-                            particlePush.c_str() );
-
-        traits::GetSpeciesFlagName<T_Species, interpolation<> > particleInterpolationName;
-        const std::string particleInterpolation( particleInterpolationName() );
-        ColTypeString ctParticleInterpolation( particleInterpolation.length() );
-        params->dataCollector->writeAttribute( params->currentStep,
-                            ctParticleInterpolation,
-                            speciesPath.c_str(),
-                            "particleInterpolation",
-                            particleInterpolation.c_str() );
-
-        const std::string particleSmoothing("none");
-        ColTypeString ctParticleSmoothing(particleSmoothing.length());
-        params->dataCollector->writeAttribute( params->currentStep,
-                            ctParticleSmoothing,
-                            speciesPath.c_str(),
-                            "particleSmoothing",
-                            particleSmoothing.c_str() );
-
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (end) write particle records for %1%") % Hdf5FrameType::getName();
-
-        /* write species particle patch meta information */
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) writing particlePatches for %1%") % Hdf5FrameType::getName();
-
-        std::string particlePatchesPath( speciesPath + std::string("/particlePatches") );
-
-        /* offset and size of our particle patches
-         *   - numPatches: we write as many patches as MPI ranks
-         *   - myPatchOffset: we write in the order of the MPI ranks
-         *   - myPatchEntries: every MPI rank writes exactly one patch
-         */
-        const Dimensions numPatches( numRanks, 1, 1 );
-        const Dimensions myPatchOffset( myRank, 0, 0 );
-        const Dimensions myPatchEntries( 1, 1, 1 );
+        /* create datasets of non-constant particle records */
+        params->submit([=]() mutable {
+            ForEach<typename Hdf5FrameType::ValueTypeSeq, hdf5::ReserveParticleAttribute<bmpl::_1> > reserveInHdf5;
+            reserveInHdf5(&threadParams, speciesPath, numParticlesGlobal);
+        });
 
-        /* numParticles: number of particles in this patch */
-        params->dataCollector->write(
-            params->currentStep,
-            numPatches,
-            myPatchOffset,
-            ctUInt64, 1,
-            myPatchEntries,
-            (particlePatchesPath + std::string("/numParticles")).c_str(),
-            &numParticles);
+        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) copy and write particle records for %1%") % Hdf5FrameType::getName();
+        dim3 block(PMacc::math::CT::volume<SuperCellSize>::type::value);
 
-        /* numParticlesOffset: number of particles before this patch */
-        params->dataCollector->write(
-            params->currentStep,
-            numPatches,
-            myPatchOffset,
-            ctUInt64, 1,
-            myPatchEntries,
-            (particlePatchesPath + std::string("/numParticlesOffset")).c_str(),
-            &numParticlesOffset);
+        /* int: assume < 2e9 particles per GPU */
+        GridBuffer<int, DIM1> counterBuffer(DataSpace<DIM1>(1));
+        uint64_t batchOffset = numParticlesOffset;
 
-        /* offset: absolute position where this particle patch begins including
-         *         global domain offsets (slides), etc.
-         * extent: size of this particle patch, upper bound is excluded
-         */
-        const std::string name_lookup[] = {"x", "y", "z"};
-        for (uint32_t d = 0; d < simDim; ++d)
+        for (uint64_t b = 0; b <= numBatches; ++b)
         {
-            const uint64_t patchOffset =
-                params->window.globalDimensions.offset[d] +
-                params->window.localDimensions.offset[d] +
-                params->localWindowToDomainOffset[d];
-            const uint64_t patchExtent =
-                params->window.localDimensions.size[d];
+            /* start copying batch b to the host */
+            const bool copyBatch = b < batchSizes.size() && batchSizes[b] != 0;
+            if (copyBatch)
+            {
+                counterBuffer.getDeviceBuffer().setValue(0);
+
+                constexpr bool useElements = cupla::traits::IsThreadSeqAcc< cupla::AccThreadSeq >::value;
+                if(useElements)
+                {
+                    const int cellsInSupercell = PMacc::math::CT::volume<SuperCellSize>::type::value;
+                    __cudaKernel_OPTI(copySpecies<cellsInSupercell>)
+                        (mapper.getGridDim(), block)
+                        (counterBuffer.getDeviceBuffer().getPointer(),
+                         deviceFrames[b % 2], speciesTmp->getDeviceParticlesBox(),
+                         filter,
+                         particleOffset, /*relative to data domain (not to physical domain)*/
+                         mapper
+                         );
+                }
+                else
+                {
+                    __cudaKernel(copySpecies<>)
+                        (mapper.getGridDim(), block)
+                        (counterBuffer.getDeviceBuffer().getPointer(),
+                         deviceFrames[b % 2], speciesTmp->getDeviceParticlesBox(),
+                         filter,
+                         particleOffset, /*relative to data domain (not to physical domain)*/
+                         mapper
+                         );
+                }
+                counterBuffer.deviceToHost();
+            }
 
+            /* write batch b-1 while batch b is copied */
+            if (b != 0)
+            {
+                const uint64_t elements = b - 1 < batchSizes.size() ? batchSizes[b - 1] : 0;
+                const uint64_t elementsOffset = batchOffset;
+                Hdf5FrameType hostFrame = hostFrames[(b - 1) % 2];
+                params->submit([=]() mutable {
+                    ForEach<typename Hdf5FrameType::ValueTypeSeq, hdf5::ParticleAttribute<bmpl::_1> > writeToHdf5;
+                    writeToHdf5(
+                        &threadParams,
+                        forward(hostFrame),
+                        speciesPath,
+                        elements,
+                        elementsOffset
+                    );
+                });
+                batchOffset += elements;
+            }
+
+            if (copyBatch)
+            {
+                __getTransactionEvent().waitForFinished();
+                assert((uint64_t) counterBuffer.getHostBuffer().getDataBox()[0] == batchSizes[b]);
+            }
+            if (b < batchSizes.size())
+                mapper.next();
+        }
+        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) copy and write particle records for %1%") % Hdf5FrameType::getName();
+
+        /* all particles are staged or written, the simulation may continue
+         * while the remaining records are written and the frames are freed */
+        params->submit([=]() mutable {
+            ThreadParams *params = &threadParams;
+            ColTypeUInt64 ctUInt64;
+            ColTypeDouble ctDouble;
+
+            /* write constant particle records to hdf5 file */
+            log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) write constant particle records for %1%") % Hdf5FrameType::getName();
+
+            const float_64 charge( frame::getCharge<FrameType>() );
+            std::vector<float_64> chargeUnitDimension( NUnitDimension, 0.0 );
+            chargeUnitDimension.at(SIBaseUnits::time) = 1.0;
+            chargeUnitDimension.at(SIBaseUnits::electricCurrent) = 1.0;
+
+            writeConstantRecord(
+                params,
+                speciesPath + std::string("/charge"),
+                numParticlesGlobal,
+                charge,
+                UNIT_CHARGE,
+                chargeUnitDimension
+            );
+
+            const float_64 mass( frame::getMass<FrameType>() );
+            std::vector<float_64> massUnitDimension( NUnitDimension, 0.0 );
+            massUnitDimension.at(SIBaseUnits::mass) = 1.0;
+
+            writeConstantRecord(
+                params,
+                speciesPath + std::string("/mass"),
+                numParticlesGlobal,
+                mass,
+                UNIT_MASS,
+                massUnitDimension
+            );
+
+            /* openPMD ED-PIC: write additional attributes */
+            const float_64 particleShape( GetShape<T_Species>::type::support - 1 );
+            params->dataCollector->writeAttribute( params->currentStep,
+                                ctDouble,
+                                speciesPath.c_str(),
+                                "particleShape",
+                                &particleShape );
+
+            traits::GetSpeciesFlagName<T_Species, current<> > currentDepositionName;
+            const std::string currentDeposition( currentDepositionName() );
+            ColTypeString ctCurrentDeposition( currentDeposition.length() );
+            params->dataCollector->writeAttribute( params->currentStep,
+                                ctCurrentDeposition,
+                                speciesPath.c_str(),
+                                "currentDeposition",
+                                currentDeposition.c_str() );
+
+            traits::GetSpeciesFlagName<T_Species, particlePusher<> > particlePushName;
+            const std::string particlePush( particlePushName() );
+            ColTypeString ctParticlePush( particlePush.length() );
+            params->dataCollector->writeAttribute( params->currentStep,
+                                ctParticlePush,
+                                speciesPath.c_str(),
+                                "particlePush",
+                                particlePush.c_str() );
+
+            traits::GetSpeciesFlagName<T_Species, interpolation<> > particleInterpolationName;
+            const std::string particleInterpolation( particleInterpolationName() );
+            ColTypeString ctParticleInterpolation( particleInterpolation.length() );
+            params->dataCollector->writeAttribute( params->currentStep,
+                                ctParticleInterpolation,
+                                speciesPath.c_str(),
+                                "particleInterpolation",
+                                particleInterpolation.c_str() );
+
+            const std::string particleSmoothing("none");
+            ColTypeString ctParticleSmoothing(particleSmoothing.length());
+            params->dataCollector->writeAttribute( params->currentStep,
+                                ctParticleSmoothing,
+                                speciesPath.c_str(),
+                                "particleSmoothing",
+                                particleSmoothing.c_str() );
+
+            log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) write constant particle records for %1%") % Hdf5FrameType::getName();
+
+            /* write species particle patch meta information */
+            log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) writing particlePatches for %1%") % Hdf5FrameType::getName();
+
+            std::string particlePatchesPath( speciesPath + std::string("/particlePatches") );
+
+            /* offset and size of our particle patches
+             *   - numPatches: we write as many patches as MPI ranks
+             *   - myPatchOffset: we write in the order of the MPI ranks
+             *   - myPatchEntries: every MPI rank writes exactly one patch
+             */
+            const Dimensions numPatches( numRanks, 1, 1 );
+            const Dimensions myPatchOffset( myRank, 0, 0 );
+            const Dimensions myPatchEntries( 1, 1, 1 );
+
+            /* numParticles: number of particles in this patch */
             params->dataCollector->write(
                 params->currentStep,
                 numPatches,
                 myPatchOffset,
                 ctUInt64, 1,
                 myPatchEntries,
-                (particlePatchesPath + std::string("/offset/") +
-                 name_lookup[d]).c_str(),
-                &patchOffset);
+                (particlePatchesPath + std::string("/numParticles")).c_str(),
+                &numParticles);
+
+            /* numParticlesOffset: number of particles before this patch */
             params->dataCollector->write(
                 params->currentStep,
                 numPatches,
                 myPatchOffset,
                 ctUInt64, 1,
                 myPatchEntries,
-                (particlePatchesPath + std::string("/extent/") +
-                 name_lookup[d]).c_str(),
-                &patchExtent);
+                (particlePatchesPath + std::string("/numParticlesOffset")).c_str(),
+                &numParticlesOffset);
 
-            /* offsets and extent of the patch are positions (lengths)
-             * and need to be scaled like the cell idx of a particle
+            /* offset: absolute position where this particle patch begins including
+             *         global domain offsets (slides), etc.
+             * extent: size of this particle patch, upper bound is excluded
              */
-            OpenPMDUnit<globalCellIdx<globalCellIdx_pic> > openPMDUnitCellIdx;
-            std::vector<float_64> unitCellIdx = openPMDUnitCellIdx();
+            const std::string name_lookup[] = {"x", "y", "z"};
+            for (uint32_t d = 0; d < simDim; ++d)
+            {
+                const uint64_t patchOffset =
+                    params->window.globalDimensions.offset[d] +
+                    params->window.localDimensions.offset[d] +
+                    params->localWindowToDomainOffset[d];
+                const uint64_t patchExtent =
+                    params->window.localDimensions.size[d];
+
+                params->dataCollector->write(
+                    params->currentStep,
+                    numPatches,
+                    myPatchOffset,
+                    ctUInt64, 1,
+                    myPatchEntries,
+                    (particlePatchesPath + std::string("/offset/") +
+                     name_lookup[d]).c_str(),
+                    &patchOffset);
+                params->dataCollector->write(
+                    params->currentStep,
+                    numPatches,
+                    myPatchOffset,
+                    ctUInt64, 1,
+                    myPatchEntries,
+                    (particlePatchesPath + std::string("/extent/") +
+                     name_lookup[d]).c_str(),
+                    &patchExtent);
+
+                /* offsets and extent of the patch are positions (lengths)
+                 * and need to be scaled like the cell idx of a particle
+                 */
+                OpenPMDUnit<globalCellIdx<globalCellIdx_pic> > openPMDUnitCellIdx;
+                std::vector<float_64> unitCellIdx = openPMDUnitCellIdx();
+
+                params->dataCollector->writeAttribute(
+                    params->currentStep,
+                    ctDouble,
+                    (particlePatchesPath + std::string("/offset/") +
+                     name_lookup[d]).c_str(),
+                    "unitSI",
+                    &(unitCellIdx.at(d)));
+                params->dataCollector->writeAttribute(
+                    params->currentStep,
+                    ctDouble,
+                    (particlePatchesPath + std::string("/extent/") +
+                     name_lookup[d]).c_str(),
+                    "unitSI",
+                    &(unitCellIdx.at(d)));
+            }
+
+            OpenPMDUnitDimension<globalCellIdx<globalCellIdx_pic> > openPMDUnitDimension;
+            std::vector<float_64> unitDimensionCellIdx = openPMDUnitDimension();
 
             params->dataCollector->writeAttribute(
                 params->currentStep,
                 ctDouble,
-                (particlePatchesPath + std::string("/offset/") +
-                 name_lookup[d]).c_str(),
-                "unitSI",
-                &(unitCellIdx.at(d)));
+                (particlePatchesPath + std::string("/offset")).c_str(),
+                "unitDimension",
+                1u, Dimensions(7,0,0),
+                &(*unitDimensionCellIdx.begin()));
             params->dataCollector->writeAttribute(
                 params->currentStep,
                 ctDouble,
-                (particlePatchesPath + std::string("/extent/") +
-                 name_lookup[d]).c_str(),
-                "unitSI",
-                &(unitCellIdx.at(d)));
-        }
-
-        OpenPMDUnitDimension<globalCellIdx<globalCellIdx_pic> > openPMDUnitDimension;
-        std::vector<float_64> unitDimensionCellIdx = openPMDUnitDimension();
-
-        params->dataCollector->writeAttribute(
-            params->currentStep,
-            ctDouble,
-            (particlePatchesPath + std::string("/offset")).c_str(),
-            "unitDimension",
-            1u, Dimensions(7,0,0),
-            &(*unitDimensionCellIdx.begin()));
-        params->dataCollector->writeAttribute(
-            params->currentStep,
-            ctDouble,
-            (particlePatchesPath + std::string("/extent")).c_str(),
-            "unitDimension",
-            1u, Dimensions(7,0,0),
-            &(*unitDimensionCellIdx.begin()));
+                (particlePatchesPath + std::string("/extent")).c_str(),
+                "unitDimension",
+                1u, Dimensions(7,0,0),
+                &(*unitDimensionCellIdx.begin()));
 
 
-        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) writing particlePatches for %1%") % Hdf5FrameType::getName();
+            log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) writing particlePatches for %1%") % Hdf5FrameType::getName();
 
-        /*free host memory*/
-        ForEach<typename Hdf5FrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
-        freeMem(forward(hostFrame));
+            /*free host memory*/
+            for (uint32_t i = 0; i < numBuffers; ++i)
+            {
+                ForEach<typename Hdf5FrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
+                freeMem(forward(hostFrames[i]));
+            }
+        });
         log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) writing species: %1%") % Hdf5FrameType::getName();
     }
 
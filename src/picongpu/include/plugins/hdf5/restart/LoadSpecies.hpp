@@ -105,15 +105,10 @@ public:
         const std::string speciesSubGroup(
             std::string("particles/") + FrameType::getName() + std::string("/")
         );
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
 
         // load particle without copying particle data to host
         ThisSpecies* speciesTmp = &(dc.getData<ThisSpecies >(ThisSpecies::FrameType::getName(), true));
 
-        // count total number of particles on the device
-        uint64_cu totalNumParticles = 0;
-        uint64_t particleOffset = 0;
-
         // load particle patches offsets to find own patch
         const std::string particlePatchesPath(
             speciesSubGroup + std::string("particlePatches/")
@@ -134,10 +129,9 @@ public:
 
         /** search my entry (using my cell offset and my local grid size)
          *
-         * \note if you want to restart with a changed GPU configuration, either
-         * post-process the particle-patches in the file or implement to find
-         * all contributing patches and then filter the particles inside those
-         * by position
+         * If the checkpoint was written with a different distribution of the
+         * cells (e.g. a balanced `--gridDist`), all patches overlapping my
+         * domain are loaded and only particles inside of my domain are kept.
          *
          * \see plugins/hdf5/WriteSpecies.hpp `WriteSpecies::operator()`
          *      as its counterpart
@@ -149,26 +143,78 @@ public:
         const DataSpace<simDim> patchExtent =
             params->window.localDimensions.size;
 
-        for( size_t i = 0; i < gc.getGlobalSize(); ++i )
+        /* number of particles and offset of all patches to load */
+        std::vector<std::pair<uint64_t, uint64_t> > patches;
+        bool exactlyMyPatch = false;
+
+        for( size_t i = 0; i < gc.getGlobalSize() && !exactlyMyPatch; ++i )
         {
-            bool exactlyMyPatch = true;
+            exactlyMyPatch = true;
+            bool overlapsMyPatch = true;
 
             for( uint32_t d = 0; d < simDim; ++d )
             {
-                if( particlePatches.getOffsetComp( d )[ i ] != (uint64_t)patchOffset[ d ] )
-                    exactlyMyPatch = false;
-                if( particlePatches.getExtentComp( d )[ i ] != (uint64_t)patchExtent[ d ] )
+                const uint64_t offset = particlePatches.getOffsetComp( d )[ i ];
+                const uint64_t extent = particlePatches.getExtentComp( d )[ i ];
+                if( offset != (uint64_t)patchOffset[ d ] || extent != (uint64_t)patchExtent[ d ] )
                     exactlyMyPatch = false;
+                if( offset >= (uint64_t)( patchOffset[ d ] + patchExtent[ d ] ) ||
+                    offset + extent <= (uint64_t)patchOffset[ d ] )
+                    overlapsMyPatch = false;
             }
 
+            const std::pair<uint64_t, uint64_t> patch(
+                particlePatches.numParticles[ i ],
+                particlePatches.numParticlesOffset[ i ]
+            );
             if( exactlyMyPatch )
             {
-                totalNumParticles = particlePatches.numParticles[ i ];
-                particleOffset = particlePatches.numParticlesOffset[ i ];
-                break;
+                patches.clear();
+                patches.push_back( patch );
             }
+            else if( overlapsMyPatch && patch.first != 0 )
+                patches.push_back( patch );
         }
 
+        if( !exactlyMyPatch )
+            log<picLog::INPUT_OUTPUT > ("HDF5: distribution of cells changed, load %1% overlapping particle patches") %
+                patches.size();
+
+        /* particles loaded into my domain */
+        uint64_cu loadedParticles = 0;
+        for( size_t p = 0; p < patches.size(); ++p )
+            loadedParticles += loadPatch( params, speciesTmp, speciesSubGroup, patches[p].first,
+                                          patches[p].second, restartChunkSize );
+
+        if( exactlyMyPatch && !patches.empty() && loadedParticles != patches[0].first )
+        {
+            log<picLog::INPUT_OUTPUT >("HDF5:  error load species | counter is %1% but should %2%") %
+                loadedParticles % patches[0].first;
+        }
+        assert( !exactlyMyPatch || patches.empty() || loadedParticles == patches[0].first );
+
+        log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) load species: %1%") % Hdf5FrameType::getName();
+    }
+
+private:
+
+    /** Load the particles of one patch
+     *
+     * @param params thread params with domainwriter, ...
+     * @param speciesTmp species to load to
+     * @param speciesSubGroup path of the species in the file
+     * @param totalNumParticles number of particles in the patch
+     * @param particleOffset offset of the patch in the particle attributes
+     * @param restartChunkSize number of particles processed in one kernel call
+     * @return number of particles inside of the local domain
+     */
+    HINLINE uint64_cu loadPatch(ThreadParams* params, ThisSpecies* speciesTmp,
+                                const std::string& speciesSubGroup,
+                                const uint64_t totalNumParticles, const uint64_t particleOffset,
+                                const uint32_t restartChunkSize)
+    {
+        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
+
         log<picLog::INPUT_OUTPUT > ("Loading %1% particles from offset %2%") %
             (long long unsigned) totalNumParticles % (long long unsigned) particleOffset;
 
@@ -187,6 +233,7 @@ public:
         ForEach<typename Hdf5FrameType::ValueTypeSeq, LoadParticleAttributesFromHDF5<bmpl::_1> > loadAttributes;
         loadAttributes(forward(params), forward(hostFrame), speciesSubGroup, particleOffset, totalNumParticles);
 
+        uint64_cu loadedParticles = 0;
         if (totalNumParticles != 0)
         {
             dim3 block(PMacc::math::CT::volume<SuperCellSize>::type::value);
@@ -230,18 +277,13 @@ public:
             __getTransactionEvent().waitForFinished();
 
             log<picLog::INPUT_OUTPUT > ("HDF5: used frames to load particles: %1%") % counterBuffer.getHostBuffer().getDataBox()[2];
-
-            if ((uint64_cu) counterBuffer.getHostBuffer().getDataBox()[1] != totalNumParticles)
-            {
-                log<picLog::INPUT_OUTPUT >("HDF5:  error load species | counter is %1% but should %2%") % counterBuffer.getHostBuffer().getDataBox()[1] % totalNumParticles;
-            }
-            assert((uint64_cu) counterBuffer.getHostBuffer().getDataBox()[1] == totalNumParticles);
+            loadedParticles = counterBuffer.getHostBuffer().getDataBox()[1];
 
             /*free host memory*/
             ForEach<typename Hdf5FrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
             freeMem(forward(hostFrame));
-            log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) load species: %1%") % Hdf5FrameType::getName();
         }
+        return loadedParticles;
     }
 };
 
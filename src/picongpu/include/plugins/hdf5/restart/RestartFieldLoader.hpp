@@ -63,15 +63,16 @@ public:
          * and origin at current time step
          * ATTENTION: splash offset are globalSlideOffset + picongpu offsets
          */
-        DataSpace<simDim> globalSlideOffset;
-        globalSlideOffset.y() = numSlides * localDomain.size.y();
+        const DataSpace<simDim> globalSlideOffset(MovingWindow::getInstance().getSlideOffset(numSlides));
 
         Dimensions domain_offset(0, 0, 0);
         for (uint32_t d = 0; d < simDim; ++d)
             domain_offset[d] = localDomain.offset[d] + globalSlideOffset[d];
 
-        if (Environment<simDim>::get().GridController().getPosition().y() == 0)
-            domain_offset[1] += params->window.globalDimensions.offset.y();
+        /* the window offset is only non-zero in move direction */
+        const uint32_t moveDirection = MovingWindow::getInstance().getMoveDirection();
+        if (Environment<simDim>::get().GridController().getPosition()[moveDirection] == 0)
+            domain_offset[moveDirection] += params->window.globalDimensions.offset[moveDirection];
 
         Dimensions local_domain_size;
         for (uint32_t d = 0; d < simDim; ++d)
@@ -164,6 +165,9 @@ public:
                 (uint32_t)FieldType::numComponents,
                 FieldType::getName(),
                 tp);
+        /* loadField already uploaded the grid buffer, fields which are not
+         * stored in its layout copy it on the device */
+        field->applyGridBuffer();
 
         dc.releaseData(FieldType::getName());
 #endif
@@ -28,6 +28,8 @@
 #include "traits/GetNComponents.hpp"
 
 #include <string>
+#include <vector>
+#include <memory>
 
 namespace picongpu
 {
@@ -64,10 +66,6 @@ struct Field
 
         const uint32_t nComponents = GetNComponents<ValueType>::value;
 
-        SplashType splashType;
-        ColTypeDouble ctDouble;
-        SplashFloatXType splashFloatXType;
-
         log<picLog::INPUT_OUTPUT > ("HDF5 write field: %1% %2%") %
             name % nComponents;
 
@@ -96,10 +94,8 @@ struct Field
          * and origin at current time step
          * ATTENTION: splash offset are globalSlideOffset + picongpu offsets
          */
-        DataSpace<simDim> globalSlideOffset;
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(params->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const DataSpace<simDim> globalSlideOffset(params->globalSlideOffset);
+        const PMacc::Selection<simDim>& localDomain = params->localDomain;
 
         Dimensions splashGlobalDomainOffset(0, 0, 0);
         Dimensions splashGlobalOffsetFile(0, 0, 0);
@@ -107,133 +103,146 @@ struct Field
 
         for (uint32_t d = 0; d < simDim; ++d)
         {
-            splashGlobalOffsetFile[d] = localDomain.offset[d];
+            /* the window offset is only non-zero in move direction */
+            splashGlobalOffsetFile[d] = std::max(0, localDomain.offset[d] -
+                                                 params->window.globalDimensions.offset[d]);
             splashGlobalDomainOffset[d] = params->window.globalDimensions.offset[d] + globalSlideOffset[d];
             splashGlobalDomainSize[d] = params->window.globalDimensions.size[d];
         }
 
-        splashGlobalOffsetFile[1] = std::max(0, localDomain.offset[1] -
-                                             params->window.globalDimensions.offset[1]);
-
-        size_t tmpArraySize = field_no_guard.productOfComponents();
-        ComponentType* tmpArray = new ComponentType[tmpArraySize];
+        const size_t tmpArraySize = field_no_guard.productOfComponents();
+        std::shared_ptr<std::vector<ComponentType> > tmpArray(
+            new std::vector<ComponentType>(nComponents * tmpArraySize)
+        );
 
         typedef DataBoxDim1Access<NativeDataBoxType > D1Box;
         D1Box d1Access(dataBox.shift(field_guard), field_no_guard);
 
+        /* copy data of all components to temp array
+         * tmpArray has the size of the data without any offsets
+         */
         for (uint32_t n = 0; n < nComponents; n++)
         {
-            /* copy data to temp array
-             * tmpArray has the size of the data without any offsets
-             */
             for (size_t i = 0; i < tmpArraySize; ++i)
             {
-                tmpArray[i] = d1Access[i][n];
+                (*tmpArray)[n * tmpArraySize + i] = d1Access[i][n];
             }
+        }
+
+        /* the field data is staged, the simulation may continue while the
+         * writes below are executed */
+        ThreadParams threadParams(*params);
+        params->submit([=]() mutable {
+            ThreadParams *params = &threadParams;
+
+            SplashType splashType;
+            ColTypeDouble ctDouble;
+            SplashFloatXType splashFloatXType;
+
+            for (uint32_t n = 0; n < nComponents; n++)
+            {
+                std::stringstream datasetName;
+                datasetName << recordName;
+                if (nComponents > 1)
+                    datasetName << "/" << name_lookup.at(n);
+
+                Dimensions sizeSrcData(1, 1, 1);
+
+                for (uint32_t d = 0; d < simDim; ++d)
+                {
+                    sizeSrcData[d] = field_no_guard[d];
+                }
+
+                params->dataCollector->writeDomain(params->currentStep,             /* id == time step */
+                                                   splashGlobalDomainSize,          /* total size of dataset over all processes */
+                                                   splashGlobalOffsetFile,          /* write offset for this process */
+                                                   splashType,                      /* data type */
+                                                   simDim,                          /* NDims spatial dimensionality of the field */
+                                                   splash::Selection(sizeSrcData),  /* data size of this process */
+                                                   datasetName.str().c_str(),       /* data set name */
+                                                   splash::Domain(
+                                                          splashGlobalDomainOffset, /* offset of the global domain */
+                                                          splashGlobalDomainSize    /* size of the global domain */
+                                                   ),
+                                                   DomainCollector::GridType,
+                                                   &(*tmpArray)[n * tmpArraySize]);
+
+                /* attributes */
+                params->dataCollector->writeAttribute(params->currentStep,
+                                                      splashFloatXType, datasetName.str().c_str(),
+                                                      "position",
+                                                      1u, Dimensions(simDim,0,0),
+                                                      &(*inCellPosition.at(n).begin()));
+
+                params->dataCollector->writeAttribute(params->currentStep,
+                                                      ctDouble, datasetName.str().c_str(),
+                                                      "unitSI", &(unit.at(n)));
+            }
+
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctDouble, recordName.c_str(),
+                                                  "unitDimension",
+                                                  1u, Dimensions(7,0,0),
+                                                  &(*unitDimension.begin()));
+
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  splashFloatXType, recordName.c_str(),
+                                                  "timeOffset", &timeOffset);
 
-            std::stringstream datasetName;
-            datasetName << recordName;
-            if (nComponents > 1)
-                datasetName << "/" << name_lookup.at(n);
+            const std::string geometry("cartesian");
+            ColTypeString ctGeometry(geometry.length());
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctGeometry, recordName.c_str(),
+                                                  "geometry", geometry.c_str());
 
-            Dimensions sizeSrcData(1, 1, 1);
+            const std::string dataOrder("C");
+            ColTypeString ctDataOrder(dataOrder.length());
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctDataOrder, recordName.c_str(),
+                                                  "dataOrder", dataOrder.c_str());
 
-            for (uint32_t d = 0; d < simDim; ++d)
+            char axisLabels[simDim][2];
+            ColTypeString ctAxisLabels(1);
+            for( uint32_t d = 0; d < simDim; ++d )
             {
-                sizeSrcData[d] = field_no_guard[d];
+                axisLabels[simDim-1-d][0] = char('x' + d); // 3D: F[z][y][x], 2D: F[y][x]
+                axisLabels[simDim-1-d][1] = '\0';          // terminator is important!
             }
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctAxisLabels, recordName.c_str(),
+                                                  "axisLabels",
+                                                  1u, Dimensions(simDim,0,0),
+                                                  axisLabels);
 
-            params->dataCollector->writeDomain(params->currentStep,             /* id == time step */
-                                               splashGlobalDomainSize,          /* total size of dataset over all processes */
-                                               splashGlobalOffsetFile,          /* write offset for this process */
-                                               splashType,                      /* data type */
-                                               simDim,                          /* NDims spatial dimensionality of the field */
-                                               splash::Selection(sizeSrcData),  /* data size of this process */
-                                               datasetName.str().c_str(),       /* data set name */
-                                               splash::Domain(
-                                                      splashGlobalDomainOffset, /* offset of the global domain */
-                                                      splashGlobalDomainSize    /* size of the global domain */
-                                               ),
-                                               DomainCollector::GridType,
-                                               tmpArray);
-
-            /* attributes */
+            std::vector<float_X> gridSpacing(simDim, 0.0);
+            for( uint32_t d = 0; d < simDim; ++d )
+                gridSpacing.at(d) = cellSize[d];
             params->dataCollector->writeAttribute(params->currentStep,
-                                                  splashFloatXType, datasetName.str().c_str(),
-                                                  "position",
+                                                  splashFloatXType, recordName.c_str(),
+                                                  "gridSpacing",
                                                   1u, Dimensions(simDim,0,0),
-                                                  &(*inCellPosition.at(n).begin()));
+                                                  &(*gridSpacing.begin()));
 
+            std::vector<float_64> gridGlobalOffset(simDim, 0.0);
+            for( uint32_t d = 0; d < simDim; ++d )
+                gridGlobalOffset.at(d) = float_64(cellSize[d]) *
+                                         float_64(splashGlobalDomainOffset[d]);
             params->dataCollector->writeAttribute(params->currentStep,
-                                                  ctDouble, datasetName.str().c_str(),
-                                                  "unitSI", &(unit.at(n)));
-        }
-        __deleteArray(tmpArray);
-
-
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctDouble, recordName.c_str(),
-                                              "unitDimension",
-                                              1u, Dimensions(7,0,0),
-                                              &(*unitDimension.begin()));
-
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              splashFloatXType, recordName.c_str(),
-                                              "timeOffset", &timeOffset);
-
-        const std::string geometry("cartesian");
-        ColTypeString ctGeometry(geometry.length());
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctGeometry, recordName.c_str(),
-                                              "geometry", geometry.c_str());
-
-        const std::string dataOrder("C");
-        ColTypeString ctDataOrder(dataOrder.length());
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctDataOrder, recordName.c_str(),
-                                              "dataOrder", dataOrder.c_str());
-
-        char axisLabels[simDim][2];
-        ColTypeString ctAxisLabels(1);
-        for( uint32_t d = 0; d < simDim; ++d )
-        {
-            axisLabels[simDim-1-d][0] = char('x' + d); // 3D: F[z][y][x], 2D: F[y][x]
-            axisLabels[simDim-1-d][1] = '\0';          // terminator is important!
-        }
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctAxisLabels, recordName.c_str(),
-                                              "axisLabels",
-                                              1u, Dimensions(simDim,0,0),
-                                              axisLabels);
-
-        std::vector<float_X> gridSpacing(simDim, 0.0);
-        for( uint32_t d = 0; d < simDim; ++d )
-            gridSpacing.at(d) = cellSize[d];
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              splashFloatXType, recordName.c_str(),
-                                              "gridSpacing",
-                                              1u, Dimensions(simDim,0,0),
-                                              &(*gridSpacing.begin()));
-
-        std::vector<float_64> gridGlobalOffset(simDim, 0.0);
-        for( uint32_t d = 0; d < simDim; ++d )
-            gridGlobalOffset.at(d) = float_64(cellSize[d]) *
-                                     float_64(splashGlobalDomainOffset[d]);
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctDouble, recordName.c_str(),
-                                              "gridGlobalOffset",
-                                              1u, Dimensions(simDim,0,0),
-                                              &(*gridGlobalOffset.begin()));
-
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctDouble, recordName.c_str(),
-                                              "gridUnitSI", &UNIT_LENGTH);
-
-        const std::string fieldSmoothing("none");
-        ColTypeString ctFieldSmoothing(fieldSmoothing.length());
-        params->dataCollector->writeAttribute(params->currentStep,
-                                              ctFieldSmoothing, recordName.c_str(),
-                                              "fieldSmoothing", fieldSmoothing.c_str());
+                                                  ctDouble, recordName.c_str(),
+                                                  "gridGlobalOffset",
+                                                  1u, Dimensions(simDim,0,0),
+                                                  &(*gridGlobalOffset.begin()));
+
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctDouble, recordName.c_str(),
+                                                  "gridUnitSI", &UNIT_LENGTH);
+
+            const std::string fieldSmoothing("none");
+            ColTypeString ctFieldSmoothing(fieldSmoothing.length());
+            params->dataCollector->writeAttribute(params->currentStep,
+                                                  ctFieldSmoothing, recordName.c_str(),
+                                                  "fieldSmoothing", fieldSmoothing.c_str());
+        });
     }
 
 };
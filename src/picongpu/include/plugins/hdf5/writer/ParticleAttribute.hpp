@@ -32,6 +32,9 @@
 #include "traits/GetNComponents.hpp"
 #include "traits/Resolve.hpp"
 
+#include <vector>
+#include <algorithm>
+
 namespace picongpu
 {
 
@@ -42,29 +45,24 @@ using namespace PMacc;
 using namespace splash;
 
 
-/** write attribute of a particle to hdf5 file
+/** create the datasets and write the meta data of a particle attribute
+ *
+ * The particle data is written afterwards in batches with ParticleAttribute.
  *
  * @tparam T_Identifier identifier of a particle record
  */
 template< typename T_Identifier>
-struct ParticleAttribute
+struct ReserveParticleAttribute
 {
-    /** write attribute to hdf5 file
+    /** reserve attribute in hdf5 file
      *
      * @param params wrapped thread params such as domainwriter, ...
-     * @param frame frame with all particles
      * @param speciesPath path for the current species (of FrameType)
-     * @param elements number of particles in this patch
-     * @param elementsOffset number of particles in this patch
      * @param numParticlesGlobal number of particles globally
      */
-    template<typename FrameType>
     HINLINE void operator()(
                             ThreadParams* params,
-                            FrameType& frame,
                             const std::string speciesPath,
-                            const uint64_t elements,
-                            const uint64_t elementsOffset,
                             const uint64_t numParticlesGlobal
     )
     {
@@ -78,7 +76,7 @@ struct ParticleAttribute
 
         const ThreadParams *threadParams = params;
 
-        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) write species attribute: %1%") % Identifier::getName();
+        log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) reserve species attribute: %1%") % Identifier::getName();
 
         SplashType splashType;
         ColTypeDouble ctDouble;
@@ -106,29 +104,17 @@ struct ParticleAttribute
          * and origin at current time step
          * ATTENTION: splash offset are globalSlideOffset + picongpu offsets
          */
-        DataSpace<simDim> globalSlideOffset;
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(threadParams->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const DataSpace<simDim> globalSlideOffset(threadParams->globalSlideOffset);
 
-        Dimensions splashDomainOffset(0, 0, 0);
         Dimensions splashGlobalDomainOffset(0, 0, 0);
-
-        Dimensions splashDomainSize(1, 1, 1);
         Dimensions splashGlobalDomainSize(1, 1, 1);
 
         for (uint32_t d = 0; d < simDim; ++d)
         {
-            splashDomainOffset[d] = threadParams->window.localDimensions.offset[d] + globalSlideOffset[d];
             splashGlobalDomainOffset[d] = threadParams->window.globalDimensions.offset[d] + globalSlideOffset[d];
             splashGlobalDomainSize[d] = threadParams->window.globalDimensions.size[d];
-            splashDomainSize[d] = threadParams->window.localDimensions.size[d];
         }
 
-        typedef typename GetComponentsType<ValueType>::type ComponentValueType;
-
-        ComponentValueType* tmpArray = new ComponentValueType[elements];
-
         for (uint32_t d = 0; d < components; d++)
         {
             std::stringstream datasetName;
@@ -136,27 +122,14 @@ struct ParticleAttribute
             if (components > 1)
                 datasetName << "/" << name_lookup[d];
 
-            ValueType* dataPtr = frame.getIdentifier(Identifier()).getPointer();
-            #pragma omp parallel for
-            for( uint64_t i = 0; i < elements; ++i )
-            {
-                tmpArray[i] = ((ComponentValueType*)dataPtr)[i * components + d];
-            }
-
-            threadParams->dataCollector->writeDomain(
+            threadParams->dataCollector->reserveDomain(
                 threadParams->currentStep,
                 /* Dimensions for global collective buffer */
                 Dimensions(numParticlesGlobal, 1, 1),
-                /* 3D-offset in the globalSize-buffer this process writes to */
-                Dimensions(elementsOffset, 1, 1),
-                /* Type information for data */
-                splashType,
                 /* Number of dimensions (1-3) of the buffer */
                 1u,
-                /* Selection: size in src buffer */
-                splash::Selection(
-                    Dimensions(elements, 1, 1)
-                ),
+                /* Type information for data */
+                splashType,
                 /* Name of the dataset */
                 datasetName.str().c_str(),
                 /* Global domain information */
@@ -165,9 +138,7 @@ struct ParticleAttribute
                     splashGlobalDomainSize
                 ),
                 /* Domain type annotation */
-                DomainCollector::PolyType,
-                /* Buffer with data */
-                tmpArray
+                DomainCollector::PolyType
             );
 
             threadParams->dataCollector->writeAttribute(
@@ -176,8 +147,6 @@ struct ParticleAttribute
                 "unitSI", &(unit.at(d)));
 
         }
-        __deleteArray(tmpArray);
-
 
         threadParams->dataCollector->writeAttribute(
             params->currentStep,
@@ -205,12 +174,88 @@ struct ParticleAttribute
                                                     splashFloatXType, recordPath.c_str(),
                                                     "timeOffset", &timeOffset);
 
-        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) write species attribute: %1%") %
+        log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) reserve species attribute: %1%") %
             Identifier::getName();
     }
 
 };
 
+/** write a batch of a particle attribute to hdf5 file
+ *
+ * The datasets must be created with ReserveParticleAttribute before.
+ * Writing is collective, all ranks must write the same number of batches
+ * (a batch can be empty).
+ *
+ * @tparam T_Identifier identifier of a particle record
+ */
+template< typename T_Identifier>
+struct ParticleAttribute
+{
+    /** write attribute to hdf5 file
+     *
+     * @param params wrapped thread params such as domainwriter, ...
+     * @param frame frame with all particles of the batch
+     * @param speciesPath path for the current species (of FrameType)
+     * @param elements number of particles in this batch
+     * @param elementsOffset global offset of the first particle of this batch
+     */
+    template<typename FrameType>
+    HINLINE void operator()(
+                            ThreadParams* params,
+                            FrameType& frame,
+                            const std::string speciesPath,
+                            const uint64_t elements,
+                            const uint64_t elementsOffset
+    )
+    {
+
+        typedef T_Identifier Identifier;
+        typedef typename PMacc::traits::Resolve<Identifier>::type::type ValueType;
+        const uint32_t components = GetNComponents<ValueType>::value;
+        typedef typename GetComponentsType<ValueType>::type ComponentType;
+
+        const ThreadParams *threadParams = params;
+
+        OpenPMDName<T_Identifier> openPMDName;
+        const std::string recordPath( speciesPath + std::string("/") + openPMDName() );
+
+        const std::string name_lookup[] = {"x", "y", "z"};
+
+        /* at least one element to get a valid pointer for empty batches */
+        std::vector<ComponentType> tmpArray(std::max(elements, uint64_t(1)));
+
+        for (uint32_t d = 0; d < components; d++)
+        {
+            std::stringstream datasetName;
+            datasetName << recordPath;
+            if (components > 1)
+                datasetName << "/" << name_lookup[d];
+
+            ValueType* dataPtr = frame.getIdentifier(Identifier()).getPointer();
+            #pragma omp parallel for
+            for( uint64_t i = 0; i < elements; ++i )
+            {
+                tmpArray[i] = ((ComponentType*)dataPtr)[i * components + d];
+            }
+
+            threadParams->dataCollector->append(
+                threadParams->currentStep,
+                /* size of this batch */
+                Dimensions(elements, 1, 1),
+                /* Number of dimensions (1-3) of the buffer */
+                1u,
+                /* offset in the reserved dataset this batch is written to */
+                Dimensions(elementsOffset, 1, 1),
+                /* Name of the dataset */
+                datasetName.str().c_str(),
+                /* Buffer with data */
+                &(*tmpArray.begin())
+            );
+        }
+    }
+
+};
+
 } //namspace hdf5
 
 } //namespace picongpu
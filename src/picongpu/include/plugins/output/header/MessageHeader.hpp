@@ -131,11 +131,8 @@ struct MessageHeader
 
         /*add sliding windo informations to header*/
         const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
-        sim.simOffsetToNull = DataSpace<DIM2 > ();
-        if (transpose.x() == 1)
-            sim.simOffsetToNull.x() = node.maxSize.x() * numSlides;
-        else if (transpose.y() == 1)
-            sim.simOffsetToNull.y() = node.maxSize.y() * numSlides;
+        const DataSpace<Dim> slideOffset(MovingWindow::getInstance().getSlideOffset(numSlides));
+        sim.simOffsetToNull = DataSpace<DIM2 > (slideOffset[transpose.x()], slideOffset[transpose.y()]);
 
     }
 
@@ -37,6 +37,7 @@
 #include "mappings/kernel/AreaMapping.hpp"
 #include "plugins/ISimulationPlugin.hpp"
 #include "plugins/common/stringHelpers.hpp"
+#include "particles/traits/GetSubCycling.hpp"
 
 #include "mpi/reduceMethods/Reduce.hpp"
 #include "mpi/MPIReduce.hpp"
@@ -53,6 +54,10 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cmath>
+#include <stdexcept>
+#include <sstream>
+#include <algorithm>
 
 namespace picongpu
 {
@@ -105,6 +110,26 @@ private:
     radiation_frequencies::InitFreqFunctor freqInit;
     radiation_frequencies::FreqFunctor freqFkt;
 
+    /**
+     * Real amplitudes deposited on a grid of retarded times (only used if
+     * the time grid mode is enabled).
+     * Layout of the time grid array is:
+     * [t_0(theta_1),...,t_N-time(theta_1),t_0(theta_2),...,t_N-time(theta_N-theta)]
+     * The grid is transformed to the frequency domain and added to
+     * 'radiation' once per output interval.
+     */
+    GridBuffer<vector_64, DIM1> *timeGrid;
+    bool timeGridOn;
+    uint32_t timeGridRefinement;
+    uint32_t timeGridSteps;
+    /* true if amplitudes are deposited but not yet transformed */
+    bool timeGridActive;
+    uint32_t timeGridFirstStep;
+    uint32_t timeGridCapacity;
+    uint32_t numTimeBins;
+    float_64 timeGridStart;
+    float_64 timeGridDelta;
+
     MappingDesc *cellDescription;
     uint32_t notifyFrequency;
     uint32_t dumpPeriod;
@@ -156,6 +181,16 @@ public:
     filename_prefix(pluginPrefix),
     particles(NULL),
     radiation(NULL),
+    timeGrid(NULL),
+    timeGridOn(false),
+    timeGridRefinement(1),
+    timeGridSteps(1000),
+    timeGridActive(false),
+    timeGridFirstStep(0),
+    timeGridCapacity(0),
+    numTimeBins(0),
+    timeGridStart(0.0),
+    timeGridDelta(0.0),
     cellDescription(NULL),
     notifyFrequency(0),
     dumpPeriod(0),
@@ -227,7 +262,10 @@ public:
             ((pluginPrefix + ".omegaList").c_str(), po::value<std::string > (&pathOmegaList)->default_value("_noPath_"), "path to file containing all frequencies to calculate")
             ((pluginPrefix + ".radPerGPU").c_str(), po::bool_switch(&radPerGPU), "enable radiation output from each GPU individually")
             ((pluginPrefix + ".folderRadPerGPU").c_str(), po::value<std::string > (&folderRadPerGPU)->default_value("radPerGPU"), "folder in which the radiation of each GPU is written")
-            ((pluginPrefix + ".compression").c_str(), po::bool_switch(&compressionOn), "enable compression of hdf5 output");
+            ((pluginPrefix + ".compression").c_str(), po::bool_switch(&compressionOn), "enable compression of hdf5 output")
+            ((pluginPrefix + ".timeGrid").c_str(), po::bool_switch(&timeGridOn), "deposit amplitudes on a retarded time grid and transform them to all frequencies once per output interval")
+            ((pluginPrefix + ".timeGridRefinement").c_str(), po::value<uint32_t > (&timeGridRefinement)->default_value(1), "number of time grid points per time step, the Nyquist frequency pi * timeGridRefinement / DELTA_T must exceed all frequencies")
+            ((pluginPrefix + ".timeGridSteps").c_str(), po::value<uint32_t > (&timeGridSteps)->default_value(1000), "maximum number of time steps deposited on the time grid before it is transformed");
     }
 
 
@@ -266,6 +304,9 @@ public:
         if(notifyFrequency == 0)
             return;
 
+        // add amplitudes deposited on the time grid
+        transformTimeGrid();
+
         // collect data GPU -> CPU -> Master
         copyRadiationDeviceToHost();
         collectRadiationOnMaster();
@@ -303,9 +344,47 @@ private:
 
             radiation = new GridBuffer<Amplitude, DIM1 > (DataSpace<DIM1 > (elements_amplitude())); //create one int on GPU and host
 
+            /* the kernels take the change of the momentum since momentumPrev1
+             * as the change within one DELTA_T, a sub-cycled species keeps
+             * momentumPrev1 of its last push over all its steps */
+            if (traits::GetSubCycling<ParticlesType>::type::getValue() != 1u)
+                throw std::runtime_error("Radiation: sub-cycled species are not supported");
+
+            if (timeGridOn)
+            {
+#if (__NYQUISTCHECK__==1) || (__COHERENTINCOHERENTWEIGHTING__==1)
+                throw std::runtime_error("Radiation: the time grid mode does not support "
+                                         "__NYQUISTCHECK__ and __COHERENTINCOHERENTWEIGHTING__");
+#endif
+                if (timeGridRefinement == 0 || timeGridSteps == 0)
+                    throw std::runtime_error("Radiation: timeGridRefinement and timeGridSteps must be greater than zero");
+            }
+
             freqInit.Init(pathOmegaList);
             freqFkt = freqInit.getFunctor();
 
+            if (timeGridOn)
+            {
+                /* the time grid samples the retarded time in steps of
+                 * DELTA_T / timeGridRefinement, higher frequencies than
+                 * pi / timeGridDelta would be aliased */
+                float_64 maxOmega = 0.0;
+                for (uint32_t i = 0; i < radiation_frequencies::N_omega; ++i)
+                    maxOmega = std::max(maxOmega, float_64(freqFkt(i)));
+
+                const float_64 nyquistOmega = PI * float_64(timeGridRefinement) / float_64(DELTA_T);
+                if (maxOmega > nyquistOmega)
+                {
+                    const uint32_t minRefinement = uint32_t(std::ceil(maxOmega * float_64(DELTA_T) / PI));
+                    std::stringstream msg;
+                    msg << "Radiation: the highest frequency " << maxOmega / UNIT_TIME
+                        << " rad/s is above the Nyquist frequency " << nyquistOmega / UNIT_TIME
+                        << " rad/s of the time grid, set timeGridRefinement to at least "
+                        << minRefinement;
+                    throw std::runtime_error(msg.str());
+                }
+            }
+
 
             Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyFrequency);
             PMacc::Filesystem<simDim>& fs = Environment<simDim>::get().Filesystem();
@@ -370,14 +449,14 @@ private:
             // Some funny things that make it possible for the kernel to calculate
             // the absolute position of the particles
             const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-            DataSpace<simDim> localSize(subGrid.getLocalDomain().size);
             const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
             DataSpace<simDim> globalOffset(subGrid.getLocalDomain().offset);
-            globalOffset.y() += (localSize.y() * numSlides);
+            globalOffset += MovingWindow::getInstance().getSlideOffset(numSlides);
 
             // only print data at end of simulation if no dump period was set
             if (dumpPeriod == 0)
             {
+                transformTimeGrid();
                 collectDataGPUToMaster();
                 writeAllFiles(globalOffset);
             }
@@ -390,6 +469,7 @@ private:
             }
 
             __delete(radiation);
+            __delete(timeGrid);
             CUDA_CHECK(cudaGetLastError());
         }
 
@@ -520,6 +600,80 @@ private:
   }
 
 
+  /** prepare an empty time grid for the interval starting at currentStep
+   *
+   * The grid covers all retarded times t - n*r/c of the next
+   * timeGridSteps time steps. |n*r| is bound by the extent of the
+   * global domain including the distance the moving window can travel
+   * during the interval.
+   */
+  void startTimeGrid(uint32_t currentStep)
+  {
+      const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+      const DataSpace<simDim> globalSize(subGrid.getGlobalDomain().size);
+      const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+      /* the window can slide once more within the time grid */
+      const DataSpace<simDim> slideOffset(MovingWindow::getInstance().getSlideOffset(numSlides + 1));
+
+      const float_64 intervalTime = float_64(timeGridSteps) * float_64(DELTA_T);
+
+      float_64 maxDistance2 = 0.0;
+      for (uint32_t d = 0; d < simDim; ++d)
+      {
+          float_64 extent = float_64(globalSize[d]) * float_64(cellSize[d]);
+          if (d == MovingWindow::getInstance().getMoveDirection())
+          {
+              extent += float_64(slideOffset[d]) * float_64(cellSize[d]) +
+                  float_64(SPEED_OF_LIGHT) * intervalTime;
+          }
+          maxDistance2 += extent * extent;
+      }
+      const float_64 maxDelay = std::sqrt(maxDistance2) / float_64(SPEED_OF_LIGHT);
+
+      timeGridDelta = float_64(DELTA_T) / float_64(timeGridRefinement);
+      timeGridStart = float_64(currentStep) * float_64(DELTA_T) - maxDelay - timeGridDelta;
+      numTimeBins = uint32_t(std::ceil((intervalTime + 2.0 * maxDelay) / timeGridDelta)) + 3u;
+
+      if (numTimeBins > timeGridCapacity)
+      {
+          __delete(timeGrid);
+          timeGridCapacity = numTimeBins;
+          timeGrid = new GridBuffer<vector_64, DIM1 > (DataSpace<DIM1 > (timeGridCapacity * parameters::N_observer));
+          log<radLog::SIMULATION_STATE > ("Radiation (%1%): time grid with %2% points per direction") %
+              speciesName % timeGridCapacity;
+      }
+      timeGrid->getDeviceBuffer().reset(false);
+
+      timeGridFirstStep = currentStep;
+      timeGridActive = true;
+  }
+
+
+  /** add the frequency spectrum of the time grid to the radiated amplitudes
+   *
+   * does nothing if no amplitudes were deposited since the last transformation
+   */
+  void transformTimeGrid()
+  {
+      if (!timeGridActive)
+          return;
+
+      __cudaKernel(kernelRadiationTimeGridTransform)
+        (dim3(parameters::N_observer),
+         dim3(PMacc::math::CT::volume<typename MappingDesc::SuperCellSize>::type::value))
+        (
+         timeGrid->getDeviceBuffer().getDataBox(),
+         radiation->getDeviceBuffer().getDataBox(),
+         numTimeBins,
+         timeGridStart,
+         timeGridDelta,
+         freqFkt
+         );
+
+      timeGridActive = false;
+  }
+
+
   /** perform all operations to get data from GPU to master */
   void collectDataGPUToMaster()
   {
@@ -1182,30 +1336,54 @@ private:
 
       // Some funny things that make it possible for the kernel to calculate
       // the absolute position of the particles
-      DataSpace<simDim> localSize(cellDescription->getGridLayout().getDataSpaceWithoutGuarding());
       const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
       const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
       DataSpace<simDim> globalOffset(subGrid.getLocalDomain().offset);
-      globalOffset.y() += (localSize.y() * numSlides);
+      globalOffset += MovingWindow::getInstance().getSlideOffset(numSlides);
 
 
-      // PIC-like kernel call of the radiation kernel
-      __cudaKernel(kernelRadiationParticles)
-        (gridDim_rad, blockDim_rad)
-        (
-         /*Pointer to particles memory on the device*/
-         particles->getDeviceParticlesBox(),
-
-         /*Pointer to memory of radiated amplitude on the device*/
-         radiation->getDeviceBuffer().getDataBox(),
-         globalOffset,
-         currentStep, *cellDescription,
-         freqFkt,
-         subGrid.getGlobalDomain().size
-         );
+      if (timeGridOn)
+      {
+          // the time grid only covers a limited number of time steps
+          if (timeGridActive && currentStep >= timeGridFirstStep + timeGridSteps)
+              transformTimeGrid();
+          if (!timeGridActive)
+              startTimeGrid(currentStep);
+
+          __cudaKernel(kernelRadiationTimeGrid)
+            (gridDim_rad, blockDim_rad)
+            (
+             particles->getDeviceParticlesBox(),
+             timeGrid->getDeviceBuffer().getDataBox(),
+             numTimeBins,
+             timeGridStart,
+             timeGridDelta,
+             globalOffset,
+             currentStep, *cellDescription,
+             subGrid.getGlobalDomain().size
+             );
+      }
+      else
+      {
+          // PIC-like kernel call of the radiation kernel
+          __cudaKernel(kernelRadiationParticles)
+            (gridDim_rad, blockDim_rad)
+            (
+             /*Pointer to particles memory on the device*/
+             particles->getDeviceParticlesBox(),
+
+             /*Pointer to memory of radiated amplitude on the device*/
+             radiation->getDeviceBuffer().getDataBox(),
+             globalOffset,
+             currentStep, *cellDescription,
+             freqFkt,
+             subGrid.getGlobalDomain().size
+             );
+      }
 
       if (dumpPeriod != 0 && currentStep % dumpPeriod == 0)
       {
+          transformTimeGrid();
           collectDataGPUToMaster();
           writeAllFiles(globalOffset);
 
@@ -0,0 +1,230 @@
+/**
+ * Copyright 2016 Rene Widera
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "mappings/simulation/GridController.hpp"
+#include "mappings/simulation/SubGrid.hpp"
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+namespace picongpu
+{
+using namespace PMacc;
+
+/**
+ * Computes a balanced distribution of the cells over the devices.
+ *
+ * The cost of all devices is reduced to a cost profile along each axis.
+ * Within the domain of a device the cost is assumed to be distributed
+ * equally over its cells. The boundaries between the devices are moved so
+ * that each slab of devices gets the same share of the cost.
+ *
+ * The devices and their number per axis are kept, the result is a new
+ * `--gridDist` in the syntax of ParserGridDistribution. Domains are not
+ * migrated during a run, the distribution is applied when restarting from
+ * a checkpoint (see MySimulation::loadBalancedGridDist).
+ *
+ * The axis of a moving window with rotating devices is not balanced, the
+ * slides of the window require the same number of cells on all devices.
+ */
+class GridBalancer
+{
+public:
+
+    /**
+     * @param minSuperCells minimal number of supercells of a device along an axis
+     * @param uniformAxis axis which keeps its distribution, simDim to balance all axes
+     */
+    GridBalancer(const uint32_t minSuperCells, const uint32_t uniformAxis = simDim) :
+    minSuperCells(minSuperCells),
+    uniformAxis(uniformAxis),
+    imbalance(1.0)
+    {
+    }
+
+    /** Compute a balanced distribution
+     *
+     * Must be called collectively.
+     *
+     * @param localCost cost of the domain of this device, e.g. the number of
+     *                  macro particles
+     * @return imbalance of the current distribution: maximum cost of all
+     *         devices divided by the mean cost
+     */
+    double update(const float_64 localCost)
+    {
+        GridController<simDim> &gc = Environment<simDim>::get().GridController();
+        MPI_Comm comm = gc.getCommunicator().getMPIComm();
+        const DataSpace<simDim> devices(gc.getGpuNodes());
+        const DataSpace<simDim> position(gc.getPosition());
+        const DataSpace<simDim> localSize(Environment<simDim>::get().SubGrid().getLocalDomain().size);
+
+        /* cost and cells of each slab of devices along all axes */
+        uint32_t numSlabs = 0;
+        for (uint32_t d = 0; d < simDim; ++d)
+            numSlabs += devices[d];
+
+        std::vector<float_64> slabCost(numSlabs, 0.0);
+        std::vector<uint32_t> slabCells(numSlabs, 0);
+        uint32_t slabOffset = 0;
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            slabCost[slabOffset + position[d]] = localCost;
+            slabCells[slabOffset + position[d]] = localSize[d];
+            slabOffset += devices[d];
+        }
+
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &slabCost[0], numSlabs, MPI_DOUBLE, MPI_SUM, comm));
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &slabCells[0], numSlabs, MPI_UINT32_T, MPI_MAX, comm));
+
+        float_64 maxCost = localCost;
+        float_64 sumCost = localCost;
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &maxCost, 1, MPI_DOUBLE, MPI_MAX, comm));
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &sumCost, 1, MPI_DOUBLE, MPI_SUM, comm));
+        const float_64 meanCost = sumCost / float_64(devices.productOfComponents());
+        imbalance = meanCost > 0.0 ? maxCost / meanCost : 1.0;
+
+        const DataSpace<simDim> superCellSize(MappingDesc::SuperCellSize::toRT());
+        gridDistribution.resize(simDim);
+        slabOffset = 0;
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            const std::vector<uint32_t> sizes(slabCells.begin() + slabOffset,
+                                              slabCells.begin() + slabOffset + devices[d]);
+            const std::vector<float_64> costs(slabCost.begin() + slabOffset,
+                                              slabCost.begin() + slabOffset + devices[d]);
+            if (d == uniformAxis)
+                gridDistribution[d] = toString(sizes);
+            else
+                gridDistribution[d] = toString(balanceAxis(sizes, costs, superCellSize[d], minSuperCells));
+            slabOffset += devices[d];
+        }
+
+        return imbalance;
+    }
+
+    /** Imbalance of the distribution at the last update() */
+    double getImbalance() const
+    {
+        return imbalance;
+    }
+
+    /** Balanced distribution of the last update(), one entry per axis */
+    const std::vector<std::string>& getGridDistribution() const
+    {
+        return gridDistribution;
+    }
+
+    /** Balance the cells of one axis
+     *
+     * @param sizes number of cells of each slab of devices
+     * @param costs cost of each slab of devices
+     * @param superCellSize cells of a supercell along this axis
+     * @param minSuperCells minimal number of supercells of a slab
+     * @return new number of cells of each slab
+     */
+    static std::vector<uint32_t> balanceAxis(const std::vector<uint32_t>& sizes,
+                                             const std::vector<float_64>& costs,
+                                             const uint32_t superCellSize,
+                                             const uint32_t minSuperCells)
+    {
+        const uint32_t numSlabs = sizes.size();
+
+        /* cost of each supercell along the axis */
+        std::vector<float_64> superCellCost;
+        for (uint32_t i = 0; i < numSlabs; ++i)
+        {
+            const uint32_t superCells = sizes[i] / superCellSize;
+            for (uint32_t c = 0; c < superCells; ++c)
+                superCellCost.push_back(costs[i] / float_64(superCells));
+        }
+        const uint32_t numSuperCells = superCellCost.size();
+
+        float_64 totalCost = 0.0;
+        for (uint32_t c = 0; c < numSuperCells; ++c)
+            totalCost += superCellCost[c];
+
+        if (totalCost <= 0.0 || numSuperCells < numSlabs * minSuperCells)
+            return sizes;
+
+        std::vector<uint32_t> result(numSlabs);
+        uint32_t begin = 0;
+        float_64 cost = 0.0;
+        for (uint32_t i = 0; i < numSlabs - 1; ++i)
+        {
+            const float_64 targetCost = totalCost * float_64(i + 1) / float_64(numSlabs);
+            /* keep enough supercells for the remaining slabs */
+            const uint32_t minEnd = begin + minSuperCells;
+            const uint32_t maxEnd = numSuperCells - (numSlabs - 1 - i) * minSuperCells;
+
+            uint32_t end = begin;
+            while (end < minEnd)
+                cost += superCellCost[end++];
+            /* take the next supercell if the boundary gets closer to the target */
+            while (end < maxEnd && cost + 0.5 * superCellCost[end] < targetCost)
+                cost += superCellCost[end++];
+
+            result[i] = (end - begin) * superCellSize;
+            begin = end;
+        }
+        result[numSlabs - 1] = (numSuperCells - begin) * superCellSize;
+
+        return result;
+    }
+
+    /** Write cells of each slab in the syntax of ParserGridDistribution
+     *
+     * @param sizes number of cells of each slab
+     * @return e.g. "64{2},32" for 64, 64, 32 cells
+     */
+    static std::string toString(const std::vector<uint32_t>& sizes)
+    {
+        std::ostringstream result;
+        for (uint32_t i = 0; i < sizes.size();)
+        {
+            uint32_t repeat = 1;
+            while (i + repeat < sizes.size() && sizes[i + repeat] == sizes[i])
+                ++repeat;
+
+            if (i != 0)
+                result << ",";
+            result << sizes[i];
+            if (repeat > 1)
+                result << "{" << repeat << "}";
+            i += repeat;
+        }
+        return result.str();
+    }
+
+private:
+
+    uint32_t minSuperCells;
+    uint32_t uniformAxis;
+    double imbalance;
+    std::vector<std::string> gridDistribution;
+};
+
+} // namespace picongpu
@@ -24,6 +24,9 @@
 #include "simulation_defines.hpp"
 
 #include "simulationControl/Window.hpp"
+#include "mappings/kernel/RegionMapping.hpp"
+
+#include <algorithm>
 
 namespace picongpu
 {
@@ -37,7 +40,8 @@ class MovingWindow
 {
 private:
 
-    MovingWindow() : slidingWindowActive(false), slideCounter(0), lastSlideStep(0)
+    MovingWindow() : slidingWindowActive(false), moveDirection(1), incrementalSlides(false),
+        initExposedOnly(false), slideCounter(0), lastSlideStep(0)
     {
     }
 
@@ -58,23 +62,15 @@ private:
             /* speed of the moving window */
             const float_64 windowMovingSpeed = float_64(SPEED_OF_LIGHT);
 
-            /* defines in which direction the window moves
-             *
-             * 0 == x,  1 == y , 2 == z direction
-             *
-             * note: currently only y direction is supported
-             */
-            const uint32_t moveDirection = 1;
-
             /* the moving window is smaller than the global domain by exactly one
-             * GPU (local domain size)
+             * slide distance (local domain size or supercell size)
              * \todo calculation of the globalWindowSizeInMoveDirection is constant should be
              * only done once in it's own central object/api
              */
-            const uint32_t globalWindowSizeInMoveDirection =
-                subGrid.getGlobalDomain().size[moveDirection] - subGrid.getLocalDomain().size[moveDirection];
+            const uint32_t gpuNumberOfCellsInMoveDirection = getSlideDistance();
 
-            const uint32_t gpuNumberOfCellsInMoveDirection = subGrid.getLocalDomain().size[moveDirection];
+            const uint32_t globalWindowSizeInMoveDirection =
+                subGrid.getGlobalDomain().size[moveDirection] - gpuNumberOfCellsInMoveDirection;
 
             /* unit PIConGPU length */
             const float_64 cellSizeInMoveDirection = float_64(cellSize[moveDirection]);
@@ -139,8 +135,8 @@ private:
                  */
                 const bool endOfInitialGlobalDomain = firstSlideStep <= currentStep;
 
-                /* virtual particle will pass a GPU border during the current
-                 * (to be simulated) time step
+                /* virtual particle will pass a GPU border (supercell border for
+                 * incremental slides) during the current (to be simulated) time step
                  */
                 const bool virtualParticlePassesGPUBorder =
                     (nextVirtualParticlePositionInCells % gpuNumberOfCellsInMoveDirection) <
@@ -157,8 +153,8 @@ private:
                 if (offsetFirstGPU)
                 {
                     /* since the moving window in PIConGPU always starts on the
-                     * first plane (3D) / row (2D) of GPUs in move direction, this
-                     * calculation is equal to the globalWindow.offset in move direction
+                     * first plane (3D) / row (2D) of GPUs (supercells) in move direction,
+                     * this calculation is equal to the globalWindow.offset in move direction
                      *
                      * note: also works with windowMovingSpeed > c
                      */
@@ -186,9 +182,32 @@ private:
         }
     }
 
+    /** number of cells the global domain moves with one slide
+     *
+     * A slide moves the global domain by one local domain (the GPUs are
+     * rotated) or by one supercell for incremental slides.
+     */
+    uint32_t getSlideDistance() const
+    {
+        if (incrementalSlides)
+            return SuperCellSize::toRT()[moveDirection];
+
+        /* all GPUs have the same number of cells in move direction */
+        return Environment<simDim>::get().SubGrid().getLocalDomain().size[moveDirection];
+    }
+
     /** true is sliding window is activated */
     bool slidingWindowActive;
 
+    /** direction of the moving window (0 == x, 1 == y, 2 == z) */
+    uint32_t moveDirection;
+
+    /** true if the data is moved by one supercell per slide */
+    bool incrementalSlides;
+
+    /** true if the particle init pipeline is restricted to the exposed supercells */
+    bool initExposedOnly;
+
     /** current number of slides since start of simulation */
     uint32_t slideCounter;
 
@@ -209,6 +228,83 @@ public:
         slidingWindowActive = value;
     }
 
+    /**
+     * Set the direction in which the window moves
+     *
+     * @param direction 0 == x, 1 == y, 2 == z
+     */
+    void setMoveDirection(uint32_t direction)
+    {
+        moveDirection = direction;
+    }
+
+    /**
+     * Return the direction in which the window moves (0 == x, 1 == y, 2 == z)
+     */
+    uint32_t getMoveDirection() const
+    {
+        return moveDirection;
+    }
+
+    /**
+     * Enable or disable incremental slides
+     *
+     * An incremental slide moves the fields and particles on each GPU by one
+     * supercell and initializes only the exposed supercells.
+     * Otherwise the GPUs are rotated once the window passed a whole GPU and the
+     * GPU which becomes the last one in move direction is initialized completely.
+     *
+     * @param value true to move by supercells, false to rotate the GPUs
+     */
+    void setIncrementalSlides(bool value)
+    {
+        incrementalSlides = value;
+    }
+
+    /**
+     * Returns if the window moves by supercells instead of rotating the GPUs
+     */
+    bool isIncrementalSlides() const
+    {
+        return incrementalSlides;
+    }
+
+    /**
+     * Restrict the particle init pipeline to the supercells exposed by an
+     * incremental slide \see getInitMapping
+     *
+     * @param value true to initialize only the exposed supercells, false for all
+     */
+    void setInitExposedSuperCells(bool value)
+    {
+        initExposedOnly = value;
+    }
+
+    /**
+     * Return a mapping of the supercells which are initialized by the particle
+     * init pipeline
+     *
+     * This is the CORE+BORDER area, except while the supercells exposed by an
+     * incremental slide are initialized. Those are the last supercells in move
+     * direction of the last GPU in move direction.
+     *
+     * @param cellDescription mapping description of the local domain
+     * @return mapping of the supercells to initialize
+     */
+    RegionMapping<MappingDesc> getInitMapping(const MappingDesc& cellDescription) const
+    {
+        DataSpace<simDim> offset(DataSpace<simDim>::create(cellDescription.getGuardingSuperCells()));
+        DataSpace<simDim> size(cellDescription.getGridSuperCells() - 2 * cellDescription.getGuardingSuperCells());
+
+        if (initExposedOnly)
+        {
+            offset[moveDirection] += size[moveDirection] - 1;
+            size[moveDirection] = 1;
+        }
+
+        return RegionMapping<MappingDesc>(cellDescription, offset, size);
+    }
+
     /**
      * Set the number of already performed moving window slides
      *
@@ -266,13 +362,29 @@ public:
     }
 
     /**
-     * Return true if this is a 'bottom' GPU (y position is y_size - 1), false otherwise
-     * only set if sliding window is active
+     * Return the offset of the global domain to its position at the begin
+     * of the simulation [in cells]
+     *
+     * @param numSlides number of slides \see getSlideCounter
+     * @return offset due to slides (only non-zero in move direction)
      */
-    bool isBottomGPU(void) const
+    DataSpace<simDim> getSlideOffset(uint32_t numSlides) const
     {
-        Mask comm_mask = Environment<simDim>::get().GridController().getCommunicationMask();
-        return !comm_mask.isSet(BOTTOM);
+        DataSpace<simDim> offset;
+        offset[moveDirection] = numSlides * getSlideDistance();
+        return offset;
+    }
+
+    /**
+     * Return true if this is the last GPU in move direction (it has no neighbor
+     * in positive move direction), false otherwise
+     */
+    bool isLastGPUInMoveDirection() const
+    {
+        const Mask comm_mask = Environment<simDim>::get().GridController().getCommunicationMask();
+        /* exchange types in positive direction: x == RIGHT, y == BOTTOM, z == BACK */
+        const uint32_t exchangeTypes[] = {RIGHT, BOTTOM, BACK};
+        return !comm_mask.isSet(exchangeTypes[moveDirection]);
     }
 
     /**
@@ -308,43 +420,34 @@ public:
         window.localDimensions = subGrid.getLocalDomain();
         window.globalDimensions = Selection<simDim>(subGrid.getGlobalDomain().size);
 
-        /* moving window can only slide in y direction */
         if (slidingWindowActive)
         {
+            const uint32_t d = moveDirection;
+
             /* the moving window is smaller than the global domain by exactly one
-             * GPU (local domain size) in moving (y) direction
+             * slide distance in move direction
              */
-            window.globalDimensions.size.y() -= subGrid.getLocalDomain().size.y();
+            window.globalDimensions.size[d] -= getSlideDistance();
 
             float_64 offsetFirstGPU = 0.0;
             getCurrentSlideInfo(currentStep, NULL, &offsetFirstGPU);
 
             /* while moving, the windows global offset within the global domain is between 0
-             * and smaller than the local domain's size in y.
+             * and smaller than the slide distance.
              */
-            window.globalDimensions.offset.y() = offsetFirstGPU;
-
-            /* set top/bottom if there are no communication partners
-             * for this GPU in the respective direction */
-            const Mask comm_mask = Environment<simDim>::get().GridController().getCommunicationMask();
-            const bool isTopGpu = !comm_mask.isSet(TOP);
-            const bool isBottomGpu = !comm_mask.isSet(BOTTOM);
+            window.globalDimensions.offset[d] = offsetFirstGPU;
 
-            if (isTopGpu)
-            {
-                /* the windows local offset within the global window is reduced
-                 * by the global window offset within the global domain
-                 */
-                window.localDimensions.size.y() -= offsetFirstGPU;
-            }
-            else
-            {
-                window.localDimensions.offset.y() = subGrid.getLocalDomain().offset.y() - offsetFirstGPU;
-                if (isBottomGpu)
-                {
-                    window.localDimensions.size.y() = offsetFirstGPU;
-                }
-            }
+            /* the local window is the part of the global window which overlaps
+             * with the local domain, its offset is relative to the global window
+             */
+            const int windowBegin = window.globalDimensions.offset[d];
+            const int windowEnd = windowBegin + window.globalDimensions.size[d];
+            const int localBegin = std::max(windowBegin, subGrid.getLocalDomain().offset[d]);
+            const int localEnd = std::min(windowEnd,
+                                          subGrid.getLocalDomain().offset[d] + subGrid.getLocalDomain().size[d]);
+
+            window.localDimensions.offset[d] = localBegin - windowBegin;
+            window.localDimensions.size[d] = std::max(localEnd - localBegin, 0);
         }
 
         return window;
@@ -25,10 +25,13 @@
 #include <cassert>
 #include <string>
 #include <vector>
+#include <sstream>
+#include <fstream>
 #include <boost/lexical_cast.hpp>
 
 #include "pmacc_types.hpp"
 #include "simulationControl/SimulationHelper.hpp"
+#include "simulationControl/ProfilePhase.hpp"
 #include "simulation_defines.hpp"
 
 #include "eventSystem/EventSystem.hpp"
@@ -37,6 +40,8 @@
 #include "nvidia/memory/MemoryInfo.hpp"
 #include "mappings/kernel/MappingDescription.hpp"
 #include "simulationControl/MovingWindow.hpp"
+#include "simulationControl/GridBalancer.hpp"
+#include "mappings/simulation/ResourceMonitor.tpp"
 #include "mappings/simulation/SubGrid.hpp"
 #include "mappings/simulation/GridController.hpp"
 
@@ -44,18 +49,15 @@
 #include "fields/FieldB.hpp"
 #include "fields/FieldJ.hpp"
 #include "fields/FieldTmp.hpp"
+#include "fields/FieldManipulator.hpp"
 #include "fields/MaxwellSolver/Solvers.hpp"
+#include "fields/absorber/Pml.hpp"
 #include "fields/currentInterpolation/CurrentInterpolation.hpp"
 #include "fields/background/cellwiseOperation.hpp"
 #include "initialization/IInitPlugin.hpp"
 #include "initialization/ParserGridDistribution.hpp"
 #include "particles/synchrotronPhotons/SynchrotronFunctions.hpp"
 
-#if 0
-#include "random/methods/XorMin.hpp"
-#include "random/RNGProvider.hpp"
-#endif
-
 #include "nvidia/reduce/Reduce.hpp"
 #include "memory/boxes/DataBoxDim1Access.hpp"
 #include "nvidia/functors/Add.hpp"
@@ -67,9 +69,7 @@
 #include "algorithms/ForEach.hpp"
 #include "particles/ParticlesFunctors.hpp"
 #include "particles/InitFunctors.hpp"
-#if (PMACC_CUDA_ENABLED == 1)
 #include "particles/memory/buffers/MallocMCBuffer.hpp"
-#endif
 #include "particles/traits/FilterByFlag.hpp"
 #include "particles/IdProvider.hpp"
 
@@ -100,19 +100,21 @@ public:
     fieldE(NULL),
     fieldJ(NULL),
     fieldTmp(NULL),
-#if (PMACC_CUDA_ENABLED == 1)
+    fieldTmpCache(NULL),
     mallocMCBuffer(NULL),
-#endif
     myFieldSolver(NULL),
     myCurrentInterpolation(NULL),
     pushBGField(NULL),
     currentBGField(NULL),
     cellDescription(NULL),
     initialiserController(NULL),
-    slidingWindow(false)
-#if 0
-    ,rngFactory(NULL)
-#endif
+    slidingWindow(false),
+    movingWindowDirection(1),
+    incrementalSlides(false),
+    fieldTmpCacheMemory(0),
+    gridBalancer(NULL),
+    balancePeriod(0),
+    balanceCellCost(0.1)
     {
         ForEach<VectorAllSpecies, particles::AssignNull<bmpl::_1>, MakeIdentifier<bmpl::_1> > setPtrToNull;
         setPtrToNull(forward(particleStorage));
@@ -138,7 +140,25 @@ public:
             ("periodic", po::value<std::vector<uint32_t> > (&periodic)->multitoken(),
              "specifying whether the grid is periodic (1) or not (0) in each dimension, default: no periodic dimensions")
 
-            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window");
+            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window")
+            ("moving.direction", po::value<uint32_t>(&movingWindowDirection)->default_value(movingWindowDirection),
+             "direction of the moving window: 0 == x, 1 == y, 2 == z")
+            ("moving.incremental", po::value<bool>(&incrementalSlides)->zero_tokens(),
+             "move fields and particles by one supercell per slide and initialize only the exposed cells, "
+             "default: rotate the devices once the window passed a whole device")
+
+            ("fieldTmpCache.memory", po::value<uint32_t>(&fieldTmpCacheMemory),
+             "memory in MiB per device for additional FieldTmp slots which cache derived fields "
+             "(e.g. densities) shared by output plugins within a time step, default: 0 (only one slot)")
+
+            ("balance.period", po::value<uint32_t>(&balancePeriod),
+             "measure the load of all devices every n-th step and compute a balanced --gridDist, "
+             "it is logged and stored with each checkpoint; a --restart with --balance.period "
+             "and without --gridDist uses the distribution stored with the checkpoint "
+             "(domains are not migrated during a run, HDF5 checkpoints only; the direction "
+             "of a moving window with rotating devices is not balanced)")
+            ("balance.cellCost", po::value<float_64>(&balanceCellCost)->default_value(balanceCellCost),
+             "cost of a cell relative to the cost of a macro particle for --balance.period");
     }
 
     std::string pluginGetName() const
@@ -170,9 +190,17 @@ public:
             if (gridSize.size() == 2)
             gridSize.push_back(1);
 
-        if (slidingWindow && devices[1] == 1)
+        if (slidingWindow && movingWindowDirection >= simDim)
+        {
+            std::cerr << "Invalid moving window direction " << movingWindowDirection << std::endl;
+            movingWindowDirection = 1;
+        }
+
+        /* only the rotation of the devices needs a device which is outside of the window */
+        if (slidingWindow && !incrementalSlides && devices[movingWindowDirection] == 1)
         {
-            std::cerr << "Invalid configuration. Can't use moving window with one device in Y direction" << std::endl;
+            std::cerr << "Invalid configuration. Can't use moving window with one device in move direction "
+                "(use --moving.incremental)" << std::endl;
         }
 
         DataSpace<simDim> global_grid_size;
@@ -187,9 +215,13 @@ public:
         }
 
         Environment<simDim>::get().initDevices(gpus, isPeriodic);
+        Environment<simDim>::get().GridController().setSlideDirection(movingWindowDirection);
 
         DataSpace<simDim> myGPUpos(Environment<simDim>::get().GridController().getPosition());
 
+        if (this->restartRequested && balancePeriod > 0)
+            loadBalancedGridDist(global_grid_size, gpus);
+
         // calculate the number of local grid cells and
         // the local cell offset to the global box
         for (uint32_t dim = 0; dim < gridDistribution.size() && dim < simDim; ++dim)
@@ -211,6 +243,8 @@ public:
         Environment<simDim>::get().initGrids(global_grid_size, gridSizeLocal, gridOffset);
 
         MovingWindow::getInstance().setSlidingWindow(slidingWindow);
+        MovingWindow::getInstance().setMoveDirection(movingWindowDirection);
+        MovingWindow::getInstance().setIncrementalSlides(incrementalSlides);
 
         log<picLog::DOMAINS > ("rank %1%; localsize %2%; localoffset %3%;") %
             myGPUpos.toString() % gridSizeLocal.toString() % gridOffset.toString();
@@ -225,7 +259,8 @@ public:
         if (Environment<simDim>::get().GridController().getGlobalRank() == 0)
         {
             if (slidingWindow)
-                log<picLog::PHYSICS > ("Sliding Window is ON");
+                log<picLog::PHYSICS > ("Sliding Window is ON (direction %1%, %2%)") %
+                    movingWindowDirection % (incrementalSlides ? "incremental" : "rotating devices");
             else
                 log<picLog::PHYSICS > ("Sliding Window is OFF");
         }
@@ -245,6 +280,16 @@ public:
                 assert((int) ABSORBER_CELLS[i][1] <= (int) cellDescription->getGridLayout().getDataSpaceWithoutGuarding()[i]);
             }
         }
+
+        if (balancePeriod > 0)
+        {
+            /* local size must be at least 3 supercells, see checkGridConfiguration(),
+             * a window with rotating devices slides by the uniform local size
+             */
+            const uint32_t uniformAxis = slidingWindow && !incrementalSlides ? movingWindowDirection : simDim;
+            gridBalancer = new GridBalancer(3 * GUARD_SIZE, uniformAxis);
+            Environment<>::get().PluginConnector().setNotificationPeriod(this, balancePeriod);
+        }
     }
 
     virtual void pluginUnload()
@@ -257,10 +302,9 @@ public:
 
         __delete(fieldJ);
 
+        __delete(fieldTmpCache);
         __delete(fieldTmp);
-#if (PMACC_CUDA_ENABLED == 1)
         __delete(mallocMCBuffer);
-#endif
         __delete(myFieldSolver);
 
         __delete(myCurrentInterpolation);
@@ -268,18 +312,61 @@ public:
         ForEach<VectorAllSpecies, particles::CallDelete<bmpl::_1>, MakeIdentifier<bmpl::_1> > deleteParticleMemory;
         deleteParticleMemory(forward(particleStorage));
 
+        __delete(gridBalancer);
         __delete(laser);
         __delete(pushBGField);
         __delete(currentBGField);
         __delete(cellDescription);
-#if 0
-        __delete(rngFactory);
-#endif
     }
 
-    void notify(uint32_t)
+    /** Measure the load of all devices and compute a balanced distribution
+     *
+     * The cost of a device is the number of macro particles of all species
+     * plus the weighted number of cells.
+     */
+    void notify(uint32_t currentStep)
     {
+        if (gridBalancer == NULL)
+            return;
+
+        std::vector<size_t> particleCounts =
+            ResourceMonitor<simDim>().getParticleCounts<VectorAllSpecies>(*cellDescription);
+
+        float_64 cost = balanceCellCost * float_64(ResourceMonitor<simDim>().getCellCount());
+        for (size_t i = 0; i < particleCounts.size(); ++i)
+            cost += float_64(particleCounts[i]);
+
+        const double imbalance = gridBalancer->update(cost);
 
+        if (Environment<simDim>::get().GridController().getGlobalRank() == 0)
+        {
+            log<picLog::DOMAINS > ("step %1%: load imbalance (max/mean) %2%, balanced distribution --gridDist %3%") %
+                currentStep % imbalance % toGridDistArguments(gridBalancer->getGridDistribution());
+        }
+    }
+
+    /** Store the balanced distribution with the checkpoint
+     *
+     * `gridDist_<step>.txt` holds one --gridDist string per dimension and is
+     * read by loadBalancedGridDist() if the simulation is restarted from
+     * this checkpoint. Called by SimulationHelper::dumpOneStep().
+     */
+    void checkpoint(uint32_t currentStep, const std::string checkpointDirectory)
+    {
+        if (gridBalancer == NULL || gridBalancer->getGridDistribution().empty())
+            return;
+
+        if (Environment<simDim>::get().GridController().getGlobalRank() == 0)
+        {
+            const std::string filename = getGridDistFilename(checkpointDirectory, currentStep);
+            std::ofstream file(filename.c_str());
+            if (!file)
+                throw std::runtime_error("Failed to write " + filename);
+
+            const std::vector<std::string>& gridDist = gridBalancer->getGridDistribution();
+            for (size_t d = 0; d < gridDist.size(); ++d)
+                file << gridDist[d] << std::endl;
+        }
     }
 
     virtual void init()
@@ -290,6 +377,7 @@ public:
         fieldE = new FieldE(*cellDescription);
         fieldJ = new FieldJ(*cellDescription);
         fieldTmp = new FieldTmp(*cellDescription);
+        fieldTmpCache = new FieldTmpCache(*cellDescription, *fieldTmp, size_t(fieldTmpCacheMemory) * 1024 * 1024);
         pushBGField = new cellwiseOperation::CellwiseOperation < CORE + BORDER + GUARD > (*cellDescription);
         currentBGField = new cellwiseOperation::CellwiseOperation < CORE + BORDER + GUARD > (*cellDescription);
 
@@ -298,20 +386,25 @@ public:
         ForEach<VectorAllSpecies, particles::CreateSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > createSpeciesMemory;
         createSpeciesMemory(forward(particleStorage), cellDescription);
 
+        /* the field solver is created after the heap, keep its absorber layers free */
+        size_t reservedMemory = reservedGpuMemorySize;
+        if (fieldAbsorber::usePml)
+            reservedMemory += fieldAbsorber::Pml::getMemorySize(*cellDescription);
+
         size_t freeGpuMem(0);
         Environment<>::get().MemoryInfo().getMemoryInfo(&freeGpuMem);
-        if(freeGpuMem < reservedGpuMemorySize)
+        if(freeGpuMem < reservedMemory)
         {
             PMacc::log< picLog::MEMORY > ("%1% MiB free memory < %2% MiB required reserved memory")
-                % (freeGpuMem / 1024 / 1024) % (reservedGpuMemorySize / 1024 / 1024) ;
+                % (freeGpuMem / 1024 / 1024) % (reservedMemory / 1024 / 1024) ;
             std::stringstream msg;
             msg << "Cannot reserve "
-                << (reservedGpuMemorySize / 1024 / 1024) << " MiB as there is only "
+                << (reservedMemory / 1024 / 1024) << " MiB as there is only "
                 << (freeGpuMem / 1024 / 1024) << " MiB free GPU memory left";
             throw std::runtime_error(msg.str());
         }
 
-        size_t heapSize = freeGpuMem - reservedGpuMemorySize;
+        size_t heapSize = freeGpuMem - reservedMemory;
 
         if( Environment<>::get().MemoryInfo().isSharedMemoryPool() )
         {
@@ -324,8 +417,12 @@ public:
         // initializing the heap for particles
 #if (PMACC_CUDA_ENABLED == 1)
         mallocMC::initHeap(heapSize);
-        this->mallocMCBuffer = new MallocMCBuffer();
+#else
+        HostFrameHeap::getInstance().init(heapSize);
+        log<picLog::MEMORY > ("host frame heap: %1% MiB in chunks of %2% MiB") %
+            (heapSize / 1024 / 1024) % (HostFrameHeap::chunkSize / 1024 / 1024);
 #endif
+        this->mallocMCBuffer = new MallocMCBuffer();
         ForEach<VectorAllSpecies, particles::CallCreateParticleBuffer<bmpl::_1>, MakeIdentifier<bmpl::_1> > createParticleBuffer;
         createParticleBuffer(forward(particleStorage));
 
@@ -338,6 +435,7 @@ public:
         fieldE->init(*fieldB, *laser);
         fieldJ->init(*fieldE, *fieldB);
         fieldTmp->init();
+        fieldTmpCache->init();
 
         // create field solver
         this->myFieldSolver = new fieldSolver::FieldSolver(*cellDescription);
@@ -353,13 +451,6 @@ public:
         /* add CUDA streams to the StreamController for concurrent execution */
         Environment<>::get().StreamController().addStreams(2);
 
-#if 0
-        // create factory for the random number generator
-        this->rngFactory = new RNGFactory(Environment<simDim>::get().SubGrid().getLocalDomain().size);
-        // init factory
-        PMacc::GridController<simDim>& gridCon = PMacc::Environment<simDim>::get().GridController();
-        this->rngFactory->init(gridCon.getScalarPosition());
-
         // Initialize synchrotron functions, if there are synchrotron photon species
         typedef typename PMacc::particles::traits::FilterByFlag<VectorAllSpecies,
                                                                 synchrotronPhotons<> >::type AllSynchrotronPhotonsSpecies;
@@ -367,7 +458,6 @@ public:
         {
             this->synchrotronFunctions.init();
         }
-#endif
     }
 
     virtual uint32_t fillSimulation()
@@ -446,6 +536,8 @@ public:
     {
 #if (PMACC_CUDA_ENABLED == 1)
         mallocMC::finalizeHeap();
+#else
+        HostFrameHeap::getInstance().finalize();
 #endif
     }
 
@@ -458,7 +550,6 @@ public:
     {
         namespace nvfct = PMacc::nvidia::functors;
 
-#if 0
         /* Initialize ionization routine for each species with the flag `ionizer<>` */
         typedef typename PMacc::particles::traits::FilterByFlag
         <
@@ -466,7 +557,10 @@ public:
             ionizer<>
         >::type VectorSpeciesWithIonizer;
         ForEach<VectorSpeciesWithIonizer, particles::CallIonization<bmpl::_1>, MakeIdentifier<bmpl::_1> > particleIonization;
-        particleIonization(forward(particleStorage), cellDescription, currentStep);
+        {
+            simulationControl::ProfilePhase phase("ionization");
+            particleIonization(forward(particleStorage), cellDescription, currentStep);
+        }
 
         /* call the synchrotron radiation module for each radiating species (normally electrons) */
         typedef typename PMacc::particles::traits::FilterByFlag<VectorAllSpecies,
@@ -475,16 +569,42 @@ public:
         ForEach<AllSynchrotronPhotonsSpecies,
                 particles::CallSynchrotronPhotons<bmpl::_1>,
                 MakeIdentifier<bmpl::_1> > synchrotronRadiation;
-        synchrotronRadiation(forward(particleStorage), cellDescription, currentStep, this->synchrotronFunctions);
-#endif
+        {
+            simulationControl::ProfilePhase phase("synchrotronPhotons");
+            synchrotronRadiation(forward(particleStorage), cellDescription, currentStep, this->synchrotronFunctions);
+        }
+
+        /* bound the number of macro particles of each species with the flag `particleMerger<>` */
+        typedef typename PMacc::particles::traits::FilterByFlag
+        <
+            VectorAllSpecies,
+            particleMerger<>
+        >::type VectorSpeciesWithMerger;
+        ForEach<VectorSpeciesWithMerger, particles::CallParticleMerger<bmpl::_1>, MakeIdentifier<bmpl::_1> > mergeParticles;
+        {
+            simulationControl::ProfilePhase phase("merging");
+            mergeParticles(forward(particleStorage), cellDescription, currentStep);
+        }
 
         EventTask initEvent = __getTransactionEvent();
         EventTask updateEvent;
         EventTask commEvent;
 
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_PUSH_CURRENT == 1)
+        /* the current is deposited during the push */
+        {
+            simulationControl::ProfilePhase phase("current");
+            FieldJ::ValueType zeroJ( FieldJ::ValueType::create(0.) );
+            fieldJ->assign( zeroJ );
+        }
+#endif
+
         /* push all species */
         particles::PushAllSpecies pushAllSpecies;
-        pushAllSpecies(particleStorage, currentStep, initEvent, updateEvent, commEvent);
+        {
+            simulationControl::ProfilePhase phase("push");
+            pushAllSpecies(particleStorage, cellDescription, currentStep, initEvent, updateEvent, commEvent);
+        }
 
         __setTransactionEvent(updateEvent);
 
@@ -494,57 +614,71 @@ public:
         (*pushBGField)(fieldB, nvfct::Sub(), FieldBackgroundB(fieldB->getUnit()),
                        currentStep, FieldBackgroundB::InfluenceParticlePusher);
 
-        this->myFieldSolver->update_beforeCurrent(currentStep);
+        {
+            simulationControl::ProfilePhase phase("fieldSolverBeforeCurrent");
+            this->myFieldSolver->update_beforeCurrent(currentStep);
+        }
 
-#if (ENABLE_CURRENT == 1)
-        FieldJ::ValueType zeroJ( FieldJ::ValueType::create(0.) );
-        fieldJ->assign( zeroJ );
+        {
+            simulationControl::ProfilePhase phase("current");
+#if (ENABLE_CURRENT == 1) && (ENABLE_FUSED_PUSH_CURRENT != 1)
+            FieldJ::ValueType zeroJ( FieldJ::ValueType::create(0.) );
+            fieldJ->assign( zeroJ );
 #endif
 
-        __setTransactionEvent(commEvent);
-        (*currentBGField)(fieldJ, nvfct::Add(), FieldBackgroundJ(fieldJ->getUnit()),
-                          currentStep, FieldBackgroundJ::activated);
+            __setTransactionEvent(commEvent);
+            (*currentBGField)(fieldJ, nvfct::Add(), FieldBackgroundJ(fieldJ->getUnit()),
+                              currentStep, FieldBackgroundJ::activated);
 #if (ENABLE_CURRENT == 1)
-        typedef typename PMacc::particles::traits::FilterByFlag
-        <
-            VectorAllSpecies,
-            current<>
-        >::type VectorSpeciesWithCurrentSolver;
-        ForEach<VectorSpeciesWithCurrentSolver, ComputeCurrent<bmpl::_1,bmpl::int_<CORE + BORDER> >, MakeIdentifier<bmpl::_1> > computeCurrent;
-        computeCurrent(forward(fieldJ),forward(particleStorage), currentStep);
+            typedef typename PMacc::particles::traits::FilterByFlag
+            <
+                VectorAllSpecies,
+                current<>
+            >::type VectorSpeciesWithCurrentSolver;
+#if (ENABLE_FUSED_PUSH_CURRENT != 1)
+            ForEach<VectorSpeciesWithCurrentSolver, ComputeCurrent<bmpl::_1,bmpl::int_<CORE + BORDER> >, MakeIdentifier<bmpl::_1> > computeCurrent;
+            computeCurrent(forward(fieldJ),forward(particleStorage), currentStep);
+#else
+            /* sub-cycled species are not pushed each step */
+            ForEach<VectorSpeciesWithCurrentSolver, ComputeSubCycledCurrent<bmpl::_1,bmpl::int_<CORE + BORDER> >, MakeIdentifier<bmpl::_1> > computeCurrent;
+            computeCurrent(forward(fieldJ),forward(particleStorage), currentStep);
+#endif
 #endif
 
 #if  (ENABLE_CURRENT == 1)
-        if(bmpl::size<VectorSpeciesWithCurrentSolver>::type::value > 0)
-        {
-            EventTask eRecvCurrent = fieldJ->asyncCommunication(__getTransactionEvent());
+            if(bmpl::size<VectorSpeciesWithCurrentSolver>::type::value > 0)
+            {
+                simulationControl::ProfilePhase phase("interpolation");
+                EventTask eRecvCurrent = fieldJ->asyncCommunication(__getTransactionEvent());
 
-            const DataSpace<simDim> currentRecvLower( GetMargin<fieldSolver::CurrentInterpolation>::LowerMargin( ).toRT( ) );
-            const DataSpace<simDim> currentRecvUpper( GetMargin<fieldSolver::CurrentInterpolation>::UpperMargin( ).toRT( ) );
+                const DataSpace<simDim> currentRecvLower( GetMargin<fieldSolver::CurrentInterpolation>::LowerMargin( ).toRT( ) );
+                const DataSpace<simDim> currentRecvUpper( GetMargin<fieldSolver::CurrentInterpolation>::UpperMargin( ).toRT( ) );
 
-            /* without interpolation, we do not need to access the FieldJ GUARD
-             * and can therefor overlap communication of GUARD->(ADD)BORDER & computation of CORE */
-            if( currentRecvLower == DataSpace<simDim>::create(0) &&
-                currentRecvUpper == DataSpace<simDim>::create(0) )
-            {
-                fieldJ->addCurrentToEMF<CORE >(*myCurrentInterpolation);
-                __setTransactionEvent(eRecvCurrent);
-                fieldJ->addCurrentToEMF<BORDER >(*myCurrentInterpolation);
-            } else
-            {
-                /* in case we perform a current interpolation/filter, we need
-                 * to access the BORDER area from the CORE (and the GUARD area
-                 * from the BORDER)
-                 * `fieldJ->asyncCommunication` first adds the neighbors' values
-                 * to BORDER (send) and then updates the GUARD (receive)
-                 * \todo split the last `receive` part in a separate method to
-                 *       allow already a computation of CORE */
-                __setTransactionEvent(eRecvCurrent);
-                fieldJ->addCurrentToEMF<CORE + BORDER>(*myCurrentInterpolation);
+                /* without interpolation, we do not need to access the FieldJ GUARD
+                 * and can therefor overlap communication of GUARD->(ADD)BORDER & computation of CORE */
+                if( currentRecvLower == DataSpace<simDim>::create(0) &&
+                    currentRecvUpper == DataSpace<simDim>::create(0) )
+                {
+                    fieldJ->addCurrentToEMF<CORE >(*myCurrentInterpolation);
+                    __setTransactionEvent(eRecvCurrent);
+                    fieldJ->addCurrentToEMF<BORDER >(*myCurrentInterpolation);
+                } else
+                {
+                    /* in case we perform a current interpolation/filter, we need
+                     * to access the BORDER area from the CORE (and the GUARD area
+                     * from the BORDER)
+                     * `fieldJ->asyncCommunication` first adds the neighbors' values
+                     * to BORDER (send) and then updates the GUARD (receive)
+                     * \todo split the last `receive` part in a separate method to
+                     *       allow already a computation of CORE */
+                    __setTransactionEvent(eRecvCurrent);
+                    fieldJ->addCurrentToEMF<CORE + BORDER>(*myCurrentInterpolation);
+                }
             }
-        }
 #endif
+        }
 
+        simulationControl::ProfilePhase phase("fieldSolverAfterCurrent");
         this->myFieldSolver->update_afterCurrent(currentStep);
     }
 
@@ -574,6 +708,7 @@ public:
 
         fieldB->reset(currentStep);
         fieldE->reset(currentStep);
+        fieldTmpCache->invalidate();
 
         ForEach<VectorAllSpecies, particles::CallReset<bmpl::_1>, MakeIdentifier<bmpl::_1> > callReset;
         callReset(forward(particleStorage), currentStep);
@@ -582,6 +717,12 @@ public:
 
     void slide(uint32_t currentStep)
     {
+        if (MovingWindow::getInstance().isIncrementalSlides())
+        {
+            slideIncremental(currentStep);
+            return;
+        }
+
         GridController<simDim>& gc = Environment<simDim>::get().GridController();
 
         if (gc.slide())
@@ -633,9 +774,8 @@ protected:
     FieldE *fieldE;
     FieldJ *fieldJ;
     FieldTmp *fieldTmp;
-#if (PMACC_CUDA_ENABLED == 1)
+    FieldTmpCache *fieldTmpCache;
     MallocMCBuffer *mallocMCBuffer;
-#endif
 
     // field solver
     fieldSolver::FieldSolver* myFieldSolver;
@@ -651,14 +791,8 @@ protected:
 
     LaserPhysics *laser;
 
-#if 0
     // Synchrotron functions (used in synchrotronPhotons module)
     particles::synchrotronPhotons::SynchrotronFunctions synchrotronFunctions;
-
-    // factory for the random number generator
-    typedef PMacc::random::RNGProvider<simDim, PMacc::random::methods::XorMin> RNGFactory;
-    RNGFactory* rngFactory;
-#endif
     // output classes
 
     IInitPlugin* initialiserController;
@@ -677,6 +811,153 @@ protected:
     std::vector<std::string> gridDistribution;
 
     bool slidingWindow;
+    uint32_t movingWindowDirection;
+    bool incrementalSlides;
+
+    /** memory budget of the derived field cache in MiB */
+    uint32_t fieldTmpCacheMemory;
+
+    /** measures the load of all devices, NULL if disabled */
+    GridBalancer* gridBalancer;
+    uint32_t balancePeriod;
+    float_64 balanceCellCost;
+
+private:
+
+    /** move fields and particles by one supercell against the move direction
+     *
+     * Only the supercells exposed at the end of the global domain are
+     * initialized with the particle init pipeline.
+     */
+    void slideIncremental(uint32_t currentStep)
+    {
+        log<picLog::SIMULATION_STATE > ("slide by one supercell in step %1%") % currentStep;
+
+        MovingWindow& movingWindow = MovingWindow::getInstance();
+
+        /* the guards must hold the values of the neighbors before and after the slide */
+        __setTransactionEvent(fieldE->asyncCommunication(__getTransactionEvent()) +
+                              fieldB->asyncCommunication(__getTransactionEvent()));
+        FieldManipulator::slideField(*cellDescription, fieldE->getDeviceDataBox());
+        FieldManipulator::slideField(*cellDescription, fieldB->getDeviceDataBox());
+        __setTransactionEvent(fieldE->asyncCommunication(__getTransactionEvent()) +
+                              fieldB->asyncCommunication(__getTransactionEvent()));
+        fieldTmpCache->invalidate();
+
+        EventTask commEvent;
+        ForEach<VectorAllSpecies, particles::SlideSpecies<bmpl::_1>, MakeIdentifier<bmpl::_1> > slideSpecies;
+        slideSpecies(forward(particleStorage), movingWindow.getMoveDirection(), forward(commEvent));
+        __setTransactionEvent(commEvent);
+
+        if (movingWindow.isLastGPUInMoveDirection())
+        {
+            movingWindow.setInitExposedSuperCells(true);
+            ForEach<particles::InitPipeline, particles::CallFunctor<bmpl::_1> > initSpecies;
+            initSpecies(forward(particleStorage), currentStep);
+            movingWindow.setInitExposedSuperCells(false);
+        }
+    }
+
+    static std::string getGridDistFilename(const std::string& directory, uint32_t step)
+    {
+        std::stringstream filename;
+        filename << directory << "/gridDist_" << step << ".txt";
+        return filename.str();
+    }
+
+    /** Use the balanced distribution stored with the restart checkpoint
+     *
+     * An explicit --gridDist has precedence. The stored distribution is
+     * checked against the grid size and the number of devices, a checkpoint
+     * without a stored distribution is restarted with the default one.
+     * A moving window with rotating devices requires the same size of all
+     * devices along the move direction.
+     *
+     * @param globalGridSize number of cells of the global domain
+     * @param gpus number of devices per dimension
+     */
+    void loadBalancedGridDist(const DataSpace<simDim>& globalGridSize, const DataSpace<simDim>& gpus)
+    {
+#if (ENABLE_ADIOS == 1)
+        throw std::runtime_error("--balance.period can not be used with --restart: the ADIOS restart "
+                                 "requires the domain decomposition of the checkpoint");
+#endif
+        const bool isMaster = Environment<simDim>::get().GridController().getGlobalRank() == 0;
+
+        if (!gridDistribution.empty())
+        {
+            if (isMaster)
+                log<picLog::DOMAINS > ("restart: --gridDist is given, a stored balanced distribution is ignored");
+            return;
+        }
+
+        /* same lookup of the restart step as in fillSimulation() */
+        int32_t step = this->restartStep;
+        if (step < 0)
+        {
+            std::vector<uint32_t> checkpoints = readCheckpointMasterFile();
+            if (checkpoints.empty())
+                return;
+            step = checkpoints.back();
+        }
+
+        const std::string filename = getGridDistFilename(this->restartDirectory, step);
+        std::ifstream file(filename.c_str());
+        if (!file)
+        {
+            if (isMaster)
+                log<picLog::DOMAINS > ("restart: no balanced distribution stored in %1%, using the default one") %
+                    filename;
+            return;
+        }
+
+        std::vector<std::string> balancedGridDist;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (!line.empty())
+                balancedGridDist.push_back(line);
+        }
+
+        if (balancedGridDist.size() != simDim)
+            throw std::runtime_error("Restart failed: " + filename + " does not contain one distribution per dimension");
+
+        for (uint32_t dim = 0; dim < simDim; ++dim)
+        {
+            ParserGridDistribution parserGD(balancedGridDist[dim]);
+            if (parserGD.getNumberOfDevices() != (uint32_t) gpus[dim] ||
+                parserGD.getTotalSize() != (uint32_t) globalGridSize[dim])
+            {
+                throw std::runtime_error("Restart failed: the distribution in " + filename +
+                                         " does not match the grid size and number of devices");
+            }
+        }
+
+        if (slidingWindow && !incrementalSlides)
+        {
+            ParserGridDistribution parserGD(balancedGridDist[movingWindowDirection]);
+            for (int i = 1; i < gpus[movingWindowDirection]; ++i)
+            {
+                if (parserGD.getLocalSize(i) != parserGD.getLocalSize(0))
+                    throw std::runtime_error("Restart failed: the distribution in " + filename +
+                                             " is not uniform along the direction of the moving window");
+            }
+        }
+
+        gridDistribution = balancedGridDist;
+        if (isMaster)
+            log<picLog::DOMAINS > ("restart: using the balanced distribution --gridDist %1% from %2%") %
+                toGridDistArguments(gridDistribution) % filename;
+    }
+
+    /** Distribution as command line arguments */
+    static std::string toGridDistArguments(const std::vector<std::string>& gridDist)
+    {
+        std::string result;
+        for (size_t d = 0; d < gridDist.size(); ++d)
+            result += (d == 0 ? "\"" : " \"") + gridDist[d] + "\"";
+        return result;
+    }
 };
 } /* namespace picongpu */
 
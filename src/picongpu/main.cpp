@@ -100,7 +100,12 @@ using namespace picongpu;
  */
 int main(int argc, char **argv)
 {
-    MPI_CHECK(MPI_Init(&argc, &argv));
+    /* asynchronous checkpoints and concurrent plugins call MPI from background
+     * threads, MPI is initialized before the arguments are parsed: always ask
+     * for full thread support, the threads check the provided level with
+     * MPI_Query_thread and fall back to synchronous work if it is lower */
+    int threadLevel;
+    MPI_CHECK(MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &threadLevel));
 
     picongpu::simulation_starter::SimStarter sim;
     ArgsParser::ArgsErrorCode parserCode = sim.parseConfigs(argc, argv);